@@ -1,3 +1,5 @@
 #pragma once
 
+#include "dense_model.hpp"
+#include "mapped_model.hpp"
 #include "qml_model_adapter.hpp"
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <memory>
+
+#include <QMLModel/qml-model.hpp>
+
+#include "idense_model.hpp"
+#include "vocabulary.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief A self-contained in-memory model, stored in contiguous tables.
+ *
+ * A DenseModel is converted once from another model (any IModel, or a QMLModel), for a
+ * given vocabulary, and keeps no reference to it. The interpretations of the terms are
+ * kept in one `[term][world]` array, and the extension of each predicate whose tuples
+ * have a single arity and lie within the domain in a packed world-major bitset (see
+ * `DenseExtension`), unless the bitset would be much larger than the extension itself.
+ *
+ * The model implements IDenseModel, so the evaluator reads these tables directly. Every
+ * lookup returns what the source model returned for the same symbol and world, errors
+ * included. Symbols outside the vocabulary, and worlds out of range, fail with an error
+ * of the DenseModel. Queries are thread-safe.
+ */
+class DenseModel : public IDenseModel {
+public:
+    DenseModel(const IModel& model, const Vocabulary& vocabulary);
+    DenseModel(const QMLModel::QMLModel& model, const Vocabulary& vocabulary);
+
+    DenseModel(const DenseModel&) = delete;
+    DenseModel& operator=(const DenseModel&) = delete;
+    DenseModel(DenseModel&&) noexcept;
+    DenseModel& operator=(DenseModel&&) noexcept;
+    ~DenseModel() override;
+
+    int worldCardinality() const override;
+    int domainCardinality() const override;
+    std::expected<int, std::string> termInterpretation(std::string_view term, int world) const override;
+    std::expected<const std::set<std::vector<int>>*, std::string> predicateInterpretation(std::string_view predicate, int world) const override;
+
+    std::expected<int, std::string> termInterpretationById(SymbolId term, int world) const override;
+    std::expected<const std::set<std::vector<int>>*, std::string> predicateInterpretationById(SymbolId predicate, int world) const override;
+
+    const int* termTable(SymbolId term) const override;
+    const DenseExtension* denseExtension(SymbolId predicate) const override;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "idense_model.hpp"
+#include "vocabulary.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief The version of the model file format written by `writeModelFile()`.
+ */
+constexpr std::uint32_t MODEL_FILE_VERSION = 1;
+
+std::expected<void, std::string> writeModelFile(const IModel& model, const Vocabulary& vocabulary, const std::filesystem::path& path);
+
+/**
+ * @brief A model served from a memory-mapped model file.
+ *
+ * Model files are written by `writeModelFile()`. Opening one maps it read-only, checks its
+ * header, and resolves the symbol ids of its vocabulary; nothing else is read until it is
+ * queried. Term denotations and dense predicate extensions (see `IDenseModel`) are served
+ * straight from the mapped pages, so processes mapping the same file share a single copy
+ * of it through the page cache.
+ *
+ * The IModel lookups of predicates return `std::set`s, which cannot live in the file: the
+ * extensions of a predicate are decoded into sets the first time they are looked up that
+ * way. The evaluator prefers the dense extensions, so this only happens for predicates
+ * that have none. Every lookup returns what the source model returned when the file was
+ * written, errors included. Queries are thread-safe.
+ */
+class MappedModel : public IDenseModel {
+public:
+    static std::expected<MappedModel, std::string> open(const std::filesystem::path& path);
+
+    MappedModel(const MappedModel&) = delete;
+    MappedModel& operator=(const MappedModel&) = delete;
+    MappedModel(MappedModel&&) noexcept;
+    MappedModel& operator=(MappedModel&&) noexcept;
+    ~MappedModel() override;
+
+    int worldCardinality() const override;
+    int domainCardinality() const override;
+    std::expected<int, std::string> termInterpretation(std::string_view term, int world) const override;
+    std::expected<const std::set<std::vector<int>>*, std::string> predicateInterpretation(std::string_view predicate, int world) const override;
+
+    std::expected<int, std::string> termInterpretationById(SymbolId term, int world) const override;
+    std::expected<const std::set<std::vector<int>>*, std::string> predicateInterpretationById(SymbolId predicate, int world) const override;
+
+    const int* termTable(SymbolId term) const override;
+    const DenseExtension* denseExtension(SymbolId predicate) const override;
+
+private:
+    class Impl;
+    explicit MappedModel(std::unique_ptr<Impl> impl);
+    std::unique_ptr<Impl> pImpl;
+};
+
+}
@@ -1,10 +1,10 @@
-#pragma once 
+#pragma once
 
 #include <memory>
 
 #include <QMLModel/qml-model.hpp>
 
-#include "imodel.hpp"
+#include "iindexed_model.hpp"
 
 namespace iif_sadaf::talk::GSV {
 
@@ -14,36 +14,33 @@ namespace iif_sadaf::talk::GSV {
  * This class adapts a QMLModel to conform to the IModel interface, providing
  * implementations for model-related operations such as retrieving world and
  * domain cardinalities, and the interpretation of terms and predicates.
+ *
+ * The adapter also implements IIndexedModel. The first time a term or predicate id is
+ * queried, its interpretation is resolved through the QMLModel at every world, and
+ * stored; later queries for that id are answered from the stored interpretations,
+ * without locking. Queries are thread-safe.
  */
-class QMLModelAdapter : public IModel {
+class QMLModelAdapter : public IIndexedModel {
 public:
     explicit QMLModelAdapter(const QMLModel::QMLModel& qmlModel);
     explicit QMLModelAdapter(std::unique_ptr<QMLModel::QMLModel> qmlModel);
 
     QMLModelAdapter(const QMLModelAdapter&) = delete;
     QMLModelAdapter& operator=(const QMLModelAdapter&) = delete;
-    QMLModelAdapter(QMLModelAdapter&&) noexcept = default;
-    QMLModelAdapter& operator=(QMLModelAdapter&&) noexcept = default;
-    ~QMLModelAdapter() override = default;
+    QMLModelAdapter(QMLModelAdapter&&) noexcept;
+    QMLModelAdapter& operator=(QMLModelAdapter&&) noexcept;
+    ~QMLModelAdapter() override;
 
     int worldCardinality() const override;
     int domainCardinality() const override;
     std::expected<int, std::string> termInterpretation(std::string_view term, int world) const override;
     std::expected<const std::set<std::vector<int>>*, std::string> predicateInterpretation(std::string_view predicate, int world) const override;
 
+    std::expected<int, std::string> termInterpretationById(SymbolId term, int world) const override;
+    std::expected<const std::set<std::vector<int>>*, std::string> predicateInterpretationById(SymbolId predicate, int world) const override;
+
 private:
-    class Impl {
-    public:
-        explicit Impl(const QMLModel::QMLModel& model) : ownedModel(nullptr), modelRef(&model) {}
-        explicit Impl(std::unique_ptr<QMLModel::QMLModel> model)
-            : ownedModel(std::move(model)), modelRef(ownedModel.get()) {
-        }
-        const QMLModel::QMLModel& getModel() const { return *modelRef; }
-
-    private:
-        std::unique_ptr<QMLModel::QMLModel> ownedModel;
-        const QMLModel::QMLModel* modelRef;
-    };
+    class Impl;
     std::unique_ptr<Impl> pImpl;
 };
 
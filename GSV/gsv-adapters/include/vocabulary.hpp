@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief The constants and predicates whose interpretations a model is converted with.
+ *
+ * The `IModel` interface cannot enumerate the symbols a model interprets, so conversions
+ * of a model (to a `DenseModel`, or to a model file) take them explicitly.
+ */
+struct Vocabulary {
+    std::vector<std::string> terms;
+    std::vector<std::string> predicates;
+};
+
+}
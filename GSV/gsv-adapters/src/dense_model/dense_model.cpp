@@ -0,0 +1,304 @@
+#include "dense_model.hpp"
+
+#include <algorithm>
+#include <format>
+#include <limits>
+#include <optional>
+
+#include "qml_model_adapter.hpp"
+#include "symbol_table.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+namespace {
+
+/**
+ * @brief Bitsets of up to this many bits are always built.
+ */
+constexpr std::size_t MIN_BITSET_BITS = std::size_t{ 1 } << 20;
+
+/**
+ * @brief Larger bitsets are only built if they take at most this many bits per tuple of the extension.
+ */
+constexpr std::size_t MAX_BITSET_BITS_PER_TUPLE = 256;
+
+/**
+ * @brief `base` raised to `exponent`, or nullopt if it does not fit in a `std::size_t`.
+ */
+std::optional<std::size_t> power(std::size_t base, std::size_t exponent)
+{
+    std::size_t result = 1;
+    for (std::size_t i = 0; i < exponent; ++i) {
+        if (base != 0 && result > std::numeric_limits<std::size_t>::max() / base) {
+            return std::nullopt;
+        }
+        result *= base;
+    }
+    return result;
+}
+
+} // ANONYMOUS NAMESPACE
+
+class DenseModel::Impl {
+public:
+    using TermRow = std::vector<std::expected<int, std::string>>;
+    using PredicateRow = std::vector<std::expected<std::set<std::vector<int>>, std::string>>;
+
+    struct PredicateEntry {
+        PredicateRow interpretations;
+        std::vector<std::uint64_t> bits;
+        std::optional<DenseExtension> extension;
+    };
+
+    Impl(const IModel& model, const Vocabulary& vocabulary)
+        : worlds(model.worldCardinality()), domain(model.domainCardinality())
+    {
+        for (const std::string& term : vocabulary.terms) {
+            addTerm(model, term);
+        }
+        for (const std::string& predicate : vocabulary.predicates) {
+            addPredicate(model, predicate);
+        }
+    }
+
+    /**
+     * @brief The slot of a symbol in `slots`, or nullopt if the symbol is not in the vocabulary.
+     */
+    static std::optional<std::size_t> slot(const std::vector<std::size_t>& slots, SymbolId id)
+    {
+        if (id < 0 || static_cast<std::size_t>(id) >= slots.size() || slots[static_cast<std::size_t>(id)] == NO_SLOT) {
+            return std::nullopt;
+        }
+        return slots[static_cast<std::size_t>(id)];
+    }
+
+    static constexpr std::size_t NO_SLOT = std::numeric_limits<std::size_t>::max();
+
+    int worlds;
+    int domain;
+
+    std::vector<std::size_t> termSlots;
+    std::vector<TermRow> terms;
+    std::vector<int> termTable;
+    std::vector<bool> completeTerms;
+
+    std::vector<std::size_t> predicateSlots;
+    std::vector<PredicateEntry> predicates;
+
+private:
+    static std::size_t& slotFor(std::vector<std::size_t>& slots, SymbolId id)
+    {
+        if (static_cast<std::size_t>(id) >= slots.size()) {
+            slots.resize(static_cast<std::size_t>(id) + 1, NO_SLOT);
+        }
+        return slots[static_cast<std::size_t>(id)];
+    }
+
+    void addTerm(const IModel& model, const std::string& term)
+    {
+        std::size_t& term_slot = slotFor(termSlots, SymbolTable::global().intern(term));
+        if (term_slot != NO_SLOT) {
+            return;
+        }
+        term_slot = terms.size();
+
+        TermRow& row = terms.emplace_back();
+        bool complete = true;
+        for (int world = 0; world < worlds; ++world) {
+            row.push_back(model.termInterpretation(term, world));
+            complete = complete && row.back().has_value();
+            termTable.push_back(row.back().value_or(0));
+        }
+        completeTerms.push_back(complete);
+    }
+
+    void addPredicate(const IModel& model, const std::string& predicate)
+    {
+        std::size_t& predicate_slot = slotFor(predicateSlots, SymbolTable::global().intern(predicate));
+        if (predicate_slot != NO_SLOT) {
+            return;
+        }
+        predicate_slot = predicates.size();
+
+        PredicateEntry& entry = predicates.emplace_back();
+        for (int world = 0; world < worlds; ++world) {
+            const auto predint = model.predicateInterpretation(predicate, world);
+            if (predint.has_value()) {
+                entry.interpretations.emplace_back(*predint.value());
+            }
+            else {
+                entry.interpretations.emplace_back(std::unexpected(predint.error()));
+            }
+        }
+        buildBitset(entry);
+    }
+
+    /**
+     * @brief Packs the extension of a predicate into a bitset, if it has one arity, lies within the domain, and is not too sparse.
+     */
+    void buildBitset(PredicateEntry& entry) const
+    {
+        std::optional<std::size_t> arity;
+        std::size_t tuple_count = 0;
+        for (const auto& interpretation : entry.interpretations) {
+            if (!interpretation.has_value()) {
+                return;
+            }
+            for (const std::vector<int>& tuple : interpretation.value()) {
+                const bool in_domain = std::ranges::all_of(tuple, [&](int element) { return element >= 0 && element < domain; });
+                if (!in_domain || (arity.has_value() && arity.value() != tuple.size())) {
+                    return;
+                }
+                arity = tuple.size();
+                ++tuple_count;
+            }
+        }
+
+        const std::optional<std::size_t> world_stride = power(static_cast<std::size_t>(std::max(domain, 0)), arity.value_or(0));
+        if (!arity.has_value() || !world_stride.has_value() || world_stride.value() > std::numeric_limits<std::size_t>::max() / std::max(worlds, 1)) {
+            return;
+        }
+        const std::size_t bit_count = world_stride.value() * static_cast<std::size_t>(std::max(worlds, 1));
+        if (bit_count > std::max(MIN_BITSET_BITS, MAX_BITSET_BITS_PER_TUPLE * tuple_count)) {
+            return;
+        }
+
+        entry.bits.assign((bit_count + 63) / 64, 0);
+        for (int world = 0; world < worlds; ++world) {
+            for (const std::vector<int>& tuple : entry.interpretations[static_cast<std::size_t>(world)].value()) {
+                std::size_t index = 0;
+                for (const int element : tuple) {
+                    index = index * static_cast<std::size_t>(domain) + static_cast<std::size_t>(element);
+                }
+                const std::size_t bit = static_cast<std::size_t>(world) * world_stride.value() + index;
+                entry.bits[bit / 64] |= std::uint64_t{ 1 } << (bit % 64);
+            }
+        }
+        entry.extension = DenseExtension{ .arity = arity.value(), .domain = domain, .worlds = worlds, .worldStride = world_stride.value(), .bits = entry.bits.data() };
+    }
+};
+
+/**
+ * @brief Converts a model, for the given vocabulary.
+ *
+ * The source model is queried once for every symbol of the vocabulary at every world,
+ * and is not referenced afterwards.
+ *
+ * @param model The model to convert.
+ * @param vocabulary The terms and predicates to convert the interpretations of.
+ */
+DenseModel::DenseModel(const IModel& model, const Vocabulary& vocabulary)
+    : pImpl(std::make_unique<Impl>(model, vocabulary)) {}
+
+/**
+ * @brief Converts a QMLModel, for the given vocabulary.
+ *
+ * @param model The QMLModel to convert.
+ * @param vocabulary The terms and predicates to convert the interpretations of.
+ */
+DenseModel::DenseModel(const QMLModel::QMLModel& model, const Vocabulary& vocabulary)
+    : DenseModel(QMLModelAdapter(model), vocabulary) {}
+
+DenseModel::DenseModel(DenseModel&&) noexcept = default;
+DenseModel& DenseModel::operator=(DenseModel&&) noexcept = default;
+DenseModel::~DenseModel() = default;
+
+/**
+ * @brief Retrieves the cardinality of the model's set of worlds.
+ */
+int DenseModel::worldCardinality() const
+{
+    return pImpl->worlds;
+}
+
+/**
+ * @brief Retrieves the cardinality of the model's domain.
+ */
+int DenseModel::domainCardinality() const
+{
+    return pImpl->domain;
+}
+
+/**
+ * @brief Retrieves the interpretation of a term at a world.
+ */
+std::expected<int, std::string> DenseModel::termInterpretation(std::string_view term, int world) const
+{
+    const std::optional<SymbolId> id = SymbolTable::global().find(term);
+    if (!id.has_value()) {
+        return std::unexpected(std::format("Term {} is not in the vocabulary of the model", term));
+    }
+    return termInterpretationById(id.value(), world);
+}
+
+/**
+ * @brief Retrieves the interpretation of a predicate at a world.
+ */
+std::expected<const std::set<std::vector<int>>*, std::string> DenseModel::predicateInterpretation(std::string_view predicate, int world) const
+{
+    const std::optional<SymbolId> id = SymbolTable::global().find(predicate);
+    if (!id.has_value()) {
+        return std::unexpected(std::format("Predicate {} is not in the vocabulary of the model", predicate));
+    }
+    return predicateInterpretationById(id.value(), world);
+}
+
+/**
+ * @brief Retrieves the interpretation of a term at a world, by id.
+ */
+std::expected<int, std::string> DenseModel::termInterpretationById(SymbolId term, int world) const
+{
+    const std::optional<std::size_t> slot = Impl::slot(pImpl->termSlots, term);
+    if (!slot.has_value()) {
+        return std::unexpected(std::format("Term {} is not in the vocabulary of the model", SymbolTable::global().name(term)));
+    }
+    if (world < 0 || world >= pImpl->worlds) {
+        return std::unexpected(std::format("World {} is out of range", world));
+    }
+    return pImpl->terms[slot.value()][static_cast<std::size_t>(world)];
+}
+
+/**
+ * @brief Retrieves the interpretation of a predicate at a world, by id.
+ */
+std::expected<const std::set<std::vector<int>>*, std::string> DenseModel::predicateInterpretationById(SymbolId predicate, int world) const
+{
+    const std::optional<std::size_t> slot = Impl::slot(pImpl->predicateSlots, predicate);
+    if (!slot.has_value()) {
+        return std::unexpected(std::format("Predicate {} is not in the vocabulary of the model", SymbolTable::global().name(predicate)));
+    }
+    if (world < 0 || world >= pImpl->worlds) {
+        return std::unexpected(std::format("World {} is out of range", world));
+    }
+    const auto& interpretation = pImpl->predicates[slot.value()].interpretations[static_cast<std::size_t>(world)];
+    if (!interpretation.has_value()) {
+        return std::unexpected(interpretation.error());
+    }
+    return &interpretation.value();
+}
+
+/**
+ * @brief The denotations of a term indexed by world, or nullptr if it is not interpreted at every world.
+ */
+const int* DenseModel::termTable(SymbolId term) const
+{
+    const std::optional<std::size_t> slot = Impl::slot(pImpl->termSlots, term);
+    if (!slot.has_value() || !pImpl->completeTerms[slot.value()]) {
+        return nullptr;
+    }
+    return pImpl->termTable.data() + slot.value() * static_cast<std::size_t>(pImpl->worlds);
+}
+
+/**
+ * @brief The packed extension of a predicate, or nullptr if it is not stored as a bitset.
+ */
+const DenseExtension* DenseModel::denseExtension(SymbolId predicate) const
+{
+    const std::optional<std::size_t> slot = Impl::slot(pImpl->predicateSlots, predicate);
+    if (!slot.has_value() || !pImpl->predicates[slot.value()].extension.has_value()) {
+        return nullptr;
+    }
+    return &pImpl->predicates[slot.value()].extension.value();
+}
+
+}
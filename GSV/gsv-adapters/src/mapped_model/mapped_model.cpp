@@ -0,0 +1,676 @@
+#include "mapped_model.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <type_traits>
+#include <vector>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "dense_model.hpp"
+#include "symbol_table.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+namespace {
+
+/*
+ * MODEL FILE FORMAT
+ *
+ * A model file is a `FileHeader`, followed by sections referenced by absolute byte offsets,
+ * each aligned to 8 bytes. All integers are in the byte order of the machine that wrote the
+ * file, recorded in the header; files are rejected on machines with another byte order.
+ *
+ * - `termsOffset`: `TermRecord[termCount]`. The denotations of a term are an `int32_t[worlds]`
+ *   array. If the term fails at some world, `outcomes` is an `Outcome[worlds]` array, whose
+ *   failed entries hold the error message; otherwise it is zero.
+ * - `predicatesOffset`: `PredicateRecord[predicateCount]`. `outcomes` is an `Outcome[worlds]`
+ *   array, holding either the error message at the world, or the tuples of the extension,
+ *   each stored as its `uint32_t` length followed by its `int32_t` elements. If the
+ *   extensions were packed by `DenseModel`, `bits` is the offset of the bitset described by
+ *   `DenseExtension`; otherwise it is zero.
+ */
+
+constexpr char MAGIC[8] = { 'G', 'S', 'V', 'M', 'O', 'D', 'E', 'L' };
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+struct Blob {
+    std::uint64_t offset;
+    std::uint64_t size;
+};
+
+struct Outcome {
+    Blob blob;
+    std::uint32_t failed;
+    std::uint32_t count;
+};
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::int32_t worlds;
+    std::int32_t domain;
+    std::uint32_t termCount;
+    std::uint32_t predicateCount;
+    std::uint64_t termsOffset;
+    std::uint64_t predicatesOffset;
+    std::uint64_t fileSize;
+};
+
+struct TermRecord {
+    Blob name;
+    std::uint64_t denotations;
+    std::uint64_t outcomes;
+};
+
+struct PredicateRecord {
+    Blob name;
+    std::uint64_t arity;
+    std::uint64_t worldStride;
+    std::uint64_t bits;
+    std::uint64_t outcomes;
+};
+
+static_assert(std::is_trivially_copyable_v<FileHeader> && std::is_trivially_copyable_v<TermRecord> && std::is_trivially_copyable_v<PredicateRecord>);
+static_assert(sizeof(FileHeader) % 8 == 0 && sizeof(TermRecord) % 8 == 0 && sizeof(PredicateRecord) % 8 == 0 && sizeof(Outcome) % 8 == 0);
+
+/**
+ * @brief The bytes of a model file under construction.
+ */
+class FileBuilder {
+public:
+    /**
+     * @brief Reserves zeroed, 8-byte aligned room for `size` bytes, and returns its offset.
+     */
+    std::uint64_t reserve(std::size_t size)
+    {
+        const std::size_t offset = (m_Bytes.size() + 7) / 8 * 8;
+        m_Bytes.resize(offset + size);
+        return offset;
+    }
+
+    std::uint64_t append(const void* data, std::size_t size)
+    {
+        const std::uint64_t offset = reserve(size);
+        if (size > 0) {
+            std::memcpy(m_Bytes.data() + offset, data, size);
+        }
+        return offset;
+    }
+
+    Blob appendString(std::string_view text)
+    {
+        return { append(text.data(), text.size()), text.size() };
+    }
+
+    template<typename T>
+    void write(std::uint64_t offset, const T& value)
+    {
+        std::memcpy(m_Bytes.data() + offset, &value, sizeof(T));
+    }
+
+    const std::vector<char>& bytes() const { return m_Bytes; }
+
+private:
+    std::vector<char> m_Bytes;
+};
+
+/**
+ * @brief `base` raised to `exponent`, or nullopt if it does not fit in a `std::uint64_t`.
+ */
+std::optional<std::uint64_t> power(std::uint64_t base, std::uint64_t exponent)
+{
+    // Exponents read from a file may be huge, but only overflow for bases above 1
+    if (base <= 1) {
+        return exponent == 0 ? 1 : base;
+    }
+    std::uint64_t result = 1;
+    for (std::uint64_t i = 0; i < exponent; ++i) {
+        if (result > std::numeric_limits<std::uint64_t>::max() / base) {
+            return std::nullopt;
+        }
+        result *= base;
+    }
+    return result;
+}
+
+/**
+ * @brief Whether objects of type `T` can be read at `offset` of a mapping, which starts at a page boundary.
+ */
+template<typename T>
+bool isAligned(std::uint64_t offset)
+{
+    return offset % alignof(T) == 0;
+}
+
+std::vector<std::string> unique(const std::vector<std::string>& names)
+{
+    std::vector<std::string> unique_names;
+    std::set<std::string_view> seen;
+    for (const std::string& name : names) {
+        if (seen.insert(name).second) {
+            unique_names.push_back(name);
+        }
+    }
+    return unique_names;
+}
+
+Outcome appendExtension(FileBuilder& builder, const std::set<std::vector<int>>& extension)
+{
+    std::vector<std::int32_t> payload;
+    for (const std::vector<int>& tuple : extension) {
+        payload.push_back(static_cast<std::int32_t>(tuple.size()));
+        payload.insert(payload.end(), tuple.begin(), tuple.end());
+    }
+    const std::size_t size = payload.size() * sizeof(std::int32_t);
+    return { .blob = { builder.append(payload.data(), size), size }, .failed = 0, .count = static_cast<std::uint32_t>(extension.size()) };
+}
+
+/**
+ * @brief A read-only mapping of a whole file.
+ */
+class FileMapping {
+public:
+    static std::expected<std::unique_ptr<FileMapping>, std::string> open(const std::filesystem::path& path)
+    {
+        auto mapping = std::unique_ptr<FileMapping>(new FileMapping());
+        const std::string failure = std::format("Cannot map model file {}", path.string());
+#if defined(_WIN32)
+        mapping->m_File = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        LARGE_INTEGER size;
+        if (mapping->m_File == INVALID_HANDLE_VALUE || !GetFileSizeEx(mapping->m_File, &size) || size.QuadPart == 0) {
+            return std::unexpected(failure);
+        }
+        mapping->m_Mapping = CreateFileMappingW(mapping->m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping->m_Mapping == nullptr) {
+            return std::unexpected(failure);
+        }
+        const void* data = MapViewOfFile(mapping->m_Mapping, FILE_MAP_READ, 0, 0, 0);
+        if (data == nullptr) {
+            return std::unexpected(failure);
+        }
+        mapping->m_Data = static_cast<const char*>(data);
+        mapping->m_Size = static_cast<std::size_t>(size.QuadPart);
+#else
+        const int descriptor = ::open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            return std::unexpected(failure);
+        }
+        struct stat status;
+        if (fstat(descriptor, &status) != 0 || status.st_size <= 0) {
+            ::close(descriptor);
+            return std::unexpected(failure);
+        }
+        void* data = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED, descriptor, 0);
+        ::close(descriptor);
+        if (data == MAP_FAILED) {
+            return std::unexpected(failure);
+        }
+        mapping->m_Data = static_cast<const char*>(data);
+        mapping->m_Size = static_cast<std::size_t>(status.st_size);
+#endif
+        return mapping;
+    }
+
+    FileMapping(const FileMapping&) = delete;
+    FileMapping& operator=(const FileMapping&) = delete;
+
+    ~FileMapping()
+    {
+#if defined(_WIN32)
+        if (m_Data != nullptr) {
+            UnmapViewOfFile(m_Data);
+        }
+        if (m_Mapping != nullptr) {
+            CloseHandle(m_Mapping);
+        }
+        if (m_File != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_File);
+        }
+#else
+        if (m_Data != nullptr) {
+            munmap(const_cast<char*>(m_Data), m_Size);
+        }
+#endif
+    }
+
+    const char* data() const { return m_Data; }
+    std::size_t size() const { return m_Size; }
+
+    /**
+     * @brief Whether `count` objects of `element_size` bytes fit in the file at `offset`.
+     */
+    bool contains(std::uint64_t offset, std::uint64_t count, std::size_t element_size) const
+    {
+        return offset <= m_Size && (element_size == 0 || count <= (m_Size - offset) / element_size);
+    }
+
+    template<typename T>
+    const T* at(std::uint64_t offset) const
+    {
+        return reinterpret_cast<const T*>(m_Data + offset);
+    }
+
+private:
+    FileMapping() = default;
+
+#if defined(_WIN32)
+    HANDLE m_File = INVALID_HANDLE_VALUE;
+    HANDLE m_Mapping = nullptr;
+#endif
+    const char* m_Data = nullptr;
+    std::size_t m_Size = 0;
+};
+
+} // ANONYMOUS NAMESPACE
+
+/**
+ * @brief Writes a model file, for the given vocabulary of a model.
+ *
+ * The interpretations of every symbol of the vocabulary at every world are written,
+ * errors included, together with the packed extensions that a `DenseModel` of the model
+ * would build. The file can be mapped with `MappedModel::open()`.
+ *
+ * @param model The model to write.
+ * @param vocabulary The terms and predicates to write the interpretations of.
+ * @param path The path of the file, which is overwritten.
+ * @return std::expected<void, std::string> Nothing, or an error message if the file cannot be written.
+ */
+std::expected<void, std::string> writeModelFile(const IModel& model, const Vocabulary& vocabulary, const std::filesystem::path& path)
+{
+    const DenseModel dense_model(model, vocabulary);
+    const std::vector<std::string> terms = unique(vocabulary.terms);
+    const std::vector<std::string> predicates = unique(vocabulary.predicates);
+    const int worlds = dense_model.worldCardinality();
+
+    FileBuilder builder;
+    const std::uint64_t header_offset = builder.reserve(sizeof(FileHeader));
+    const std::uint64_t terms_offset = builder.reserve(terms.size() * sizeof(TermRecord));
+    const std::uint64_t predicates_offset = builder.reserve(predicates.size() * sizeof(PredicateRecord));
+
+    for (std::size_t i = 0; i < terms.size(); ++i) {
+        const SymbolId id = SymbolTable::global().intern(terms[i]);
+        TermRecord record{ .name = builder.appendString(terms[i]), .denotations = 0, .outcomes = 0 };
+
+        std::vector<std::int32_t> denotations;
+        std::vector<Outcome> outcomes;
+        bool complete = true;
+        for (int world = 0; world < worlds; ++world) {
+            const auto denotation = dense_model.termInterpretationById(id, world);
+            denotations.push_back(denotation.value_or(0));
+            outcomes.push_back(denotation.has_value() ? Outcome{} : Outcome{ .blob = builder.appendString(denotation.error()), .failed = 1, .count = 0 });
+            complete = complete && denotation.has_value();
+        }
+        record.denotations = builder.append(denotations.data(), denotations.size() * sizeof(std::int32_t));
+        if (!complete) {
+            record.outcomes = builder.append(outcomes.data(), outcomes.size() * sizeof(Outcome));
+        }
+        builder.write(terms_offset + i * sizeof(TermRecord), record);
+    }
+
+    for (std::size_t i = 0; i < predicates.size(); ++i) {
+        const SymbolId id = SymbolTable::global().intern(predicates[i]);
+        PredicateRecord record{ .name = builder.appendString(predicates[i]), .arity = 0, .worldStride = 0, .bits = 0, .outcomes = 0 };
+
+        if (const DenseExtension* extension = dense_model.denseExtension(id)) {
+            const std::size_t bit_count = extension->worldStride * static_cast<std::size_t>(extension->worlds);
+            record.arity = extension->arity;
+            record.worldStride = extension->worldStride;
+            record.bits = builder.append(extension->bits, (bit_count + 63) / 64 * sizeof(std::uint64_t));
+        }
+
+        std::vector<Outcome> outcomes;
+        for (int world = 0; world < worlds; ++world) {
+            const auto predint = dense_model.predicateInterpretationById(id, world);
+            outcomes.push_back(predint.has_value() ? appendExtension(builder, *predint.value()) : Outcome{ .blob = builder.appendString(predint.error()), .failed = 1, .count = 0 });
+        }
+        record.outcomes = builder.append(outcomes.data(), outcomes.size() * sizeof(Outcome));
+        builder.write(predicates_offset + i * sizeof(PredicateRecord), record);
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = MODEL_FILE_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.worlds = worlds;
+    header.domain = dense_model.domainCardinality();
+    header.termCount = static_cast<std::uint32_t>(terms.size());
+    header.predicateCount = static_cast<std::uint32_t>(predicates.size());
+    header.termsOffset = terms_offset;
+    header.predicatesOffset = predicates_offset;
+    header.fileSize = builder.bytes().size();
+    builder.write(header_offset, header);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(builder.bytes().data(), static_cast<std::streamsize>(builder.bytes().size()));
+    if (!file) {
+        return std::unexpected(std::format("Cannot write model file {}", path.string()));
+    }
+    return {};
+}
+
+class MappedModel::Impl {
+public:
+    using PredicateRow = std::vector<std::expected<std::set<std::vector<int>>, std::string>>;
+
+    /**
+     * @brief Checks the header and the records of a mapped model file, and resolves its symbols.
+     */
+    static std::expected<std::unique_ptr<Impl>, std::string> load(std::unique_ptr<FileMapping> mapping, const std::filesystem::path& path)
+    {
+        const std::string corrupt = std::format("Model file {} is corrupt", path.string());
+        if (!mapping->contains(0, 1, sizeof(FileHeader))) {
+            return std::unexpected(corrupt);
+        }
+
+        const FileHeader& header = *mapping->at<FileHeader>(0);
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+            return std::unexpected(std::format("{} is not a model file", path.string()));
+        }
+        if (header.version != MODEL_FILE_VERSION) {
+            return std::unexpected(std::format("Model file {} has version {}, expected version {}", path.string(), header.version, MODEL_FILE_VERSION));
+        }
+        if (header.byteOrder != BYTE_ORDER_MARK) {
+            return std::unexpected(std::format("Model file {} was written with another byte order", path.string()));
+        }
+        if (header.fileSize != mapping->size() || header.worlds < 0 || header.domain < 0
+            || !isAligned<TermRecord>(header.termsOffset) || !isAligned<PredicateRecord>(header.predicatesOffset)
+            || !mapping->contains(header.termsOffset, header.termCount, sizeof(TermRecord))
+            || !mapping->contains(header.predicatesOffset, header.predicateCount, sizeof(PredicateRecord))) {
+            return std::unexpected(corrupt);
+        }
+
+        auto impl = std::unique_ptr<Impl>(new Impl(std::move(mapping), header));
+        if (!impl->resolveSymbols()) {
+            return std::unexpected(corrupt);
+        }
+        return impl;
+    }
+
+    static std::optional<std::size_t> slot(const std::vector<std::size_t>& slots, SymbolId id)
+    {
+        if (id < 0 || static_cast<std::size_t>(id) >= slots.size() || slots[static_cast<std::size_t>(id)] == NO_SLOT) {
+            return std::nullopt;
+        }
+        return slots[static_cast<std::size_t>(id)];
+    }
+
+    const TermRecord& term(std::size_t index) const { return m_Mapping->at<TermRecord>(m_Header.termsOffset)[index]; }
+    const PredicateRecord& predicate(std::size_t index) const { return m_Mapping->at<PredicateRecord>(m_Header.predicatesOffset)[index]; }
+    const Outcome& outcome(std::uint64_t outcomes, int world) const { return m_Mapping->at<Outcome>(outcomes)[world]; }
+    const int* denotations(const TermRecord& record) const { return m_Mapping->at<int>(record.denotations); }
+
+    std::string text(const Blob& blob) const
+    {
+        if (!m_Mapping->contains(blob.offset, blob.size, 1)) {
+            return "Corrupt model file";
+        }
+        return std::string(m_Mapping->data() + blob.offset, blob.size);
+    }
+
+    /**
+     * @brief The extensions of a predicate at every world, decoded into sets on first use.
+     */
+    const PredicateRow& decoded(std::size_t index) const
+    {
+        std::call_once(m_DecodedFlags[index], [&] {
+            const PredicateRecord& record = predicate(index);
+            PredicateRow& row = m_Decoded[index];
+            for (int world = 0; world < worldCardinality(); ++world) {
+                row.push_back(decode(outcome(record.outcomes, world)));
+            }
+        });
+        return m_Decoded[index];
+    }
+
+    int worldCardinality() const { return m_Header.worlds; }
+    int domainCardinality() const { return m_Header.domain; }
+
+    static constexpr std::size_t NO_SLOT = std::numeric_limits<std::size_t>::max();
+
+    std::vector<std::size_t> termSlots;
+    std::vector<std::size_t> predicateSlots;
+    std::vector<std::optional<DenseExtension>> extensions;
+
+private:
+    Impl(std::unique_ptr<FileMapping> mapping, const FileHeader& header)
+        : m_Mapping(std::move(mapping)), m_Header(header),
+          m_DecodedFlags(std::make_unique<std::once_flag[]>(header.predicateCount)), m_Decoded(header.predicateCount) {}
+
+    static std::size_t& slotFor(std::vector<std::size_t>& slots, SymbolId id)
+    {
+        if (static_cast<std::size_t>(id) >= slots.size()) {
+            slots.resize(static_cast<std::size_t>(id) + 1, NO_SLOT);
+        }
+        return slots[static_cast<std::size_t>(id)];
+    }
+
+    bool resolveSymbols()
+    {
+        const std::size_t worlds = static_cast<std::size_t>(m_Header.worlds);
+        for (std::size_t i = 0; i < m_Header.termCount; ++i) {
+            const TermRecord& record = term(i);
+            if (!m_Mapping->contains(record.name.offset, record.name.size, 1)
+                || !isAligned<std::int32_t>(record.denotations) || !m_Mapping->contains(record.denotations, worlds, sizeof(std::int32_t))
+                || (record.outcomes != 0 && (!isAligned<Outcome>(record.outcomes) || !m_Mapping->contains(record.outcomes, worlds, sizeof(Outcome))))) {
+                return false;
+            }
+            // Lookups hand the denotations out unchecked, so they must lie in the domain
+            // wherever the term does not fail
+            for (int world = 0; world < m_Header.worlds; ++world) {
+                const std::int32_t denotation = denotations(record)[world];
+                if ((record.outcomes == 0 || outcome(record.outcomes, world).failed == 0) && (denotation < 0 || denotation >= m_Header.domain)) {
+                    return false;
+                }
+            }
+            slotFor(termSlots, SymbolTable::global().intern(text(record.name))) = i;
+        }
+
+        for (std::size_t i = 0; i < m_Header.predicateCount; ++i) {
+            const PredicateRecord& record = predicate(i);
+            if (!m_Mapping->contains(record.name.offset, record.name.size, 1)
+                || !isAligned<Outcome>(record.outcomes) || !m_Mapping->contains(record.outcomes, worlds, sizeof(Outcome))) {
+                return false;
+            }
+            slotFor(predicateSlots, SymbolTable::global().intern(text(record.name))) = i;
+
+            std::optional<DenseExtension>& extension = extensions.emplace_back();
+            if (record.bits != 0) {
+                // Lookups read bit `world * worldStride + index(tuple)`, with `index(tuple) < domain^arity`
+                const std::optional<std::uint64_t> world_stride = power(static_cast<std::uint64_t>(m_Header.domain), record.arity);
+                if (!world_stride.has_value() || record.worldStride != world_stride.value() || !isAligned<std::uint64_t>(record.bits)) {
+                    return false;
+                }
+                if (record.worldStride != 0 && worlds > std::numeric_limits<std::uint64_t>::max() / record.worldStride) {
+                    return false;
+                }
+                const std::uint64_t bit_count = record.worldStride * worlds;
+                if (!m_Mapping->contains(record.bits, (bit_count + 63) / 64, sizeof(std::uint64_t))) {
+                    return false;
+                }
+                extension = DenseExtension{ .arity = static_cast<std::size_t>(record.arity), .domain = m_Header.domain, .worlds = m_Header.worlds,
+                                            .worldStride = static_cast<std::size_t>(record.worldStride), .bits = m_Mapping->at<std::uint64_t>(record.bits) };
+            }
+        }
+        return true;
+    }
+
+    std::expected<std::set<std::vector<int>>, std::string> decode(const Outcome& outcome) const
+    {
+        if (outcome.failed != 0) {
+            return std::unexpected(text(outcome.blob));
+        }
+        if (!isAligned<std::int32_t>(outcome.blob.offset) || !m_Mapping->contains(outcome.blob.offset, outcome.blob.size / sizeof(std::int32_t), sizeof(std::int32_t))) {
+            return std::unexpected("Corrupt model file");
+        }
+
+        const std::int32_t* payload = m_Mapping->at<std::int32_t>(outcome.blob.offset);
+        const std::size_t length = outcome.blob.size / sizeof(std::int32_t);
+        std::set<std::vector<int>> extension;
+        for (std::size_t position = 0; position < length;) {
+            const std::size_t arity = static_cast<std::size_t>(payload[position++]);
+            if (arity > length - position) {
+                return std::unexpected("Corrupt model file");
+            }
+            extension.insert(extension.end(), std::vector<int>(payload + position, payload + position + arity));
+            position += arity;
+        }
+        return extension;
+    }
+
+    std::unique_ptr<FileMapping> m_Mapping;
+    FileHeader m_Header;
+    std::unique_ptr<std::once_flag[]> m_DecodedFlags;
+    mutable std::vector<PredicateRow> m_Decoded;
+};
+
+/**
+ * @brief Maps a model file written by `writeModelFile()`.
+ *
+ * @param path The path of the model file.
+ * @return std::expected<MappedModel, std::string> The model, or an error message if the
+ *         file cannot be mapped, is not a model file, has another version or byte order,
+ *         or is corrupt.
+ */
+std::expected<MappedModel, std::string> MappedModel::open(const std::filesystem::path& path)
+{
+    auto mapping = FileMapping::open(path);
+    if (!mapping.has_value()) {
+        return std::unexpected(mapping.error());
+    }
+    auto impl = Impl::load(std::move(mapping.value()), path);
+    if (!impl.has_value()) {
+        return std::unexpected(impl.error());
+    }
+    return MappedModel(std::move(impl.value()));
+}
+
+MappedModel::MappedModel(std::unique_ptr<Impl> impl)
+    : pImpl(std::move(impl)) {}
+
+MappedModel::MappedModel(MappedModel&&) noexcept = default;
+MappedModel& MappedModel::operator=(MappedModel&&) noexcept = default;
+MappedModel::~MappedModel() = default;
+
+/**
+ * @brief Retrieves the cardinality of the model's set of worlds.
+ */
+int MappedModel::worldCardinality() const
+{
+    return pImpl->worldCardinality();
+}
+
+/**
+ * @brief Retrieves the cardinality of the model's domain.
+ */
+int MappedModel::domainCardinality() const
+{
+    return pImpl->domainCardinality();
+}
+
+/**
+ * @brief Retrieves the interpretation of a term at a world.
+ */
+std::expected<int, std::string> MappedModel::termInterpretation(std::string_view term, int world) const
+{
+    const std::optional<SymbolId> id = SymbolTable::global().find(term);
+    if (!id.has_value()) {
+        return std::unexpected(std::format("Term {} is not in the vocabulary of the model", term));
+    }
+    return termInterpretationById(id.value(), world);
+}
+
+/**
+ * @brief Retrieves the interpretation of a predicate at a world.
+ */
+std::expected<const std::set<std::vector<int>>*, std::string> MappedModel::predicateInterpretation(std::string_view predicate, int world) const
+{
+    const std::optional<SymbolId> id = SymbolTable::global().find(predicate);
+    if (!id.has_value()) {
+        return std::unexpected(std::format("Predicate {} is not in the vocabulary of the model", predicate));
+    }
+    return predicateInterpretationById(id.value(), world);
+}
+
+/**
+ * @brief Retrieves the interpretation of a term at a world, by id, from the mapped file.
+ */
+std::expected<int, std::string> MappedModel::termInterpretationById(SymbolId term, int world) const
+{
+    const std::optional<std::size_t> slot = Impl::slot(pImpl->termSlots, term);
+    if (!slot.has_value()) {
+        return std::unexpected(std::format("Term {} is not in the vocabulary of the model", SymbolTable::global().name(term)));
+    }
+    if (world < 0 || world >= pImpl->worldCardinality()) {
+        return std::unexpected(std::format("World {} is out of range", world));
+    }
+    const TermRecord& record = pImpl->term(slot.value());
+    if (record.outcomes != 0 && pImpl->outcome(record.outcomes, world).failed != 0) {
+        return std::unexpected(pImpl->text(pImpl->outcome(record.outcomes, world).blob));
+    }
+    return pImpl->denotations(record)[world];
+}
+
+/**
+ * @brief Retrieves the interpretation of a predicate at a world, by id.
+ *
+ * The extensions of the predicate are decoded from the mapped file on the first call.
+ */
+std::expected<const std::set<std::vector<int>>*, std::string> MappedModel::predicateInterpretationById(SymbolId predicate, int world) const
+{
+    const std::optional<std::size_t> slot = Impl::slot(pImpl->predicateSlots, predicate);
+    if (!slot.has_value()) {
+        return std::unexpected(std::format("Predicate {} is not in the vocabulary of the model", SymbolTable::global().name(predicate)));
+    }
+    if (world < 0 || world >= pImpl->worldCardinality()) {
+        return std::unexpected(std::format("World {} is out of range", world));
+    }
+    const auto& interpretation = pImpl->decoded(slot.value())[static_cast<std::size_t>(world)];
+    if (!interpretation.has_value()) {
+        return std::unexpected(interpretation.error());
+    }
+    return &interpretation.value();
+}
+
+/**
+ * @brief The mapped denotations of a term indexed by world, or nullptr if it is not interpreted at every world.
+ */
+const int* MappedModel::termTable(SymbolId term) const
+{
+    const std::optional<std::size_t> slot = Impl::slot(pImpl->termSlots, term);
+    if (!slot.has_value() || pImpl->term(slot.value()).outcomes != 0) {
+        return nullptr;
+    }
+    return pImpl->denotations(pImpl->term(slot.value()));
+}
+
+/**
+ * @brief The mapped packed extension of a predicate, or nullptr if the file has none for it.
+ */
+const DenseExtension* MappedModel::denseExtension(SymbolId predicate) const
+{
+    const std::optional<std::size_t> slot = Impl::slot(pImpl->predicateSlots, predicate);
+    if (!slot.has_value() || !pImpl->extensions[slot.value()].has_value()) {
+        return nullptr;
+    }
+    return &pImpl->extensions[slot.value()].value();
+}
+
+}
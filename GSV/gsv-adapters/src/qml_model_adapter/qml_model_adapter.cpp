@@ -1,7 +1,59 @@
 #include "qml_model_adapter.hpp"
 
+#include <cstddef>
+
+#include "lazy_symbol_map.hpp"
+
 namespace iif_sadaf::talk::GSV {
 
+class QMLModelAdapter::Impl {
+public:
+    using TermRow = std::vector<std::expected<int, std::string>>;
+    using PredicateRow = std::vector<std::expected<const std::set<std::vector<int>>*, std::string>>;
+
+    explicit Impl(const QMLModel::QMLModel& model) : ownedModel(nullptr), modelRef(&model) {}
+    explicit Impl(std::unique_ptr<QMLModel::QMLModel> model)
+        : ownedModel(std::move(model)), modelRef(ownedModel.get()) {
+    }
+    const QMLModel::QMLModel& getModel() const { return *modelRef; }
+
+    /**
+     * @brief The interpretations of a term at every world, or nullptr if the id cannot be stored.
+     */
+    const TermRow* terms(SymbolId term)
+    {
+        return resolvedTerms.get(term, [&] {
+            const std::string_view name = SymbolTable::global().name(term);
+            TermRow row;
+            for (int world = 0; world < modelRef->worldCardinality(); ++world) {
+                row.push_back(modelRef->termInterpretation(name, world));
+            }
+            return row;
+        });
+    }
+
+    /**
+     * @brief The interpretations of a predicate at every world, or nullptr if the id cannot be stored.
+     */
+    const PredicateRow* predicates(SymbolId predicate)
+    {
+        return resolvedPredicates.get(predicate, [&] {
+            const std::string_view name = SymbolTable::global().name(predicate);
+            PredicateRow row;
+            for (int world = 0; world < modelRef->worldCardinality(); ++world) {
+                row.push_back(modelRef->predicateInterpretation(name, world));
+            }
+            return row;
+        });
+    }
+
+private:
+    std::unique_ptr<QMLModel::QMLModel> ownedModel;
+    const QMLModel::QMLModel* modelRef;
+    LazySymbolMap<TermRow> resolvedTerms;
+    LazySymbolMap<PredicateRow> resolvedPredicates;
+};
+
 /**
  * @brief Constructs an adapter for an existing QMLModel instance.
  *
@@ -18,6 +70,10 @@ QMLModelAdapter::QMLModelAdapter(const QMLModel::QMLModel& QMLModelModel)
 QMLModelAdapter::QMLModelAdapter(std::unique_ptr<QMLModel::QMLModel> QMLModelModel)
     : pImpl(std::make_unique<Impl>(std::move(QMLModelModel))) {}
 
+QMLModelAdapter::QMLModelAdapter(QMLModelAdapter&&) noexcept = default;
+QMLModelAdapter& QMLModelAdapter::operator=(QMLModelAdapter&&) noexcept = default;
+QMLModelAdapter::~QMLModelAdapter() = default;
+
 /**
  * @brief Retrieves the cardinality of the model's world.
  *
@@ -63,4 +119,32 @@ std::expected<const std::set<std::vector<int>>*, std::string> QMLModelAdapter::p
     return pImpl->getModel().predicateInterpretation(predicate, world);
 }
 
+/**
+ * @brief Retrieves the interpretation of the term with a given symbol id within a specified world.
+ *
+ * Worlds out of range are forwarded to the QMLModel, so they fail as they would by name.
+ */
+std::expected<int, std::string> QMLModelAdapter::termInterpretationById(SymbolId term, int world) const
+{
+    const Impl::TermRow* row = pImpl->terms(term);
+    if (row == nullptr || world < 0 || static_cast<std::size_t>(world) >= row->size()) {
+        return termInterpretation(SymbolTable::global().name(term), world);
+    }
+    return (*row)[world];
+}
+
+/**
+ * @brief Interprets the predicate with a given symbol id within a specified world.
+ *
+ * Worlds out of range are forwarded to the QMLModel, so they fail as they would by name.
+ */
+std::expected<const std::set<std::vector<int>>*, std::string> QMLModelAdapter::predicateInterpretationById(SymbolId predicate, int world) const
+{
+    const Impl::PredicateRow* row = pImpl->predicates(predicate);
+    if (row == nullptr || world < 0 || static_cast<std::size_t>(world) >= row->size()) {
+        return predicateInterpretation(SymbolTable::global().name(predicate), world);
+    }
+    return (*row)[world];
+}
+
 }
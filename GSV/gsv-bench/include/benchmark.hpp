@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace iif_sadaf::talk::GSV::bench {
+
+/**
+ * @brief Keeps the compiler from discarding a value computed by a benchmark.
+ */
+template<typename T>
+void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief How long, and how many times, each benchmark is measured.
+ */
+struct RunOptions {
+    std::chrono::milliseconds minTime{ 200 };
+    int repetitions = 5;
+    std::string filter;
+};
+
+/**
+ * @brief The measurements of one benchmark: nanoseconds per iteration, per repetition.
+ */
+struct Measurement {
+    std::string name;
+    std::size_t iterations = 0;
+    double median = 0.0;
+    double minimum = 0.0;
+};
+
+/**
+ * @brief A named collection of benchmarks, run in registration order.
+ *
+ * Each benchmark is a callable performing one iteration of the measured work. The number
+ * of iterations per repetition is calibrated so that a repetition lasts at least
+ * `RunOptions::minTime / RunOptions::repetitions`, and the median and minimum time per
+ * iteration over the repetitions are reported.
+ */
+class BenchmarkSuite {
+public:
+    void add(std::string name, std::function<void()> iteration);
+
+    std::vector<std::string> names() const;
+    std::vector<Measurement> run(const RunOptions& options, std::ostream& out) const;
+
+private:
+    struct Benchmark {
+        std::string name;
+        std::function<void()> iteration;
+    };
+
+    std::vector<Benchmark> m_Benchmarks;
+};
+
+}
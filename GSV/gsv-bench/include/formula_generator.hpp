@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+#include <QMLExpression/expression.hpp>
+
+#include "synthetic_model.hpp"
+
+namespace iif_sadaf::talk::GSV::bench {
+
+/**
+ * @brief The relative frequencies of the operators in generated formulas.
+ *
+ * A weight of zero leaves the operator out. Quantifiers are only drawn while the
+ * quantifier nesting allows it.
+ */
+struct ConnectiveMix {
+    int negation = 2;
+    int conjunction = 2;
+    int disjunction = 2;
+    int conditional = 2;
+    int possibility = 1;
+    int necessity = 1;
+    int existential = 1;
+    int universal = 1;
+};
+
+/**
+ * @brief The parameters of randomly generated formulas.
+ *
+ * Formulas have at most `depth` nested operators, and at most `quantifierDepth` nested
+ * quantifiers. Atoms are identities with probability `identityRate`, and predications
+ * otherwise; their arguments are variables in scope with probability `variableRate`.
+ */
+struct FormulaParameters {
+    int depth = 4;
+    int quantifierDepth = 1;
+    ConnectiveMix mix;
+    double identityRate = 0.2;
+    double variableRate = 0.7;
+};
+
+/**
+ * @brief Generates random formulas over the vocabulary of a synthetic model.
+ *
+ * Formulas only use the constants and predicates of the model, with their arities, so
+ * their evaluation never fails as long as the model has a constant. A generator seeded the same way generates the same
+ * sequence of formulas. Variables are named `x0, x1, ...` after their quantifier depth.
+ */
+class FormulaGenerator {
+public:
+    FormulaGenerator(const SyntheticModel& model, const FormulaParameters& parameters, std::uint64_t seed);
+
+    QMLExpression::Expression next();
+
+private:
+    QMLExpression::Expression formula(int depth, int bound_variables);
+    QMLExpression::Expression atom(int bound_variables);
+    QMLExpression::Term term(int bound_variables);
+
+    const SyntheticModel& m_Model;
+    FormulaParameters m_Parameters;
+    std::mt19937_64 m_Generator;
+};
+
+}
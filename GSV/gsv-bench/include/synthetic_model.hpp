@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "iindexed_model.hpp"
+#include "symbol_table.hpp"
+
+namespace iif_sadaf::talk::GSV::bench {
+
+/**
+ * @brief The parameters of a randomly generated model.
+ *
+ * Predicate `Pn` has arity `1 + n % maxArity`. At each world, every tuple over the domain
+ * belongs to the extension of a predicate with probability `density`, and every constant
+ * `cn` denotes an individual drawn uniformly from the domain.
+ */
+struct ModelParameters {
+    int worlds = 4;
+    int domain = 3;
+    int constants = 3;
+    int predicates = 3;
+    int maxArity = 2;
+    double density = 0.5;
+    std::uint64_t seed = 1;
+};
+
+/**
+ * @brief A model with random interpretations, generated from `ModelParameters`.
+ *
+ * The same parameters always generate the same model. Constants are named `c0, c1, ...`
+ * and predicates `P0, P1, ...`. The model implements IIndexedModel, and every query is a
+ * lookup in precomputed tables.
+ */
+class SyntheticModel : public IIndexedModel {
+public:
+    explicit SyntheticModel(const ModelParameters& parameters);
+
+    const ModelParameters& parameters() const { return m_Parameters; }
+    int arity(int predicate) const;
+
+    int worldCardinality() const override;
+    int domainCardinality() const override;
+    std::expected<int, std::string> termInterpretation(std::string_view term, int world) const override;
+    std::expected<const std::set<std::vector<int>>*, std::string> predicateInterpretation(std::string_view predicate, int world) const override;
+
+    std::expected<int, std::string> termInterpretationById(SymbolId term, int world) const override;
+    std::expected<const std::set<std::vector<int>>*, std::string> predicateInterpretationById(SymbolId predicate, int world) const override;
+
+private:
+    ModelParameters m_Parameters;
+    std::unordered_map<SymbolId, std::vector<int>> m_Terms;
+    std::unordered_map<SymbolId, std::vector<std::set<std::vector<int>>>> m_Predicates;
+};
+
+}
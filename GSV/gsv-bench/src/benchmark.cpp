@@ -0,0 +1,96 @@
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <format>
+
+namespace iif_sadaf::talk::GSV::bench {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Runs `iterations` iterations of a benchmark, and returns the elapsed time in nanoseconds.
+ */
+double time(const std::function<void()>& iteration, std::size_t iterations)
+{
+    const Clock::time_point start = Clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        iteration();
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+/**
+ * @brief The number of iterations that lasts at least `target` nanoseconds, doubling from one.
+ */
+std::size_t calibrate(const std::function<void()>& iteration, double target)
+{
+    std::size_t iterations = 1;
+    while (time(iteration, iterations) < target && iterations < (std::size_t{ 1 } << 40)) {
+        iterations *= 2;
+    }
+    return iterations;
+}
+
+} // ANONYMOUS NAMESPACE
+
+/**
+ * @brief Registers a benchmark.
+ *
+ * @param name The name of the benchmark, matched by `RunOptions::filter`.
+ * @param iteration One iteration of the measured work.
+ */
+void BenchmarkSuite::add(std::string name, std::function<void()> iteration)
+{
+    m_Benchmarks.push_back({ std::move(name), std::move(iteration) });
+}
+
+/**
+ * @brief The names of the registered benchmarks, in registration order.
+ */
+std::vector<std::string> BenchmarkSuite::names() const
+{
+    std::vector<std::string> names;
+    for (const Benchmark& benchmark : m_Benchmarks) {
+        names.push_back(benchmark.name);
+    }
+    return names;
+}
+
+/**
+ * @brief Measures every benchmark whose name contains `options.filter`.
+ *
+ * @param options How long and how many times each benchmark is measured.
+ * @param out The stream receiving one line per benchmark as it completes.
+ * @return The measurements, in registration order.
+ */
+std::vector<Measurement> BenchmarkSuite::run(const RunOptions& options, std::ostream& out) const
+{
+    const int repetitions = std::max(options.repetitions, 1);
+    const double target = std::chrono::duration<double, std::nano>(options.minTime).count() / repetitions;
+    std::vector<Measurement> measurements;
+
+    out << std::format("{:<48} {:>12} {:>14} {:>14}\n", "benchmark", "iterations", "median ns/it", "min ns/it");
+    for (const Benchmark& benchmark : m_Benchmarks) {
+        if (benchmark.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+
+        Measurement measurement{ .name = benchmark.name, .iterations = calibrate(benchmark.iteration, target) };
+        std::vector<double> samples;
+        for (int repetition = 0; repetition < repetitions; ++repetition) {
+            samples.push_back(time(benchmark.iteration, measurement.iterations) / static_cast<double>(measurement.iterations));
+        }
+        std::ranges::sort(samples);
+        measurement.median = samples[samples.size() / 2];
+        measurement.minimum = samples.front();
+
+        out << std::format("{:<48} {:>12} {:>14.1f} {:>14.1f}\n", measurement.name, measurement.iterations, measurement.median, measurement.minimum);
+        out.flush();
+        measurements.push_back(std::move(measurement));
+    }
+    return measurements;
+}
+
+}
@@ -0,0 +1,122 @@
+#include "formula_generator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <memory>
+#include <vector>
+
+namespace iif_sadaf::talk::GSV::bench {
+
+namespace {
+
+enum class Choice { NEGATION, POSSIBILITY, NECESSITY, CONJUNCTION, DISJUNCTION, CONDITIONAL, EXISTENTIAL, UNIVERSAL };
+
+QMLExpression::Expression unary(QMLExpression::Operator op, QMLExpression::Expression scope)
+{
+    return std::make_shared<QMLExpression::UnaryNode>(op, std::move(scope));
+}
+
+QMLExpression::Expression binary(QMLExpression::Operator op, QMLExpression::Expression lhs, QMLExpression::Expression rhs)
+{
+    return std::make_shared<QMLExpression::BinaryNode>(op, std::move(lhs), std::move(rhs));
+}
+
+QMLExpression::Expression quantification(QMLExpression::Quantifier quantifier, int variable, QMLExpression::Expression scope)
+{
+    return std::make_shared<QMLExpression::QuantificationNode>(quantifier, QMLExpression::Term(QMLExpression::Term::Type::VARIABLE, std::format("x{}", variable)), std::move(scope));
+}
+
+} // ANONYMOUS NAMESPACE
+
+/**
+ * @brief Constructs a generator of formulas over the vocabulary of a model.
+ *
+ * @param model The model whose constants and predicates formulas are built from. It must outlive the generator.
+ * @param parameters The shape of the generated formulas.
+ * @param seed The seed of the generator.
+ */
+FormulaGenerator::FormulaGenerator(const SyntheticModel& model, const FormulaParameters& parameters, std::uint64_t seed)
+    : m_Model(model), m_Parameters(parameters), m_Generator(seed) {}
+
+/**
+ * @brief Generates the next formula of the sequence.
+ */
+QMLExpression::Expression FormulaGenerator::next()
+{
+    return formula(m_Parameters.depth, 0);
+}
+
+QMLExpression::Expression FormulaGenerator::formula(int depth, int bound_variables)
+{
+    const ConnectiveMix& mix = m_Parameters.mix;
+    const bool may_quantify = bound_variables < m_Parameters.quantifierDepth;
+    const std::array<int, 8> weights = {
+        std::max(mix.negation, 0), std::max(mix.possibility, 0), std::max(mix.necessity, 0),
+        std::max(mix.conjunction, 0), std::max(mix.disjunction, 0), std::max(mix.conditional, 0),
+        may_quantify ? std::max(mix.existential, 0) : 0, may_quantify ? std::max(mix.universal, 0) : 0
+    };
+    if (depth <= 0 || std::ranges::all_of(weights, [](int weight) { return weight == 0; })) {
+        return atom(bound_variables);
+    }
+
+    std::discrete_distribution<int> operators(weights.begin(), weights.end());
+    switch (static_cast<Choice>(operators(m_Generator))) {
+    case Choice::NEGATION:
+        return unary(QMLExpression::Operator::NEGATION, formula(depth - 1, bound_variables));
+    case Choice::POSSIBILITY:
+        return unary(QMLExpression::Operator::EPISTEMIC_POSSIBILITY, formula(depth - 1, bound_variables));
+    case Choice::NECESSITY:
+        return unary(QMLExpression::Operator::EPISTEMIC_NECESSITY, formula(depth - 1, bound_variables));
+    case Choice::CONJUNCTION: {
+        QMLExpression::Expression lhs = formula(depth - 1, bound_variables);
+        return binary(QMLExpression::Operator::CONJUNCTION, std::move(lhs), formula(depth - 1, bound_variables));
+    }
+    case Choice::DISJUNCTION: {
+        QMLExpression::Expression lhs = formula(depth - 1, bound_variables);
+        return binary(QMLExpression::Operator::DISJUNCTION, std::move(lhs), formula(depth - 1, bound_variables));
+    }
+    case Choice::CONDITIONAL: {
+        QMLExpression::Expression lhs = formula(depth - 1, bound_variables);
+        return binary(QMLExpression::Operator::CONDITIONAL, std::move(lhs), formula(depth - 1, bound_variables));
+    }
+    case Choice::EXISTENTIAL:
+        return quantification(QMLExpression::Quantifier::EXISTENTIAL, bound_variables, formula(depth - 1, bound_variables + 1));
+    case Choice::UNIVERSAL:
+        return quantification(QMLExpression::Quantifier::UNIVERSAL, bound_variables, formula(depth - 1, bound_variables + 1));
+    }
+    return atom(bound_variables);
+}
+
+QMLExpression::Expression FormulaGenerator::atom(int bound_variables)
+{
+    const ModelParameters& model_parameters = m_Model.parameters();
+    std::bernoulli_distribution is_identity(m_Parameters.identityRate);
+    if (model_parameters.predicates <= 0 || is_identity(m_Generator)) {
+        QMLExpression::Term lhs = term(bound_variables);
+        return std::make_shared<QMLExpression::IdentityNode>(std::move(lhs), term(bound_variables));
+    }
+
+    const int predicate = std::uniform_int_distribution<int>(0, model_parameters.predicates - 1)(m_Generator);
+    std::vector<QMLExpression::Term> arguments;
+    for (int position = 0; position < m_Model.arity(predicate); ++position) {
+        arguments.push_back(term(bound_variables));
+    }
+    return std::make_shared<QMLExpression::PredicationNode>(std::format("P{}", predicate), std::move(arguments));
+}
+
+/**
+ * @brief A variable in scope or a constant of the model; a variable if the model has no constants.
+ */
+QMLExpression::Term FormulaGenerator::term(int bound_variables)
+{
+    std::bernoulli_distribution is_variable(m_Parameters.variableRate);
+    if (bound_variables > 0 && (m_Model.parameters().constants <= 0 || is_variable(m_Generator))) {
+        const int variable = std::uniform_int_distribution<int>(0, bound_variables - 1)(m_Generator);
+        return QMLExpression::Term(QMLExpression::Term::Type::VARIABLE, std::format("x{}", variable));
+    }
+    const int constant = std::uniform_int_distribution<int>(0, std::max(m_Model.parameters().constants, 1) - 1)(m_Generator);
+    return QMLExpression::Term(QMLExpression::Term::Type::CONSTANT, std::format("c{}", constant));
+}
+
+}
@@ -0,0 +1,300 @@
+#include <charconv>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <QMLExpression/expression.hpp>
+
+#include "benchmark.hpp"
+#include "dense_model.hpp"
+#include "evaluator.hpp"
+#include "formula_generator.hpp"
+#include "information_state.hpp"
+#include "program.hpp"
+#include "semantic_relations.hpp"
+#include "synthetic_model.hpp"
+
+namespace GSV = iif_sadaf::talk::GSV;
+namespace bench = iif_sadaf::talk::GSV::bench;
+namespace QMLExpression = iif_sadaf::talk::QMLExpression;
+
+namespace {
+
+struct Settings {
+    bench::RunOptions run;
+    std::uint64_t seed = 1;
+    int evaluatorWorlds = 16;
+    int relationWorlds = 8;
+    int domain = 3;
+    double density = 0.5;
+    bool list = false;
+    bool help = false;
+};
+
+void printUsage()
+{
+    std::cout << "Usage: gsv-bench [options]\n"
+              << "  --filter=TEXT        only run benchmarks whose name contains TEXT\n"
+              << "  --min-time=MS        minimum measured time per benchmark, in milliseconds (default 200)\n"
+              << "  --repetitions=N      repetitions per benchmark (default 5)\n"
+              << "  --seed=N             seed of the model and formula generators (default 1)\n"
+              << "  --worlds=N           worlds of the model of the evaluator benchmarks (default 16)\n"
+              << "  --relation-worlds=N  worlds of the model of the relation benchmarks (default 8)\n"
+              << "  --domain=N           domain size of the models (default 3)\n"
+              << "  --density=X          predicate density of the models (default 0.5)\n"
+              << "  --list               list the benchmarks and exit\n"
+              << "  --help               print this message and exit\n";
+}
+
+template<typename T>
+bool parseNumber(std::string_view text, T& value)
+{
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return error == std::errc() && end == text.data() + text.size();
+}
+
+bool parseArguments(int argc, char** argv, Settings& settings)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view argument = argv[i];
+        const std::size_t equals = argument.find('=');
+        const std::string_view key = argument.substr(0, equals);
+        const std::string_view value = equals == std::string_view::npos ? std::string_view() : argument.substr(equals + 1);
+
+        bool parsed = true;
+        if (key == "--filter") {
+            settings.run.filter = std::string(value);
+        }
+        else if (key == "--min-time") {
+            int milliseconds = 0;
+            parsed = parseNumber(value, milliseconds);
+            settings.run.minTime = std::chrono::milliseconds(milliseconds);
+        }
+        else if (key == "--repetitions") {
+            parsed = parseNumber(value, settings.run.repetitions);
+        }
+        else if (key == "--seed") {
+            parsed = parseNumber(value, settings.seed);
+        }
+        else if (key == "--worlds") {
+            parsed = parseNumber(value, settings.evaluatorWorlds);
+        }
+        else if (key == "--relation-worlds") {
+            parsed = parseNumber(value, settings.relationWorlds);
+        }
+        else if (key == "--domain") {
+            parsed = parseNumber(value, settings.domain);
+        }
+        else if (key == "--density") {
+            parsed = parseNumber(value, settings.density);
+        }
+        else if (key == "--list") {
+            settings.list = true;
+        }
+        else if (key == "--help") {
+            settings.help = true;
+        }
+        else {
+            parsed = false;
+        }
+
+        if (!parsed) {
+            std::cerr << std::format("Invalid argument: {}\n", argument);
+            return false;
+        }
+    }
+    return true;
+}
+
+bench::FormulaParameters shape(int depth, int quantifier_depth)
+{
+    bench::FormulaParameters parameters;
+    parameters.depth = depth;
+    parameters.quantifierDepth = quantifier_depth;
+    return parameters;
+}
+
+QMLExpression::Term constant(int n)
+{
+    return QMLExpression::Term(QMLExpression::Term::Type::CONSTANT, std::format("c{}", n));
+}
+
+QMLExpression::Term variable(int n)
+{
+    return QMLExpression::Term(QMLExpression::Term::Type::VARIABLE, std::format("x{}", n));
+}
+
+QMLExpression::Expression predication(int predicate, std::vector<QMLExpression::Term> arguments)
+{
+    return std::make_shared<QMLExpression::PredicationNode>(std::format("P{}", predicate), std::move(arguments));
+}
+
+QMLExpression::Expression unary(QMLExpression::Operator op, QMLExpression::Expression scope)
+{
+    return std::make_shared<QMLExpression::UnaryNode>(op, std::move(scope));
+}
+
+QMLExpression::Expression binary(QMLExpression::Operator op, QMLExpression::Expression lhs, QMLExpression::Expression rhs)
+{
+    return std::make_shared<QMLExpression::BinaryNode>(op, std::move(lhs), std::move(rhs));
+}
+
+QMLExpression::Expression quantification(QMLExpression::Quantifier quantifier, QMLExpression::Expression scope)
+{
+    return std::make_shared<QMLExpression::QuantificationNode>(quantifier, variable(0), std::move(scope));
+}
+
+/**
+ * @brief Registers a benchmark evaluating a compiled formula on a fixed state.
+ */
+void addEvaluation(bench::BenchmarkSuite& suite, std::string name, const QMLExpression::Expression& expr, const GSV::InformationState& state, const GSV::IModel& model)
+{
+    suite.add(std::move(name), [program = GSV::Program(expr), &state, &model] {
+        bench::doNotOptimize(GSV::evaluate(program, state, model, GSV::EvaluationOptions{}));
+    });
+}
+
+/**
+ * @brief Registers one benchmark per node type of the evaluator: each node over atomic subformulas.
+ */
+void addNodeBenchmarks(bench::BenchmarkSuite& suite, const bench::SyntheticModel& model, const GSV::InformationState& ignorant_state, const GSV::InformationState& bound_state)
+{
+    using QMLExpression::Operator;
+    using QMLExpression::Quantifier;
+
+    const QMLExpression::Expression atom = predication(0, { constant(0) });
+    const QMLExpression::Expression other_atom = predication(2, { constant(1) });
+
+    addEvaluation(suite, "evaluator/predication", predication(1, { constant(0), constant(1) }), ignorant_state, model);
+    addEvaluation(suite, "evaluator/predication-variable", predication(1, { variable(0), constant(1) }), bound_state, model);
+    addEvaluation(suite, "evaluator/identity", std::make_shared<QMLExpression::IdentityNode>(constant(0), constant(1)), ignorant_state, model);
+    addEvaluation(suite, "evaluator/negation", unary(Operator::NEGATION, atom), ignorant_state, model);
+    addEvaluation(suite, "evaluator/possibility", unary(Operator::EPISTEMIC_POSSIBILITY, atom), ignorant_state, model);
+    addEvaluation(suite, "evaluator/necessity", unary(Operator::EPISTEMIC_NECESSITY, atom), ignorant_state, model);
+    addEvaluation(suite, "evaluator/conjunction", binary(Operator::CONJUNCTION, atom, other_atom), ignorant_state, model);
+    addEvaluation(suite, "evaluator/disjunction", binary(Operator::DISJUNCTION, atom, other_atom), ignorant_state, model);
+    addEvaluation(suite, "evaluator/conditional", binary(Operator::CONDITIONAL, atom, other_atom), ignorant_state, model);
+    addEvaluation(suite, "evaluator/existential", quantification(Quantifier::EXISTENTIAL, predication(0, { variable(0) })), ignorant_state, model);
+    addEvaluation(suite, "evaluator/universal", quantification(Quantifier::UNIVERSAL, predication(0, { variable(0) })), ignorant_state, model);
+}
+
+/**
+ * @brief Registers benchmarks evaluating batches of random formulas of increasing depth.
+ */
+void addRandomFormulaBenchmarks(bench::BenchmarkSuite& suite, const std::string& prefix, const bench::SyntheticModel& generator_model, const GSV::IModel& model, const GSV::InformationState& ignorant_state, std::uint64_t seed, const GSV::EvaluationOptions& options = {})
+{
+    constexpr int BATCH_SIZE = 16;
+    for (const int depth : { 2, 4, 6 }) {
+        bench::FormulaGenerator generator(generator_model, shape(depth, 2), seed + static_cast<std::uint64_t>(depth));
+        std::vector<GSV::Program> programs;
+        for (int i = 0; i < BATCH_SIZE; ++i) {
+            programs.emplace_back(generator.next());
+        }
+        suite.add(std::format("{}/random-depth-{}-x{}", prefix, depth, BATCH_SIZE), [programs = std::move(programs), &ignorant_state, &model, options] {
+            for (const GSV::Program& program : programs) {
+                bench::doNotOptimize(GSV::evaluate(program, ignorant_state, model, options));
+            }
+        });
+    }
+}
+
+/**
+ * @brief Registers benchmarks of the core primitives on states of the evaluator model.
+ */
+void addCoreBenchmarks(bench::BenchmarkSuite& suite, const GSV::InformationState& ignorant_state, const GSV::InformationState& bound_state)
+{
+    const GSV::SymbolId x1 = GSV::SymbolTable::global().intern("x1");
+
+    suite.add("core/update", [&ignorant_state, x1] {
+        bench::doNotOptimize(GSV::update(ignorant_state, x1, 0));
+    });
+    suite.add("core/update-nested", [&bound_state, x1] {
+        bench::doNotOptimize(GSV::update(bound_state, x1, 0));
+    });
+    suite.add("core/extends", [&ignorant_state, &bound_state] {
+        bench::doNotOptimize(GSV::extends(bound_state, ignorant_state));
+    });
+    suite.add("core/subsistsIn", [&ignorant_state, &bound_state] {
+        bench::doNotOptimize(GSV::subsistsIn(ignorant_state, bound_state));
+    });
+}
+
+/**
+ * @brief Registers end-to-end benchmarks of the model-level relations, on random formulas.
+ */
+void addRelationBenchmarks(bench::BenchmarkSuite& suite, const bench::SyntheticModel& model, std::uint64_t seed)
+{
+    bench::FormulaGenerator generator(model, shape(3, 1), seed);
+    const QMLExpression::Expression premise = generator.next();
+    const QMLExpression::Expression conclusion = generator.next();
+
+    bench::FormulaParameters modal_free_parameters = shape(3, 1);
+    modal_free_parameters.mix.possibility = 0;
+    modal_free_parameters.mix.necessity = 0;
+    const QMLExpression::Expression modal_free = bench::FormulaGenerator(model, modal_free_parameters, seed).next();
+
+    suite.add("relations/entails_G", [=, &model] { bench::doNotOptimize(GSV::entails_G({ premise }, conclusion, model)); });
+    suite.add("relations/entails_G-reflexive", [=, &model] { bench::doNotOptimize(GSV::entails_G({ premise }, premise, model)); });
+    suite.add("relations/entails_G-modal-free", [=, &model] { bench::doNotOptimize(GSV::entails_G({ modal_free }, modal_free, model)); });
+    suite.add("relations/entails_C", [=, &model] { bench::doNotOptimize(GSV::entails_C({ premise }, conclusion, model)); });
+    suite.add("relations/entails_C-reflexive", [=, &model] { bench::doNotOptimize(GSV::entails_C({ premise }, premise, model)); });
+    suite.add("relations/coherent", [=, &model] { bench::doNotOptimize(GSV::coherent(premise, model)); });
+    suite.add("relations/equivalent", [=, &model] { bench::doNotOptimize(GSV::equivalent(premise, conclusion, model)); });
+    suite.add("relations/equivalent-reflexive", [=, &model] { bench::doNotOptimize(GSV::equivalent(premise, premise, model)); });
+    suite.add("relations/entails_G-arena", [=, &model] { bench::doNotOptimize(GSV::entails_G({ premise }, conclusion, model, GSV::RelationOptions{ .useArena = true })); });
+}
+
+} // ANONYMOUS NAMESPACE
+
+int main(int argc, char** argv)
+{
+    Settings settings;
+    if (!parseArguments(argc, argv, settings)) {
+        printUsage();
+        return 1;
+    }
+    if (settings.help) {
+        printUsage();
+        return 0;
+    }
+
+    const bench::SyntheticModel evaluator_model({ .worlds = settings.evaluatorWorlds, .domain = settings.domain, .constants = 3, .predicates = 3,
+                                                .maxArity = 2, .density = settings.density, .seed = settings.seed });
+    const bench::SyntheticModel relation_model({ .worlds = settings.relationWorlds, .domain = settings.domain, .constants = 3, .predicates = 3,
+                                               .maxArity = 2, .density = settings.density, .seed = settings.seed });
+
+    const GSV::InformationState ignorant_state = GSV::create(evaluator_model);
+    const GSV::InformationState bound_state = GSV::update(ignorant_state, GSV::SymbolTable::global().intern("x0"), 0);
+
+    bench::BenchmarkSuite suite;
+    addNodeBenchmarks(suite, evaluator_model, ignorant_state, bound_state);
+    addRandomFormulaBenchmarks(suite, "evaluator", evaluator_model, evaluator_model, ignorant_state, settings.seed);
+    addRandomFormulaBenchmarks(suite, "evaluator-arena", evaluator_model, evaluator_model, ignorant_state, settings.seed, GSV::EvaluationOptions{ .useArena = true });
+
+    GSV::Vocabulary vocabulary;
+    for (int i = 0; i < evaluator_model.parameters().constants; ++i) {
+        vocabulary.terms.push_back(std::format("c{}", i));
+    }
+    for (int i = 0; i < evaluator_model.parameters().predicates; ++i) {
+        vocabulary.predicates.push_back(std::format("P{}", i));
+    }
+    const GSV::DenseModel dense_model(evaluator_model, vocabulary);
+    addRandomFormulaBenchmarks(suite, "evaluator-dense", evaluator_model, dense_model, ignorant_state, settings.seed);
+    addCoreBenchmarks(suite, ignorant_state, bound_state);
+    addRelationBenchmarks(suite, relation_model, settings.seed);
+
+    if (settings.list) {
+        for (const std::string& name : suite.names()) {
+            std::cout << name << "\n";
+        }
+        return 0;
+    }
+
+    std::cout << std::format("seed {}, evaluator model {} worlds, relation model {} worlds, domain {}, density {}\n\n",
+                             settings.seed, settings.evaluatorWorlds, settings.relationWorlds, settings.domain, settings.density);
+    suite.run(settings.run, std::cout);
+    return 0;
+}
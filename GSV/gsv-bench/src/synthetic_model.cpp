@@ -0,0 +1,130 @@
+#include "synthetic_model.hpp"
+
+#include <algorithm>
+#include <format>
+#include <optional>
+#include <random>
+
+namespace iif_sadaf::talk::GSV::bench {
+
+namespace {
+
+/**
+ * @brief Every tuple of the given arity over the domain `0, ..., domain - 1`, in lexicographic order.
+ */
+std::vector<std::vector<int>> allTuples(int arity, int domain)
+{
+    std::vector<std::vector<int>> tuples = { {} };
+    for (int position = 0; position < arity; ++position) {
+        std::vector<std::vector<int>> longer_tuples;
+        for (const std::vector<int>& tuple : tuples) {
+            for (int individual = 0; individual < domain; ++individual) {
+                longer_tuples.push_back(tuple);
+                longer_tuples.back().push_back(individual);
+            }
+        }
+        tuples = std::move(longer_tuples);
+    }
+    return tuples;
+}
+
+} // ANONYMOUS NAMESPACE
+
+/**
+ * @brief Generates a model from its parameters.
+ *
+ * @param parameters The parameters of the model. Cardinalities below one are raised to one.
+ */
+SyntheticModel::SyntheticModel(const ModelParameters& parameters)
+    : m_Parameters(parameters)
+{
+    m_Parameters.worlds = std::max(m_Parameters.worlds, 1);
+    m_Parameters.domain = std::max(m_Parameters.domain, 1);
+    m_Parameters.maxArity = std::max(m_Parameters.maxArity, 1);
+
+    std::mt19937_64 generator(m_Parameters.seed);
+    std::uniform_int_distribution<int> individual(0, m_Parameters.domain - 1);
+    std::bernoulli_distribution in_extension(std::clamp(m_Parameters.density, 0.0, 1.0));
+
+    for (int constant = 0; constant < m_Parameters.constants; ++constant) {
+        std::vector<int>& denotations = m_Terms[SymbolTable::global().intern(std::format("c{}", constant))];
+        for (int world = 0; world < m_Parameters.worlds; ++world) {
+            denotations.push_back(individual(generator));
+        }
+    }
+
+    for (int predicate = 0; predicate < m_Parameters.predicates; ++predicate) {
+        const std::vector<std::vector<int>> tuples = allTuples(arity(predicate), m_Parameters.domain);
+        std::vector<std::set<std::vector<int>>>& extensions = m_Predicates[SymbolTable::global().intern(std::format("P{}", predicate))];
+        for (int world = 0; world < m_Parameters.worlds; ++world) {
+            std::set<std::vector<int>>& extension = extensions.emplace_back();
+            for (const std::vector<int>& tuple : tuples) {
+                if (in_extension(generator)) {
+                    extension.insert(extension.end(), tuple);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief The arity of predicate `Pn`.
+ */
+int SyntheticModel::arity(int predicate) const
+{
+    return 1 + predicate % m_Parameters.maxArity;
+}
+
+int SyntheticModel::worldCardinality() const
+{
+    return m_Parameters.worlds;
+}
+
+int SyntheticModel::domainCardinality() const
+{
+    return m_Parameters.domain;
+}
+
+std::expected<int, std::string> SyntheticModel::termInterpretation(std::string_view term, int world) const
+{
+    const std::optional<SymbolId> id = SymbolTable::global().find(term);
+    if (!id.has_value()) {
+        return std::unexpected(std::format("Term {} is not interpreted in the model", term));
+    }
+    return termInterpretationById(id.value(), world);
+}
+
+std::expected<const std::set<std::vector<int>>*, std::string> SyntheticModel::predicateInterpretation(std::string_view predicate, int world) const
+{
+    const std::optional<SymbolId> id = SymbolTable::global().find(predicate);
+    if (!id.has_value()) {
+        return std::unexpected(std::format("Predicate {} is not interpreted in the model", predicate));
+    }
+    return predicateInterpretationById(id.value(), world);
+}
+
+std::expected<int, std::string> SyntheticModel::termInterpretationById(SymbolId term, int world) const
+{
+    const auto it = m_Terms.find(term);
+    if (it == m_Terms.end()) {
+        return std::unexpected(std::format("Term {} is not interpreted in the model", SymbolTable::global().name(term)));
+    }
+    if (world < 0 || world >= m_Parameters.worlds) {
+        return std::unexpected(std::format("World {} is not in the model", world));
+    }
+    return it->second[static_cast<std::size_t>(world)];
+}
+
+std::expected<const std::set<std::vector<int>>*, std::string> SyntheticModel::predicateInterpretationById(SymbolId predicate, int world) const
+{
+    const auto it = m_Predicates.find(predicate);
+    if (it == m_Predicates.end()) {
+        return std::unexpected(std::format("Predicate {} is not interpreted in the model", SymbolTable::global().name(predicate)));
+    }
+    if (world < 0 || world >= m_Parameters.worlds) {
+        return std::unexpected(std::format("World {} is not in the model", world));
+    }
+    return &it->second[static_cast<std::size_t>(world)];
+}
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief An assignment of individuals to pegs, stored as a contiguous array indexed by peg.
+ *
+ * Pegs are handed out consecutively from 1 by referent systems, so the individual of
+ * peg `n` is kept in slot `n - 1`. Assignments of up to `INLINE_CAPACITY` pegs are
+ * stored inside the object itself and never allocate; longer ones move to a single heap
+ * array. Lookups, comparisons and copies are therefore linear scans over contiguous
+ * memory.
+ *
+ * Slots of pegs that were skipped hold `UNASSIGNED`. Individuals are indices into the
+ * domain of a model, so `UNASSIGNED` cannot be assigned to a peg.
+ */
+class Assignment {
+public:
+    static constexpr int UNASSIGNED = std::numeric_limits<int>::min();
+    static constexpr std::uint32_t INLINE_CAPACITY = 6;
+
+    Assignment() = default;
+    Assignment(const Assignment& other);
+    Assignment& operator=(const Assignment& other);
+    Assignment(Assignment&& other) noexcept;
+    Assignment& operator=(Assignment&& other) noexcept;
+    ~Assignment();
+
+    bool empty() const { return m_Assigned == 0; }
+    std::size_t size() const { return m_Assigned; }
+
+    bool contains(int peg) const
+    {
+        return peg >= 1 && static_cast<std::uint32_t>(peg) <= m_Length && data()[peg - 1] != UNASSIGNED;
+    }
+
+    int at(int peg) const;
+    void assign(int peg, int individual);
+    void clear();
+
+    /**
+     * @brief The slots of the assignment: the individual of peg `n`, or `UNASSIGNED`, is at index `n - 1`.
+     */
+    std::span<const int> slots() const { return { data(), m_Length }; }
+
+private:
+    bool isInline() const { return m_Capacity == INLINE_CAPACITY; }
+    int* data() { return isInline() ? m_Inline : m_Heap; }
+    const int* data() const { return isInline() ? m_Inline : m_Heap; }
+    void reserve(std::uint32_t capacity);
+
+    std::uint32_t m_Length = 0;
+    std::uint32_t m_Assigned = 0;
+    std::uint32_t m_Capacity = INLINE_CAPACITY;
+    union {
+        int m_Inline[INLINE_CAPACITY];
+        int* m_Heap;
+    };
+};
+
+bool operator==(const Assignment& a1, const Assignment& a2);
+bool operator<(const Assignment& a1, const Assignment& a2);
+
+}
@@ -1,5 +1,12 @@
 #pragma once
 
+#include "assignment.hpp"
+#include "decision_diagram.hpp"
 #include "information_state.hpp"
+#include "lazy_symbol_map.hpp"
 #include "possibility.hpp"
-#include "referent_system.hpp"
\ No newline at end of file
+#include "possibility_set.hpp"
+#include "referent_system.hpp"
+#include "substate_enumerator.hpp"
+#include "symbol_table.hpp"
+#include "world_set.hpp"
\ No newline at end of file
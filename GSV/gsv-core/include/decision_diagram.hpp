@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "world_set.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief Reduced ordered binary decision diagrams over the worlds of a model.
+ *
+ * A diagram has one decision variable per world, tested in ascending world order, and
+ * denotes the family of the world sets whose characteristic functions satisfy it: the
+ * diagram of `world(w)` denotes the world sets containing `w`. Families of world sets are
+ * thus combined with the boolean operations of their characteristic functions, and
+ * families sharing structure share their nodes, so a family of exponentially many world
+ * sets usually takes a number of nodes linear in the number of worlds.
+ *
+ * All diagrams of a `DecisionDiagram` live in it, and are referred to by their root `Node`.
+ * Nodes are hash-consed, so two nodes denote the same family iff they are equal. Nodes are
+ * never freed before the `DecisionDiagram` itself. It is not thread-safe.
+ */
+class DecisionDiagram {
+public:
+    using Node = std::uint32_t;
+
+    static constexpr Node ZERO = 0;
+    static constexpr Node ONE = 1;
+
+    explicit DecisionDiagram(int worlds);
+
+    DecisionDiagram(const DecisionDiagram&) = delete;
+    DecisionDiagram& operator=(const DecisionDiagram&) = delete;
+
+    int worlds() const;
+    std::size_t nodeCount() const;
+
+    Node world(int world);
+    Node negation(Node f);
+    Node conjunction(Node f, Node g);
+    Node disjunction(Node f, Node g);
+    Node ifThenElse(Node f, Node g, Node h);
+
+    std::vector<bool> cardinalities(Node f);
+    std::optional<WorldSet> first(Node f, int size);
+
+private:
+    /**
+     * @brief A decision on the world `level`. Terminals have level `worlds()`.
+     */
+    struct Decision {
+        int level;
+        Node low;
+        Node high;
+    };
+
+    struct Triple {
+        std::uint32_t x;
+        std::uint32_t y;
+        std::uint32_t z;
+
+        bool operator==(const Triple&) const = default;
+    };
+
+    struct TripleHash {
+        std::size_t operator()(const Triple& triple) const;
+    };
+
+    using Counts = std::vector<std::uint64_t>;
+
+    Node decision(int level, Node low, Node high);
+    Node cofactor(Node f, int level, bool value) const;
+    const Counts& counts(Node f);
+    bool reaches(Node f, int level, int size);
+
+    int m_Worlds;
+    std::vector<Decision> m_Decisions;
+    std::unordered_map<Triple, Node, TripleHash> m_Unique;
+    std::unordered_map<Triple, Node, TripleHash> m_Computed;
+    std::unordered_map<Node, Counts> m_Counts;
+};
+
+}
@@ -1,23 +1,40 @@
 #pragma once
 
+#include <cstddef>
+#include <memory_resource>
+#include <ranges>
 #include <set>
 #include <string>
 #include <string_view>
 
 #include "imodel.hpp"
 #include "possibility.hpp"
+#include "symbol_table.hpp"
 
 namespace iif_sadaf::talk::GSV {
 
 /**
- * @brief An alias for `std::set<Possibility>`
+ * @brief An alias for `std::pmr::set<Possibility, PossibilityOrder>`
+ *
+ * Possibilities are kept in their canonical order (see `PossibilityOrder`): a state holds
+ * any number of possibilities at the same world, as long as they differ in their
+ * assignment or referent system, and those at a world are found in logarithmic time.
+ *
+ * States use the default memory resource unless constructed with another one. The
+ * evaluator can allocate its intermediate states from an `EvaluationArena`.
+ *
+ * States are values, and the functions below never modify their inputs, so a state may
+ * be read by any number of threads at once, as long as none of them modifies it.
  */
-using InformationState = std::set<Possibility>;
+using InformationState = std::pmr::set<Possibility, PossibilityOrder>;
 
 InformationState create(const IModel& model);
 InformationState update(const InformationState& input_state, std::string_view variable, int individual);
+InformationState update(const InformationState& input_state, SymbolId variable, int individual, std::pmr::memory_resource* resource = nullptr);
 bool extends(const InformationState& s2, const InformationState& s1);
+std::size_t hashValue(const InformationState& state);
 
+std::ranges::subrange<InformationState::const_iterator> descendantCandidates(const Possibility& p, const InformationState& s);
 bool isDescendantOf(const Possibility& p2, const Possibility& p1, const InformationState& s);
 bool subsistsIn(const Possibility& p, const InformationState& s);
 bool subsistsIn(const InformationState& s1, const InformationState& s2);
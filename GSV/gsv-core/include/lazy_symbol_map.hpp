@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+#include "symbol_table.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief A map from symbol ids to values that are computed once, on first access.
+ *
+ * Values are stored in fixed-size chunks that are allocated on demand, so looking up a
+ * value that is already computed takes two atomic loads and no lock. Concurrent first
+ * accesses to an id may compute its value more than once, but only one result is ever
+ * published, and the others are discarded. Ids beyond the capacity of the map are not
+ * stored.
+ *
+ * @tparam Value The type of the stored values.
+ */
+template<typename Value>
+class LazySymbolMap {
+public:
+    LazySymbolMap() = default;
+    LazySymbolMap(const LazySymbolMap&) = delete;
+    LazySymbolMap& operator=(const LazySymbolMap&) = delete;
+
+    ~LazySymbolMap()
+    {
+        for (std::atomic<Chunk*>& slot : m_Chunks) {
+            Chunk* chunk = slot.load();
+            if (chunk == nullptr) {
+                continue;
+            }
+            for (std::atomic<const Value*>& value : *chunk) {
+                delete value.load();
+            }
+            delete chunk;
+        }
+    }
+
+    /**
+     * @brief Returns the value of an id, computing it with `compute()` if needed.
+     *
+     * @return A pointer to the value, valid for the lifetime of the map, or nullptr if
+     *         the id is negative or beyond the capacity of the map.
+     */
+    template<typename Compute>
+    const Value* get(SymbolId id, const Compute& compute)
+    {
+        if (id < 0 || static_cast<std::size_t>(id) >= CHUNK_SIZE * CHUNK_COUNT) {
+            return nullptr;
+        }
+
+        std::atomic<Chunk*>& chunk_slot = m_Chunks[static_cast<std::size_t>(id) / CHUNK_SIZE];
+        Chunk* chunk = chunk_slot.load(std::memory_order_acquire);
+        if (chunk == nullptr) {
+            Chunk* fresh_chunk = new Chunk();
+            if (chunk_slot.compare_exchange_strong(chunk, fresh_chunk, std::memory_order_acq_rel)) {
+                chunk = fresh_chunk;
+            }
+            else {
+                delete fresh_chunk;
+            }
+        }
+
+        std::atomic<const Value*>& value_slot = (*chunk)[static_cast<std::size_t>(id) % CHUNK_SIZE];
+        const Value* value = value_slot.load(std::memory_order_acquire);
+        if (value == nullptr) {
+            const Value* fresh_value = new Value(compute());
+            if (value_slot.compare_exchange_strong(value, fresh_value, std::memory_order_acq_rel)) {
+                value = fresh_value;
+            }
+            else {
+                delete fresh_value;
+            }
+        }
+        return value;
+    }
+
+private:
+    static constexpr std::size_t CHUNK_SIZE = 256;
+    static constexpr std::size_t CHUNK_COUNT = 4096;
+    using Chunk = std::array<std::atomic<const Value*>, CHUNK_SIZE>;
+
+    std::array<std::atomic<Chunk*>, CHUNK_COUNT> m_Chunks = {};
+};
+
+}
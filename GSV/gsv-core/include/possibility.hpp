@@ -1,10 +1,11 @@
 #pragma once
 
+#include <cstddef>
 #include <expected>
 #include <memory>
 #include <string>
-#include <unordered_map>
 
+#include "assignment.hpp"
 #include "referent_system.hpp"
 
 namespace iif_sadaf::talk::GSV {
@@ -15,26 +16,49 @@ namespace iif_sadaf::talk::GSV {
  * The `Possibility` class models possiblities in the GSV framework, 
  * which are defined as tuples of a referent system, an assignment if
  * individuals to pegs, and a possible world index.
+ *
+ * A possibility is a value: copies share their referent system, which is immutable, and
+ * own their assignment. `update()` replaces the referent system of the possibility it is
+ * called on with an extension, and never modifies the shared system, so updating a copy
+ * does not affect the possibilities it was copied from or their threads.
  */
 struct Possibility {
 public:
-    Possibility(std::shared_ptr<ReferentSystem> r_system, int world);
+    Possibility(std::shared_ptr<const ReferentSystem> r_system, int world);
     Possibility(const Possibility& other) = default;
     Possibility& operator=(const Possibility& other) = default;
     Possibility(Possibility&& other) noexcept;
     Possibility& operator=(Possibility&& other) noexcept;
 
     void update(std::string_view variable, int individual);
+    void update(SymbolId variable, int individual);
     
-    std::shared_ptr<ReferentSystem> referentSystem;
-    std::unordered_map<int, int> assignment;
+    std::shared_ptr<const ReferentSystem> referentSystem;
+    Assignment assignment;
     int world;
 };
 
 bool extends(const Possibility& p2, const Possibility& p1);
 bool operator<(const Possibility& p1, const Possibility& p2);
+bool operator==(const Possibility& p1, const Possibility& p2);
+std::size_t hashValue(const Possibility& p);
 std::expected<int, std::string> variableDenotation(std::string_view variable, const Possibility& p);
+std::expected<int, std::string> variableDenotation(SymbolId variable, const Possibility& p);
 
 std::string str(const Possibility& p);
 
+/**
+ * @brief The canonical order of possibilities (see `operator<`), with lookups by world.
+ *
+ * The order is transparent: a world is equivalent to every possibility at it, so the
+ * possibilities of a state at a world are `state.equal_range(world)`.
+ */
+struct PossibilityOrder {
+    using is_transparent = void;
+
+    bool operator()(const Possibility& p1, const Possibility& p2) const { return p1 < p2; }
+    bool operator()(const Possibility& p, int world) const { return p.world < world; }
+    bool operator()(int world, const Possibility& p) const { return world < p.world; }
+};
+
 }
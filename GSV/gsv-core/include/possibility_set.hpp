@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "information_state.hpp"
+#include "possibility.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief A flat hash set of possibilities, for constant-time membership tests.
+ *
+ * The set is an open-addressing table with linear probing, holding pointers to
+ * possibilities owned elsewhere, typically by an information state, together with their
+ * hashes (see `hashValue(const Possibility&)`). Possibilities are compared with
+ * `operator==` only when their hashes agree.
+ *
+ * The set does not own its possibilities: they must outlive it, and must not be modified
+ * while in it. It is not thread-safe for writing, but may be read by any number of
+ * threads at once.
+ */
+class PossibilitySet {
+public:
+    PossibilitySet() = default;
+    explicit PossibilitySet(std::size_t capacity);
+    explicit PossibilitySet(const InformationState& state);
+
+    std::size_t size() const;
+    bool empty() const;
+
+    bool insert(const Possibility& p);
+    bool contains(const Possibility& p) const;
+
+private:
+    struct Slot {
+        std::size_t hash = 0;
+        const Possibility* possibility = nullptr;
+    };
+
+    std::size_t position(const Possibility& p, std::size_t hash) const;
+    void grow();
+
+    std::vector<Slot> m_Slots;
+    std::size_t m_Size = 0;
+};
+
+}
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <cstddef>
 #include <expected>
+#include <memory>
 #include <set>
 #include <string>
 #include <string_view>
-#include <unordered_map>
+
+#include "symbol_table.hpp"
 
 namespace iif_sadaf::talk::GSV {
 
@@ -14,23 +17,43 @@ namespace iif_sadaf::talk::GSV {
  * The `ReferentSystem` class provides a framework for handling variable-to-integer 
  * mappings within GSV. It allows for retrieval of variable values and tracks the
  * number of pegs (or reference points) within the system.
+ *
+ * Variables are identified by their id in the global `SymbolTable`. The overloads
+ * taking a variable name look the id up first.
+ *
+ * Referent systems are persistent: a referent system is either empty, or the extension
+ * of a `parent` system with one `variable`, associated with the new peg `pegs`. Extending
+ * a system (see `extend()`) is therefore constant-time and shares the parent, which
+ * must not be modified afterwards. Variables bound again by an extension are shadowed by
+ * the newer binding. A hash of the variable-peg associations is kept in every system,
+ * so most comparisons between different systems are decided without walking them.
+ *
+ * Referent systems are immutable once constructed: all their members are const, and they
+ * are shared as `std::shared_ptr<const ReferentSystem>`. Any number of threads may
+ * therefore read, copy and extend the same referent system concurrently.
  */
 struct ReferentSystem {
 public:
     ReferentSystem() = default;
-    ReferentSystem(const ReferentSystem& other) = default;
-    ReferentSystem& operator=(const ReferentSystem& other) = default;
-    ReferentSystem(ReferentSystem&& other) noexcept;
-    ReferentSystem& operator=(ReferentSystem&& other) noexcept;
+    ReferentSystem(std::shared_ptr<const ReferentSystem> parent, SymbolId variable);
 
     std::expected<int, std::string> value(std::string_view variable) const;
+    std::expected<int, std::string> value(SymbolId variable) const;
 
-    int pegs = 0;
-    std::unordered_map<std::string_view, int> variablePegAssociation = {};
+    const int pegs = 0;
+    const std::shared_ptr<const ReferentSystem> parent = nullptr;
+    const SymbolId variable = -1;
+    const std::size_t associationHash = 0;
 };
 
+std::shared_ptr<const ReferentSystem> extend(std::shared_ptr<const ReferentSystem> r, SymbolId variable);
+bool isAncestorOf(const ReferentSystem& r1, const ReferentSystem& r2);
 std::set<std::string_view> domain(const ReferentSystem& r);
+std::set<SymbolId> variables(const ReferentSystem& r);
 bool extends(const ReferentSystem& r2, const ReferentSystem& r1);
+bool operator==(const ReferentSystem& r1, const ReferentSystem& r2);
+bool operator<(const ReferentSystem& r1, const ReferentSystem& r2);
+std::size_t hashValue(const ReferentSystem& r);
 std::string str(const ReferentSystem& r);
 
 }
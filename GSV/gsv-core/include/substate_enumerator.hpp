@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "information_state.hpp"
+#include "referent_system.hpp"
+#include "world_set.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief Lazily enumerates the variable-free information states with a given number of worlds.
+ *
+ * The states over worlds `0, ..., worlds - 1` that contain exactly `size` worlds are
+ * produced one at a time, in lexicographic order of their sorted worlds, which is the
+ * order the semantic relations have always scanned them in. Only the current state is
+ * kept: stepping to the next one updates it in place, inserting and removing the worlds
+ * that changed (an amortized constant number per step).
+ *
+ * Every state has a rank, its position in the enumeration. An enumerator can be started
+ * at any rank, so consecutive rank ranges can be enumerated independently (e.g. in parallel).
+ *
+ * The current state is available both as a `WorldSet` and as an `InformationState`. The
+ * latter is only brought up to date when `state()` is called.
+ */
+class SubstateEnumerator {
+public:
+    SubstateEnumerator(int worlds, int size, std::uint64_t rank = 0);
+
+    bool done() const;
+    void next();
+
+    std::uint64_t rank() const;
+    const WorldSet& worldSet() const;
+    const InformationState& state();
+
+private:
+    int m_Worlds;
+    std::uint64_t m_Rank;
+    bool m_Done;
+    std::vector<int> m_Combination;
+    WorldSet m_WorldSet;
+
+    InformationState m_State;
+    WorldSet m_StateWorlds;
+    std::shared_ptr<const ReferentSystem> m_ReferentSystem;
+};
+
+std::uint64_t binomial(int n, int k);
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "symbol_id.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief Interns names to dense integer ids.
+ *
+ * Ids are handed out in order of first appearance, starting at 0, and are never
+ * reused. Names are never removed, so the views returned by `name()` stay valid for the
+ * lifetime of the table; for the global table, for the lifetime of the program. This makes
+ * them safe to use as keys of long-lived structures, such as referent systems stored in
+ * caches, independently of the expressions the names were read from.
+ *
+ * All member functions are thread-safe.
+ */
+class SymbolTable {
+public:
+    static SymbolTable& global();
+
+    SymbolId intern(std::string_view name);
+    std::optional<SymbolId> find(std::string_view name) const;
+    std::string_view name(SymbolId id) const;
+    std::size_t size() const;
+
+private:
+    mutable std::shared_mutex m_Mutex;
+    std::deque<std::string> m_Names;
+    std::unordered_map<std::string_view, SymbolId> m_Ids;
+};
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "information_state.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief Dense representation of a variable-free information state.
+ *
+ * When no pegs are live, every possibility in an information state is fully
+ * determined by its world, so the state is just a subset of W. `WorldSet` stores
+ * that subset as a bitset with one bit per world, packed in 64-bit words. Models
+ * with up to 256 worlds are stored inline, without any heap allocation.
+ *
+ * All binary operations require both operands to range over the same number of worlds.
+ */
+class WorldSet {
+public:
+    WorldSet() = default;
+    explicit WorldSet(int worlds);
+
+    static WorldSet full(int worlds);
+
+    int worlds() const;
+    int size() const;
+    bool empty() const;
+    bool contains(int world) const;
+
+    void insert(int world);
+    void erase(int world);
+    void clear();
+
+    WorldSet& operator&=(const WorldSet& other);
+    WorldSet& operator|=(const WorldSet& other);
+    WorldSet& operator-=(const WorldSet& other);
+
+    /**
+     * @brief Calls `f(world)` for every world in the set, in ascending order.
+     */
+    template<typename F>
+    void forEach(F&& f) const
+    {
+        const std::uint64_t* words = data();
+        for (int i = 0; i < m_WordCount; ++i) {
+            std::uint64_t word = words[i];
+            while (word != 0) {
+                f(i * 64 + std::countr_zero(word));
+                word &= word - 1;
+            }
+        }
+    }
+
+    friend bool operator==(const WorldSet& s1, const WorldSet& s2);
+    friend bool isSubsetOf(const WorldSet& s1, const WorldSet& s2);
+
+private:
+    static constexpr int kInlineWords = 4;
+
+    std::uint64_t* data();
+    const std::uint64_t* data() const;
+
+    int m_Worlds = 0;
+    int m_WordCount = 0;
+    std::array<std::uint64_t, kInlineWords> m_Inline = {};
+    std::vector<std::uint64_t> m_Overflow = {};
+};
+
+WorldSet operator&(WorldSet s1, const WorldSet& s2);
+WorldSet operator|(WorldSet s1, const WorldSet& s2);
+WorldSet operator-(WorldSet s1, const WorldSet& s2);
+
+bool isVariableFree(const InformationState& state);
+WorldSet toWorldSet(const InformationState& state, int worlds);
+InformationState toInformationState(const WorldSet& state);
+
+std::string str(const WorldSet& state);
+
+}
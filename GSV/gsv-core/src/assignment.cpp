@@ -0,0 +1,152 @@
+#include "assignment.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace iif_sadaf::talk::GSV {
+
+Assignment::Assignment(const Assignment& other)
+    : m_Assigned(other.m_Assigned)
+{
+    reserve(other.m_Length);
+    std::copy_n(other.data(), other.m_Length, data());
+    m_Length = other.m_Length;
+}
+
+Assignment& Assignment::operator=(const Assignment& other)
+{
+    if (this != &other) {
+        reserve(other.m_Length);
+        std::copy_n(other.data(), other.m_Length, data());
+        m_Length = other.m_Length;
+        m_Assigned = other.m_Assigned;
+    }
+    return *this;
+}
+
+Assignment::Assignment(Assignment&& other) noexcept
+    : m_Length(other.m_Length)
+    , m_Assigned(other.m_Assigned)
+    , m_Capacity(other.m_Capacity)
+{
+    if (other.isInline()) {
+        std::copy_n(other.m_Inline, other.m_Length, m_Inline);
+    }
+    else {
+        m_Heap = other.m_Heap;
+        other.m_Capacity = INLINE_CAPACITY;
+    }
+    other.m_Length = 0;
+    other.m_Assigned = 0;
+}
+
+Assignment& Assignment::operator=(Assignment&& other) noexcept
+{
+    if (this != &other) {
+        if (!isInline()) {
+            delete[] m_Heap;
+        }
+        m_Length = other.m_Length;
+        m_Assigned = other.m_Assigned;
+        m_Capacity = other.m_Capacity;
+        if (other.isInline()) {
+            std::copy_n(other.m_Inline, other.m_Length, m_Inline);
+        }
+        else {
+            m_Heap = other.m_Heap;
+            other.m_Capacity = INLINE_CAPACITY;
+        }
+        other.m_Length = 0;
+        other.m_Assigned = 0;
+    }
+    return *this;
+}
+
+Assignment::~Assignment()
+{
+    if (!isInline()) {
+        delete[] m_Heap;
+    }
+}
+
+/**
+ * @brief Retrieves the individual assigned to a peg.
+ *
+ * @throws std::out_of_range If the peg is not assigned.
+ */
+int Assignment::at(int peg) const
+{
+    if (!contains(peg)) {
+        throw std::out_of_range("Assignment::at");
+    }
+    return data()[peg - 1];
+}
+
+/**
+ * @brief Assigns an individual to a peg, growing the assignment up to the peg if needed.
+ *
+ * @throws std::out_of_range If the peg is not positive.
+ */
+void Assignment::assign(int peg, int individual)
+{
+    if (peg < 1) {
+        throw std::out_of_range("Assignment::assign");
+    }
+
+    const std::uint32_t slot = static_cast<std::uint32_t>(peg) - 1;
+    if (slot >= m_Length) {
+        if (slot >= m_Capacity) {
+            reserve(std::max(slot + 1, 2 * m_Capacity));
+        }
+        std::fill(data() + m_Length, data() + slot, UNASSIGNED);
+        data()[slot] = UNASSIGNED;
+        m_Length = slot + 1;
+    }
+
+    if (data()[slot] == UNASSIGNED) {
+        ++m_Assigned;
+    }
+    data()[slot] = individual;
+}
+
+void Assignment::clear()
+{
+    m_Length = 0;
+    m_Assigned = 0;
+}
+
+/**
+ * @brief Ensures room for at least `capacity` slots, keeping the slots in use.
+ */
+void Assignment::reserve(std::uint32_t capacity)
+{
+    if (capacity <= m_Capacity) {
+        return;
+    }
+
+    int* heap = new int[capacity];
+    std::copy_n(data(), m_Length, heap);
+    if (!isInline()) {
+        delete[] m_Heap;
+    }
+    m_Heap = heap;
+    m_Capacity = capacity;
+}
+
+/**
+ * @brief Determines whether two assignments assign the same individuals to the same pegs.
+ */
+bool operator==(const Assignment& a1, const Assignment& a2)
+{
+    return std::ranges::equal(a1.slots(), a2.slots());
+}
+
+/**
+ * @brief Orders assignments lexicographically by their slots, consistently with `operator==`.
+ */
+bool operator<(const Assignment& a1, const Assignment& a2)
+{
+    return std::ranges::lexicographical_compare(a1.slots(), a2.slots());
+}
+
+}
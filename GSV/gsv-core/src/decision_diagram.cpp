@@ -0,0 +1,264 @@
+#include "decision_diagram.hpp"
+
+#include <algorithm>
+
+namespace iif_sadaf::talk::GSV {
+
+namespace {
+
+/**
+ * @brief Shifts a set of sizes, stored as a bitset, up by some amount.
+ */
+std::vector<std::uint64_t> shifted(const std::vector<std::uint64_t>& sizes, int amount)
+{
+    std::vector<std::uint64_t> output(sizes.size(), 0);
+    const int word_shift = amount / 64;
+    const int bit_shift = amount % 64;
+    for (int i = static_cast<int>(sizes.size()) - 1; i >= word_shift; --i) {
+        output[i] = sizes[i - word_shift] << bit_shift;
+        if (bit_shift != 0 && i - word_shift - 1 >= 0) {
+            output[i] |= sizes[i - word_shift - 1] >> (64 - bit_shift);
+        }
+    }
+    return output;
+}
+
+void unite(std::vector<std::uint64_t>& sizes, const std::vector<std::uint64_t>& other)
+{
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+        sizes[i] |= other[i];
+    }
+}
+
+/**
+ * @brief The sizes obtained by adding between 0 and `free_worlds` worlds to sets of the given sizes.
+ */
+std::vector<std::uint64_t> spread(std::vector<std::uint64_t> sizes, int free_worlds)
+{
+    // After every step, sizes + [0, covered] has been added
+    int covered = 0;
+    while (covered < free_worlds) {
+        const int step = std::min(covered + 1, free_worlds - covered);
+        unite(sizes, shifted(sizes, step));
+        covered += step;
+    }
+    return sizes;
+}
+
+bool contains(const std::vector<std::uint64_t>& sizes, int size)
+{
+    return (sizes[size / 64] >> (size % 64)) & 1;
+}
+
+} // ANONYMOUS NAMESPACE
+
+std::size_t DecisionDiagram::TripleHash::operator()(const Triple& triple) const
+{
+    std::uint64_t hash = (static_cast<std::uint64_t>(triple.x) << 32) ^ triple.y;
+    hash ^= static_cast<std::uint64_t>(triple.z) * 0x9e3779b97f4a7c15ULL;
+    hash ^= hash >> 29;
+    return static_cast<std::size_t>(hash * 0xbf58476d1ce4e5b9ULL);
+}
+
+/**
+ * @brief Creates a manager for the diagrams over a model with the given number of worlds.
+ *
+ * @param worlds The number of worlds in the base model.
+ */
+DecisionDiagram::DecisionDiagram(int worlds)
+    : m_Worlds(worlds)
+    , m_Decisions{ { worlds, ZERO, ZERO }, { worlds, ONE, ONE } }
+{ }
+
+int DecisionDiagram::worlds() const
+{
+    return m_Worlds;
+}
+
+/**
+ * @brief The number of nodes created so far, terminals included.
+ */
+std::size_t DecisionDiagram::nodeCount() const
+{
+    return m_Decisions.size();
+}
+
+/**
+ * @brief The family of the world sets containing a world.
+ */
+DecisionDiagram::Node DecisionDiagram::world(int world)
+{
+    return decision(world, ZERO, ONE);
+}
+
+/**
+ * @brief The family of the world sets not in `f`.
+ */
+DecisionDiagram::Node DecisionDiagram::negation(Node f)
+{
+    return ifThenElse(f, ZERO, ONE);
+}
+
+/**
+ * @brief The family of the world sets both in `f` and in `g`.
+ */
+DecisionDiagram::Node DecisionDiagram::conjunction(Node f, Node g)
+{
+    return ifThenElse(f, g, ZERO);
+}
+
+/**
+ * @brief The family of the world sets in `f` or in `g`.
+ */
+DecisionDiagram::Node DecisionDiagram::disjunction(Node f, Node g)
+{
+    return ifThenElse(f, ONE, g);
+}
+
+/**
+ * @brief The family of the world sets that are in `g` if they are in `f`, and in `h` otherwise.
+ *
+ * Every boolean operation reduces to this one. Results are memoized for the lifetime of
+ * the manager.
+ */
+DecisionDiagram::Node DecisionDiagram::ifThenElse(Node f, Node g, Node h)
+{
+    if (f == ONE || g == h) {
+        return g;
+    }
+    if (f == ZERO) {
+        return h;
+    }
+    if (g == ONE && h == ZERO) {
+        return f;
+    }
+
+    const Triple key{ f, g, h };
+    if (const auto it = m_Computed.find(key); it != m_Computed.end()) {
+        return it->second;
+    }
+
+    const int level = std::min({ m_Decisions[f].level, m_Decisions[g].level, m_Decisions[h].level });
+    const Node low = ifThenElse(cofactor(f, level, false), cofactor(g, level, false), cofactor(h, level, false));
+    const Node high = ifThenElse(cofactor(f, level, true), cofactor(g, level, true), cofactor(h, level, true));
+    const Node result = decision(level, low, high);
+    m_Computed.emplace(key, result);
+    return result;
+}
+
+/**
+ * @brief The sizes of the world sets in a family.
+ *
+ * @param f The family.
+ * @return Element `i`, for `i` from 0 to `worlds()`, is true iff `f` has a world set with `i` worlds.
+ */
+std::vector<bool> DecisionDiagram::cardinalities(Node f)
+{
+    const Counts sizes = spread(counts(f), m_Decisions[f].level);
+    std::vector<bool> output(m_Worlds + 1);
+    for (int i = 0; i <= m_Worlds; ++i) {
+        output[i] = contains(sizes, i);
+    }
+    return output;
+}
+
+/**
+ * @brief The first world set of a given size in a family, in the order of `SubstateEnumerator`.
+ *
+ * World sets of the same size are enumerated in lexicographic order of their sorted
+ * worlds, so the first one is found by including every world, in ascending order, unless
+ * no world set of the family of the given size extends the worlds chosen so far with it.
+ *
+ * @param f The family.
+ * @param size The number of worlds of the world set.
+ * @return The world set, or nullopt if `f` has none of that size.
+ */
+std::optional<WorldSet> DecisionDiagram::first(Node f, int size)
+{
+    if (size < 0 || size > m_Worlds || !reaches(f, 0, size)) {
+        return std::nullopt;
+    }
+
+    WorldSet output(m_Worlds);
+    Node node = f;
+    for (int world = 0; world < m_Worlds && size > 0; ++world) {
+        const Node high = cofactor(node, world, true);
+        if (reaches(high, world + 1, size - 1)) {
+            output.insert(world);
+            node = high;
+            --size;
+        }
+        else {
+            node = cofactor(node, world, false);
+        }
+    }
+    return output;
+}
+
+DecisionDiagram::Node DecisionDiagram::decision(int level, Node low, Node high)
+{
+    if (low == high) {
+        return low;
+    }
+    const Triple key{ static_cast<std::uint32_t>(level), low, high };
+    if (const auto it = m_Unique.find(key); it != m_Unique.end()) {
+        return it->second;
+    }
+    const Node node = static_cast<Node>(m_Decisions.size());
+    m_Decisions.push_back({ level, low, high });
+    m_Unique.emplace(key, node);
+    return node;
+}
+
+/**
+ * @brief The diagram `f` with the world `level` fixed. `f` must not decide on a lower world.
+ */
+DecisionDiagram::Node DecisionDiagram::cofactor(Node f, int level, bool value) const
+{
+    const Decision& node = m_Decisions[f];
+    if (node.level != level) {
+        return f;
+    }
+    return value ? node.high : node.low;
+}
+
+/**
+ * @brief The sizes of the world sets in a family, counting only the worlds from the level of its root up.
+ */
+const DecisionDiagram::Counts& DecisionDiagram::counts(Node f)
+{
+    if (const auto it = m_Counts.find(f); it != m_Counts.end()) {
+        return it->second;
+    }
+
+    Counts sizes(m_Worlds / 64 + 1, 0);
+    if (f == ONE) {
+        sizes[0] = 1;
+    }
+    else if (f != ZERO) {
+        const Decision& node = m_Decisions[f];
+        sizes = spread(counts(node.low), m_Decisions[node.low].level - node.level - 1);
+        unite(sizes, shifted(spread(counts(node.high), m_Decisions[node.high].level - node.level - 1), 1));
+    }
+    return m_Counts.emplace(f, std::move(sizes)).first->second;
+}
+
+/**
+ * @brief Whether `f` has a world set with exactly `size` worlds from `level` up. `f` must not decide on a lower world.
+ */
+bool DecisionDiagram::reaches(Node f, int level, int size)
+{
+    if (size < 0) {
+        return false;
+    }
+    const int free_worlds = m_Decisions[f].level - level;
+    const Counts& sizes = counts(f);
+    for (int i = std::max(size - free_worlds, 0); i <= size; ++i) {
+        if (i < static_cast<int>(sizes.size()) * 64 && contains(sizes, i)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
@@ -18,7 +18,7 @@ namespace iif_sadaf::talk::GSV {
  */
 InformationState create(const IModel& model)
 {
-    std::set<Possibility> possibilities;
+    InformationState possibilities;
 
     auto r_system = std::make_shared<ReferentSystem>();
 
@@ -43,23 +43,35 @@ InformationState create(const IModel& model)
  */
 InformationState update(const InformationState& input_state, std::string_view variable, int individual)
 {
-    InformationState output_state;
+    return update(input_state, SymbolTable::global().intern(variable), individual);
+}
+
+/**
+ * @brief Updates the information state with a new assignment of the variable with a given symbol id.
+ *
+ * See the overload taking a variable name.
+ *
+ * @param resource The memory resource of the new state, or nullptr for the resource of the input state.
+ */
+InformationState update(const InformationState& input_state, SymbolId variable, int individual, std::pmr::memory_resource* resource)
+{
+    InformationState output_state(resource != nullptr ? resource : input_state.get_allocator().resource());
 
-    auto r_star = std::make_shared<ReferentSystem>();
+    // Possibilities sharing a referent system share its extension
+    const ReferentSystem* r_system = nullptr;
+    std::shared_ptr<const ReferentSystem> r_star;
 
     for (const auto& p : input_state) {
-        Possibility p_star(r_star, p.world);
-        p_star.assignment = p.assignment;
-        r_star->pegs = p.referentSystem->pegs;
-        for (const auto& map : p.referentSystem->variablePegAssociation) {
-            const std::string_view var = map.first;
-            const int peg = map.second;
-            r_star->variablePegAssociation[var] = peg;
+        if (p.referentSystem.get() != r_system) {
+            r_system = p.referentSystem.get();
+            r_star = extend(p.referentSystem, variable);
         }
 
-        p_star.update(variable, individual);
+        Possibility p_star(r_star, p.world);
+        p_star.assignment = p.assignment;
+        p_star.assignment.assign(r_star->pegs, individual);
 
-        output_state.insert(p_star);
+        output_state.insert(output_state.end(), std::move(p_star));
     }
 
     return output_state;
@@ -77,15 +89,31 @@ InformationState update(const InformationState& input_state, std::string_view va
 bool extends(const InformationState& s2, const InformationState& s1)
 {
     const auto extends_possibility_in_s1 = [&](const Possibility& p2) -> bool {
-        const auto is_extended_by_p2 = [&](const Possibility& p1) -> bool {
-            return extends(p2, p1); 
-        };
-        return std::ranges::any_of(s1, is_extended_by_p2);
+        const auto extends_p2 = [&](const Possibility& p1) -> bool { return extends(p2, p1); };
+        return std::ranges::any_of(descendantCandidates(p2, s1), extends_p2);
     };
 
     return std::ranges::all_of(s2, extends_possibility_in_s1);
 }
 
+/**
+ * @brief The possibilities of an information state that may be descendants of a possibility.
+ *
+ * A possibility only extends possibilities at its own world, and the possibilities of an
+ * information state at a world are contiguous, so the candidates are the possibilities at
+ * the world of `p`, found in logarithmic time. The same range holds the possibilities of
+ * `s` that `p` may extend.
+ *
+ * @param p The potential ancestor possibility.
+ * @param s The information state in which descendants are looked for.
+ * @return The range of possibilities of `s` at the world of `p`.
+ */
+std::ranges::subrange<InformationState::const_iterator> descendantCandidates(const Possibility& p, const InformationState& s)
+{
+    const auto [first, last] = s.equal_range(p.world);
+    return { first, last };
+}
+
 /**
  * @brief Determines if one possibility is a descendant of another within an information state.
  *
@@ -112,8 +140,8 @@ bool isDescendantOf(const Possibility& p2, const Possibility& p1, const Informat
  */
 bool subsistsIn(const Possibility& p, const InformationState& s)
 {
-    const auto is_descendant_of_p_in_s = [&](const Possibility& p1) -> bool { return isDescendantOf(p1, p, s); };
-    return std::ranges::any_of(s, is_descendant_of_p_in_s);
+    const auto is_descendant_of_p = [&](const Possibility& p1) -> bool { return extends(p1, p); };
+    return std::ranges::any_of(descendantCandidates(p, s), is_descendant_of_p);
 }
 
 /**
@@ -127,8 +155,37 @@ bool subsistsIn(const Possibility& p, const InformationState& s)
  */
 bool subsistsIn(const InformationState& s1, const InformationState& s2)
 {
-    const auto subsists_in_s2 = [&](const Possibility& p) -> bool { return subsistsIn(p, s2); };
-    return std::ranges::all_of(s1, subsists_in_s2);
+    // Both states are ordered by world, so their worlds are matched in a single merge
+    // pass, and every possibility of s1 is only checked against those of s2 at its world
+    auto first = s2.begin();
+    for (const Possibility& p : s1) {
+        while (first != s2.end() && first->world < p.world) {
+            ++first;
+        }
+        bool subsists = false;
+        for (auto it2 = first; it2 != s2.end() && it2->world == p.world && !subsists; ++it2) {
+            subsists = extends(*it2, p);
+        }
+        if (!subsists) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Computes a hash of an information state, consistent with `operator==`.
+ *
+ * Two states compare equal (and hash equally) when they contain identical possibilities,
+ * as defined by `operator==` on possibilities.
+ */
+std::size_t hashValue(const InformationState& state)
+{
+    std::size_t seed = state.size();
+    for (const Possibility& p : state) {
+        seed ^= hashValue(p) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    }
+    return seed;
 }
 
 std::string str(const InformationState& state, bool label, const std::string& indent_str)
@@ -2,11 +2,12 @@
 
 #include <algorithm>
 #include <format>
+#include <span>
 
 namespace iif_sadaf::talk::GSV {
 
-Possibility::Possibility(std::shared_ptr<ReferentSystem> r_system, int world)
-    : referentSystem(r_system)
+Possibility::Possibility(std::shared_ptr<const ReferentSystem> r_system, int world)
+    : referentSystem(std::move(r_system))
     , assignment({})
     , world(world)
 { }
@@ -21,8 +22,7 @@ Possibility& Possibility::operator=(Possibility&& other) noexcept
 {
     if (this != &other) {
         this->referentSystem = std::move(other.referentSystem);
-        this->assignment.clear();
-        this->assignment.swap(other.assignment);
+        this->assignment = std::move(other.assignment);
         this->world = other.world;
     }
     return *this;
@@ -31,7 +31,8 @@ Possibility& Possibility::operator=(Possibility&& other) noexcept
 /**
 * @brief Updates the assignment of a variable to an individual.
 *
-* The variable is first added to or updated in the associated referent system.
+* The referent system is first replaced by its extension with the variable,
+* which leaves other possibilities sharing the old referent system untouched.
 * Then, the assignment is modified to map the peg of the variable to the new individual.
 *
 * @param variable The variable to update.
@@ -39,8 +40,16 @@ Possibility& Possibility::operator=(Possibility&& other) noexcept
 */
 void Possibility::update(std::string_view variable, int individual)
 {
-    referentSystem->variablePegAssociation[variable] = ++(referentSystem->pegs);
-    assignment[referentSystem->pegs] = individual;
+    update(SymbolTable::global().intern(variable), individual);
+}
+
+/**
+* @brief Updates the assignment of the variable with a given symbol id to an individual.
+*/
+void Possibility::update(SymbolId variable, int individual)
+{
+    referentSystem = extend(std::move(referentSystem), variable);
+    assignment.assign(referentSystem->pegs, individual);
 }
 
 /*
@@ -60,18 +69,38 @@ void Possibility::update(std::string_view variable, int individual)
  */
 bool extends(const Possibility& p2, const Possibility& p1)
 {
-    const auto peg_is_new_or_maintains_assignment = [&](const std::pair<int, int>& map) -> bool {
-        const int peg = map.first;
-
-        return !p1.assignment.contains(peg) || (p1.assignment.at(peg) == p2.assignment.at(peg));
-    };
+    if (p1.world != p2.world) {
+        return false;
+    }
 
-    return (p1.world == p2.world) && std::ranges::all_of(p2.assignment, peg_is_new_or_maintains_assignment);
+    const std::span<const int> slots1 = p1.assignment.slots();
+    const std::span<const int> slots2 = p2.assignment.slots();
+    const std::size_t shared_slots = std::min(slots1.size(), slots2.size());
+    for (std::size_t i = 0; i < shared_slots; ++i) {
+        if (slots1[i] != slots2[i] && slots1[i] != Assignment::UNASSIGNED && slots2[i] != Assignment::UNASSIGNED) {
+            return false;
+        }
+    }
+    return true;
 }
 
+/**
+ * @brief A total order on possibilities, consistent with `operator==`.
+ *
+ * Possibilities are ordered by world, then by assignment, then by referent system, so
+ * the possibilities at a world are contiguous in a state, and two possibilities are
+ * equivalent iff they are identical. Possibilities sharing their referent system, as
+ * most possibilities of a state do, are ordered without comparing it.
+ */
 bool operator<(const Possibility& p1, const Possibility& p2)
 {
-    return p1.world < p2.world;
+    if (p1.world != p2.world) {
+        return p1.world < p2.world;
+    }
+    if (!(p1.assignment == p2.assignment)) {
+        return p1.assignment < p2.assignment;
+    }
+    return p1.referentSystem != p2.referentSystem && *p1.referentSystem < *p2.referentSystem;
 }
 
 /**
@@ -102,6 +131,50 @@ std::expected<int, std::string> variableDenotation(std::string_view variable, co
     return p.assignment.at(peg.value());
 }
 
+/**
+ * @brief Retrieves the denotation of the variable with a given symbol id within a given Possibility.
+ *
+ * See the overload taking a variable name.
+ */
+std::expected<int, std::string> variableDenotation(SymbolId variable, const Possibility& p)
+{
+    const auto peg = p.referentSystem->value(variable);
+
+    if (!peg.has_value()) {
+        return std::unexpected(peg.error());
+    }
+
+    return p.assignment.at(peg.value());
+}
+
+/**
+ * @brief Determines whether two possibilities are identical.
+ *
+ * This compares the world, the assignment and the contents of the referent system.
+ */
+bool operator==(const Possibility& p1, const Possibility& p2)
+{
+    if (p1.world != p2.world || p1.assignment != p2.assignment) {
+        return false;
+    }
+    return p1.referentSystem == p2.referentSystem || *p1.referentSystem == *p2.referentSystem;
+}
+
+/**
+ * @brief Computes a hash of a possibility, consistent with `operator==`.
+ */
+std::size_t hashValue(const Possibility& p)
+{
+    std::size_t assignment = 0;
+    const std::span<const int> slots = p.assignment.slots();
+    for (std::size_t i = 0; i < slots.size(); ++i) {
+        if (slots[i] != Assignment::UNASSIGNED) {
+            assignment += (static_cast<std::size_t>(i + 1) * 0x9e3779b97f4a7c15ULL) ^ static_cast<std::size_t>(slots[i]);
+        }
+    }
+    return hashValue(*p.referentSystem) ^ (assignment * 0xff51afd7ed558ccdULL) ^ static_cast<std::size_t>(p.world);
+}
+
 std::string str(const Possibility& p)
 {
     std::string assignment_contents;
@@ -110,8 +183,12 @@ std::string str(const Possibility& p)
         assignment_contents = "{ }";
     }
     else {
-        for (const auto& [peg, individual] : p.assignment) {
-            assignment_contents += std::format("peg{} -> e{}, ", std::to_string(peg), std::to_string(individual));
+        // Latest pegs first
+        const std::span<const int> slots = p.assignment.slots();
+        for (std::size_t peg = slots.size(); peg > 0; --peg) {
+            if (slots[peg - 1] != Assignment::UNASSIGNED) {
+                assignment_contents += std::format("peg{} -> e{}, ", std::to_string(peg), std::to_string(slots[peg - 1]));
+            }
         }
         assignment_contents.resize(assignment_contents.size() - 2);
         assignment_contents = std::format("{{ {} }}", assignment_contents);
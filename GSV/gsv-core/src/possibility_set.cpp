@@ -0,0 +1,111 @@
+#include "possibility_set.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+namespace iif_sadaf::talk::GSV {
+
+namespace {
+
+/**
+ * @brief The number of slots of a table holding `size` possibilities at a load factor of at most 1/2.
+ */
+std::size_t slotsFor(std::size_t size)
+{
+    return std::bit_ceil(std::max<std::size_t>(2 * size, 8));
+}
+
+} // ANONYMOUS NAMESPACE
+
+/**
+ * @brief Creates an empty set with room for `capacity` possibilities before growing.
+ */
+PossibilitySet::PossibilitySet(std::size_t capacity)
+    : m_Slots(slotsFor(capacity))
+{ }
+
+/**
+ * @brief Creates the set of the possibilities of an information state.
+ *
+ * The state must outlive the set, and must not be modified while the set is in use.
+ */
+PossibilitySet::PossibilitySet(const InformationState& state)
+    : PossibilitySet(state.size())
+{
+    for (const Possibility& p : state) {
+        insert(p);
+    }
+}
+
+std::size_t PossibilitySet::size() const
+{
+    return m_Size;
+}
+
+bool PossibilitySet::empty() const
+{
+    return m_Size == 0;
+}
+
+/**
+ * @brief Adds a possibility to the set, unless an identical one is already in it.
+ *
+ * @return True if the possibility was added.
+ */
+bool PossibilitySet::insert(const Possibility& p)
+{
+    if (2 * (m_Size + 1) > m_Slots.size()) {
+        grow();
+    }
+    const std::size_t hash = hashValue(p);
+    Slot& slot = m_Slots[position(p, hash)];
+    if (slot.possibility != nullptr) {
+        return false;
+    }
+    slot = { hash, &p };
+    ++m_Size;
+    return true;
+}
+
+/**
+ * @brief Determines whether the set holds a possibility identical to `p`.
+ */
+bool PossibilitySet::contains(const Possibility& p) const
+{
+    if (m_Size == 0) {
+        return false;
+    }
+    return m_Slots[position(p, hashValue(p))].possibility != nullptr;
+}
+
+/**
+ * @brief The slot holding a possibility identical to `p`, or the empty slot where it would be inserted.
+ */
+std::size_t PossibilitySet::position(const Possibility& p, std::size_t hash) const
+{
+    const std::size_t mask = m_Slots.size() - 1;
+    // The hash of a possibility mixes its world into its lowest bits, so the slot is
+    // taken from the highest bits of a further multiplicative mix
+    std::size_t i = static_cast<std::size_t>((hash * 0x9e3779b97f4a7c15ULL) >> 32) & mask;
+    while (m_Slots[i].possibility != nullptr) {
+        if (m_Slots[i].hash == hash && *m_Slots[i].possibility == p) {
+            return i;
+        }
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+void PossibilitySet::grow()
+{
+    std::vector<Slot> slots(slotsFor(m_Size + 1));
+    std::swap(m_Slots, slots);
+    for (const Slot& slot : slots) {
+        if (slot.possibility != nullptr) {
+            m_Slots[position(*slot.possibility, slot.hash)] = slot;
+        }
+    }
+}
+
+}
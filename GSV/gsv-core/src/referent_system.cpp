@@ -2,10 +2,98 @@
 
 #include <algorithm>
 #include <format>
+#include <functional>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace iif_sadaf::talk::GSV {
 
+namespace {
+
+std::size_t associationTerm(SymbolId variable, int peg)
+{
+    return std::hash<SymbolId>()(variable) * 0x9e3779b97f4a7c15ULL + static_cast<std::size_t>(peg);
+}
+
+/**
+ * @brief The association hash of the extension of `parent` with `variable`, associated with `peg`.
+ */
+std::size_t extendedAssociationHash(const ReferentSystem* parent, SymbolId variable, int peg)
+{
+    std::size_t hash = 0;
+    if (parent != nullptr) {
+        hash = parent->associationHash;
+        const auto shadowed_peg = parent->value(variable);
+        if (shadowed_peg.has_value()) {
+            hash -= associationTerm(variable, shadowed_peg.value());
+        }
+    }
+    return hash + associationTerm(variable, peg);
+}
+
+/**
+ * @brief The variable-peg associations of a referent system, latest peg first, without shadowed bindings.
+ */
+std::vector<std::pair<SymbolId, int>> associations(const ReferentSystem& r)
+{
+    std::vector<std::pair<SymbolId, int>> associations;
+    for (const ReferentSystem* node = &r; node != nullptr && node->pegs > 0; node = node->parent.get()) {
+        const auto is_node_variable = [&](const std::pair<SymbolId, int>& association) { return association.first == node->variable; };
+        if (std::ranges::none_of(associations, is_node_variable)) {
+            associations.emplace_back(node->variable, node->pegs);
+        }
+    }
+    return associations;
+}
+
+} // ANONYMOUS NAMESPACE
+
+/**
+ * @brief Constructs the extension of a referent system with a variable, associated with a new peg.
+ *
+ * @param parent The referent system being extended. A null parent stands for the empty system.
+ * @param variable The symbol id of the new variable.
+ */
+ReferentSystem::ReferentSystem(std::shared_ptr<const ReferentSystem> parent, SymbolId variable)
+    : pegs(parent != nullptr ? parent->pegs + 1 : 1)
+    , parent(std::move(parent))
+    , variable(variable)
+    , associationHash(extendedAssociationHash(this->parent.get(), variable, pegs))
+{ }
+
+/**
+ * @brief Extends a referent system with a variable, associated with a new peg.
+ *
+ * The extension shares `r`, so this is a constant-time operation.
+ *
+ * @param r The referent system being extended.
+ * @param variable The symbol id of the new variable.
+ * @return The extended referent system.
+ */
+std::shared_ptr<const ReferentSystem> extend(std::shared_ptr<const ReferentSystem> r, SymbolId variable)
+{
+    return std::make_shared<const ReferentSystem>(std::move(r), variable);
+}
+
+/**
+ * @brief Determines whether `r2` was obtained from `r1` by zero or more extensions.
+ *
+ * Systems are compared by identity, except for empty systems, which are ancestors of every system.
+ */
+bool isAncestorOf(const ReferentSystem& r1, const ReferentSystem& r2)
+{
+    if (r1.pegs == 0) {
+        return true;
+    }
+    for (const ReferentSystem* node = &r2; node != nullptr && node->pegs >= r1.pegs; node = node->parent.get()) {
+        if (node == &r1) {
+            return true;
+        }
+    }
+    return false;
+}
+
 /**
  * @brief Retrieves the set of variables in the referent system.
  * 
@@ -18,26 +106,26 @@ namespace iif_sadaf::talk::GSV {
 std::set<std::string_view> domain(const ReferentSystem& r)
 {
     std::set<std::string_view> domain;
-    for (const auto& [variable, peg] : r.variablePegAssociation) {
-        domain.insert(variable);
+    for (const ReferentSystem* node = &r; node != nullptr && node->pegs > 0; node = node->parent.get()) {
+        domain.insert(SymbolTable::global().name(node->variable));
     }
 
     return domain;
 }
 
-ReferentSystem::ReferentSystem(ReferentSystem&& other) noexcept
-    : pegs(other.pegs)
-    , variablePegAssociation(std::move(other.variablePegAssociation))
-{ }
-
-ReferentSystem& ReferentSystem::operator=(ReferentSystem&& other) noexcept
+/**
+ * @brief Retrieves the ids of the variables in the referent system.
+ *
+ * Same as `domain()`, with the variables identified by their symbol ids.
+ */
+std::set<SymbolId> variables(const ReferentSystem& r)
 {
-    if (this != &other) {
-        this->pegs = other.pegs;
-        this->variablePegAssociation = std::move(other.variablePegAssociation);
-        other.pegs = 0;
+    std::set<SymbolId> variables;
+    for (const ReferentSystem* node = &r; node != nullptr && node->pegs > 0; node = node->parent.get()) {
+        variables.insert(node->variable);
     }
-    return *this;
+
+    return variables;
 }
 
 /**
@@ -53,11 +141,32 @@ ReferentSystem& ReferentSystem::operator=(ReferentSystem&& other) noexcept
  */
 std::expected<int, std::string> ReferentSystem::value(std::string_view variable) const
 {
-    if (!variablePegAssociation.contains(variable)) {
+    const auto id = SymbolTable::global().find(variable);
+    if (!id.has_value()) {
         return std::unexpected(std::format("Referent system does not contain variable {}", std::string(variable)));
     }
 
-    return variablePegAssociation.at(variable);
+    return value(id.value());
+}
+
+/**
+ * @brief Retrieves the referent value associated with the variable of a given id.
+ *
+ * The bindings are searched from the latest one, so shadowed bindings are never returned.
+ *
+ * @param variable The symbol id of the variable whose referent value is being queried.
+ * @return std::expected<int, std::string> The value associated with the variable,
+ *         or an error message if the variable does not exist.
+ */
+std::expected<int, std::string> ReferentSystem::value(SymbolId variable) const
+{
+    for (const ReferentSystem* node = this; node != nullptr && node->pegs > 0; node = node->parent.get()) {
+        if (node->variable == variable) {
+            return node->pegs;
+        }
+    }
+
+    return std::unexpected(std::format("Referent system does not contain variable {}", std::string(SymbolTable::global().name(variable))));
 }
 
 /**
@@ -81,14 +190,19 @@ bool extends(const ReferentSystem& r2, const ReferentSystem& r1)
         return false;
     }
 
-    std::set<std::string_view> domain_r1 = domain(r1);
-    std::set<std::string_view> domain_r2 = domain(r2);
+    // Extensions keep the old bindings, and bind new or shadowed variables to new pegs
+    if (isAncestorOf(r1, r2)) {
+        return true;
+    }
+
+    std::set<SymbolId> domain_r1 = variables(r1);
+    std::set<SymbolId> domain_r2 = variables(r2);
 
     if (!std::ranges::includes(domain_r2, domain_r1)) {
         return false;
     }
 
-    const auto old_var_same_or_new_peg = [&](std::string_view variable) -> bool {
+    const auto old_var_same_or_new_peg = [&](SymbolId variable) -> bool {
         return r1.value(variable).value() == r2.value(variable).value() || r1.pegs <= r2.value(variable).value();
     };
 
@@ -96,23 +210,81 @@ bool extends(const ReferentSystem& r2, const ReferentSystem& r1)
         return false;
     }
 
-    const auto new_var_new_peg = [&](std::string_view variable) -> bool {
+    const auto new_var_new_peg = [&](SymbolId variable) -> bool {
         return domain_r1.contains(variable) || r1.pegs <= r2.value(variable).value();
     };
 
     return std::ranges::all_of(domain_r2, new_var_new_peg);
 }
 
+/**
+ * @brief Determines whether two referent systems are identical.
+ *
+ * @return True if both have the same number of pegs and associate the same variables with the same pegs.
+ */
+bool operator==(const ReferentSystem& r1, const ReferentSystem& r2)
+{
+    if (&r1 == &r2) {
+        return true;
+    }
+    if (r1.pegs != r2.pegs || r1.associationHash != r2.associationHash) {
+        return false;
+    }
+
+    auto associations1 = associations(r1);
+    auto associations2 = associations(r2);
+    std::ranges::sort(associations1);
+    std::ranges::sort(associations2);
+    return associations1 == associations2;
+}
+
+/**
+ * @brief A total order on referent systems, consistent with `operator==`.
+ *
+ * Systems are ordered by their number of pegs, then by their association hash, and only
+ * systems agreeing on both are ordered by their sorted variable-peg associations.
+ */
+bool operator<(const ReferentSystem& r1, const ReferentSystem& r2)
+{
+    if (&r1 == &r2) {
+        return false;
+    }
+    if (r1.pegs != r2.pegs) {
+        return r1.pegs < r2.pegs;
+    }
+    if (r1.associationHash != r2.associationHash) {
+        return r1.associationHash < r2.associationHash;
+    }
+
+    auto associations1 = associations(r1);
+    auto associations2 = associations(r2);
+    std::ranges::sort(associations1);
+    std::ranges::sort(associations2);
+    return associations1 < associations2;
+}
+
+/**
+ * @brief Computes a hash of a referent system, consistent with `operator==`.
+ *
+ * The variable-peg associations are combined in an order-independent way, since
+ * different histories of extensions can lead to the same associations. The combination
+ * is maintained by every extension, so this is a constant-time operation.
+ */
+std::size_t hashValue(const ReferentSystem& r)
+{
+    return r.associationHash ^ (static_cast<std::size_t>(r.pegs) * 0xc2b2ae3d27d4eb4fULL);
+}
+
 std::string str(const ReferentSystem& r)
 {
-    if (r.variablePegAssociation.empty()) {
+    if (r.pegs == 0) {
         return "{ }";
     }
 
     std::string vp_association;
 
-    for (const auto& [variable, peg] : r.variablePegAssociation) {
-        vp_association += std::format("{} -> peg{}, ", std::string(variable), std::to_string(peg));
+    for (const auto& [variable, peg] : associations(r)) {
+        vp_association += std::format("{} -> peg{}, ", std::string(SymbolTable::global().name(variable)), std::to_string(peg));
     }
 
     vp_association.resize(vp_association.size() - 2);
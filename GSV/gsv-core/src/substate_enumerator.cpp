@@ -0,0 +1,153 @@
+#include "substate_enumerator.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief Creates an enumerator positioned at the state with the given rank.
+ *
+ * @param worlds The number of worlds of the model.
+ * @param size The number of worlds in every enumerated state.
+ * @param rank The position of the first state to produce. If it is past the last state,
+ *        the enumerator starts out done. If the number of states does not fit in 64 bits
+ *        (see `binomial()`), only rank 0 is supported.
+ */
+SubstateEnumerator::SubstateEnumerator(int worlds, int size, std::uint64_t rank)
+    : m_Worlds(worlds)
+    , m_Rank(rank)
+    , m_Done(size < 0 || size > worlds || rank >= binomial(worlds, size))
+    , m_WorldSet(worlds)
+    , m_StateWorlds(worlds)
+    , m_ReferentSystem(std::make_shared<ReferentSystem>())
+{
+    if (m_Done) {
+        return;
+    }
+
+    m_Combination.reserve(size);
+    if (rank == 0) {
+        for (int world = 0; world < size; ++world) {
+            m_Combination.push_back(world);
+            m_WorldSet.insert(world);
+        }
+        return;
+    }
+
+    // Lexicographic rank r of c_0 < ... < c_{k-1} satisfies
+    // C(n, k) - 1 - r = sum_i C(n - 1 - c_i, k - i), which is decoded greedily.
+    std::uint64_t remainder = binomial(worlds, size) - 1 - rank;
+    int bound = worlds - 1;
+    for (int i = 0; i < size; ++i) {
+        const int k = size - i;
+        int d = bound;
+        while (binomial(d, k) > remainder) {
+            --d;
+        }
+        remainder -= binomial(d, k);
+        m_Combination.push_back(worlds - 1 - d);
+        m_WorldSet.insert(worlds - 1 - d);
+        bound = d - 1;
+    }
+}
+
+bool SubstateEnumerator::done() const
+{
+    return m_Done;
+}
+
+/**
+ * @brief Advances to the next state in lexicographic order.
+ *
+ * Only the trailing worlds that change are removed from and inserted into the current state.
+ */
+void SubstateEnumerator::next()
+{
+    if (m_Done) {
+        return;
+    }
+
+    const int size = static_cast<int>(m_Combination.size());
+    int i = size - 1;
+    while (i >= 0 && m_Combination[i] == m_Worlds - size + i) {
+        --i;
+    }
+    if (i < 0) {
+        m_Done = true;
+        return;
+    }
+
+    for (int j = i; j < size; ++j) {
+        m_WorldSet.erase(m_Combination[j]);
+    }
+    ++m_Combination[i];
+    for (int j = i + 1; j < size; ++j) {
+        m_Combination[j] = m_Combination[j - 1] + 1;
+    }
+    for (int j = i; j < size; ++j) {
+        m_WorldSet.insert(m_Combination[j]);
+    }
+    ++m_Rank;
+}
+
+std::uint64_t SubstateEnumerator::rank() const
+{
+    return m_Rank;
+}
+
+const WorldSet& SubstateEnumerator::worldSet() const
+{
+    return m_WorldSet;
+}
+
+/**
+ * @brief Returns the current state as a variable-free information state.
+ *
+ * The information state is kept between calls and only the worlds that changed since
+ * the previous call are inserted or erased. All its possibilities share one empty
+ * referent system.
+ */
+const InformationState& SubstateEnumerator::state()
+{
+    (m_StateWorlds - m_WorldSet).forEach([&](int world) {
+        m_State.erase(Possibility(m_ReferentSystem, world));
+    });
+    (m_WorldSet - m_StateWorlds).forEach([&](int world) {
+        m_State.emplace(m_ReferentSystem, world);
+    });
+    m_StateWorlds = m_WorldSet;
+    return m_State;
+}
+
+/**
+ * @brief Computes the binomial coefficient C(n, k), saturating at the largest std::uint64_t.
+ *
+ * @return C(n, k), 0 if k < 0 or k > n, and `std::numeric_limits<std::uint64_t>::max()`
+ *         if the coefficient does not fit in 64 bits.
+ */
+std::uint64_t binomial(int n, int k)
+{
+    if (k < 0 || n < 0 || k > n) {
+        return 0;
+    }
+    k = std::min(k, n - k);
+
+    constexpr std::uint64_t saturated = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t result = 1;
+    for (int i = 1; i <= k; ++i) {
+        // result * (n - k + i) / i is exact; cancel the divisor first to delay overflow
+        std::uint64_t factor = static_cast<std::uint64_t>(n - k + i);
+        const std::uint64_t gcd = std::gcd(result, static_cast<std::uint64_t>(i));
+        result /= gcd;
+        factor /= static_cast<std::uint64_t>(i) / gcd;
+        if (result > saturated / factor) {
+            return saturated;
+        }
+        result *= factor;
+    }
+    return result;
+}
+
+}
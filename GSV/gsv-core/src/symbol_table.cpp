@@ -0,0 +1,72 @@
+#include "symbol_table.hpp"
+
+#include <mutex>
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief Returns the table shared by the whole library.
+ */
+SymbolTable& SymbolTable::global()
+{
+    static SymbolTable table;
+    return table;
+}
+
+/**
+ * @brief Returns the id of a name, assigning the next free id if the name is new.
+ */
+SymbolId SymbolTable::intern(std::string_view name)
+{
+    {
+        std::shared_lock lock(m_Mutex);
+        const auto it = m_Ids.find(name);
+        if (it != m_Ids.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock lock(m_Mutex);
+    const auto it = m_Ids.find(name);
+    if (it != m_Ids.end()) {
+        return it->second;
+    }
+
+    // std::deque never relocates its elements, so the key views stay valid
+    const SymbolId id = static_cast<SymbolId>(m_Names.size());
+    m_Names.emplace_back(name);
+    m_Ids.emplace(m_Names.back(), id);
+    return id;
+}
+
+/**
+ * @brief Returns the id of a name, or nullopt if it was never interned.
+ */
+std::optional<SymbolId> SymbolTable::find(std::string_view name) const
+{
+    std::shared_lock lock(m_Mutex);
+    const auto it = m_Ids.find(name);
+    if (it == m_Ids.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+/**
+ * @brief Returns the name of an id returned by `intern()`.
+ *
+ * The view is valid for the lifetime of the table.
+ */
+std::string_view SymbolTable::name(SymbolId id) const
+{
+    std::shared_lock lock(m_Mutex);
+    return m_Names.at(static_cast<std::size_t>(id));
+}
+
+std::size_t SymbolTable::size() const
+{
+    std::shared_lock lock(m_Mutex);
+    return m_Names.size();
+}
+
+}
@@ -0,0 +1,227 @@
+#include "world_set.hpp"
+
+#include <algorithm>
+#include <format>
+#include <memory>
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief Creates an empty world set over a model with the given number of worlds.
+ *
+ * @param worlds The number of worlds in the base model.
+ */
+WorldSet::WorldSet(int worlds)
+    : m_Worlds(worlds)
+    , m_WordCount((worlds + 63) / 64)
+{
+    if (m_WordCount > kInlineWords) {
+        m_Overflow.assign(m_WordCount, 0);
+    }
+}
+
+/**
+ * @brief Creates the world set containing every world of the base model.
+ *
+ * This is the dense counterpart of `create()`.
+ *
+ * @param worlds The number of worlds in the base model.
+ * @return A world set containing worlds 0 to `worlds - 1`.
+ */
+WorldSet WorldSet::full(int worlds)
+{
+    WorldSet state(worlds);
+    std::uint64_t* words = state.data();
+    std::fill(words, words + state.m_WordCount, ~std::uint64_t{0});
+    if (worlds % 64 != 0) {
+        words[state.m_WordCount - 1] = (std::uint64_t{1} << (worlds % 64)) - 1;
+    }
+    return state;
+}
+
+std::uint64_t* WorldSet::data()
+{
+    return m_Overflow.empty() ? m_Inline.data() : m_Overflow.data();
+}
+
+const std::uint64_t* WorldSet::data() const
+{
+    return m_Overflow.empty() ? m_Inline.data() : m_Overflow.data();
+}
+
+int WorldSet::worlds() const
+{
+    return m_Worlds;
+}
+
+int WorldSet::size() const
+{
+    const std::uint64_t* words = data();
+    int count = 0;
+    for (int i = 0; i < m_WordCount; ++i) {
+        count += std::popcount(words[i]);
+    }
+    return count;
+}
+
+bool WorldSet::empty() const
+{
+    const std::uint64_t* words = data();
+    return std::all_of(words, words + m_WordCount, [](std::uint64_t word) { return word == 0; });
+}
+
+bool WorldSet::contains(int world) const
+{
+    return (data()[world / 64] >> (world % 64)) & 1;
+}
+
+void WorldSet::insert(int world)
+{
+    data()[world / 64] |= std::uint64_t{1} << (world % 64);
+}
+
+void WorldSet::erase(int world)
+{
+    data()[world / 64] &= ~(std::uint64_t{1} << (world % 64));
+}
+
+void WorldSet::clear()
+{
+    std::uint64_t* words = data();
+    std::fill(words, words + m_WordCount, 0);
+}
+
+WorldSet& WorldSet::operator&=(const WorldSet& other)
+{
+    std::uint64_t* words = data();
+    const std::uint64_t* other_words = other.data();
+    for (int i = 0; i < m_WordCount; ++i) {
+        words[i] &= other_words[i];
+    }
+    return *this;
+}
+
+WorldSet& WorldSet::operator|=(const WorldSet& other)
+{
+    std::uint64_t* words = data();
+    const std::uint64_t* other_words = other.data();
+    for (int i = 0; i < m_WordCount; ++i) {
+        words[i] |= other_words[i];
+    }
+    return *this;
+}
+
+WorldSet& WorldSet::operator-=(const WorldSet& other)
+{
+    std::uint64_t* words = data();
+    const std::uint64_t* other_words = other.data();
+    for (int i = 0; i < m_WordCount; ++i) {
+        words[i] &= ~other_words[i];
+    }
+    return *this;
+}
+
+bool operator==(const WorldSet& s1, const WorldSet& s2)
+{
+    return s1.m_Worlds == s2.m_Worlds && std::equal(s1.data(), s1.data() + s1.m_WordCount, s2.data());
+}
+
+/**
+ * @brief Determines whether every world in `s1` is also in `s2`.
+ *
+ * @param s1 The potential subset.
+ * @param s2 The potential superset.
+ * @return True if s1 is a subset of s2, false otherwise.
+ */
+bool isSubsetOf(const WorldSet& s1, const WorldSet& s2)
+{
+    const std::uint64_t* words_1 = s1.data();
+    const std::uint64_t* words_2 = s2.data();
+    for (int i = 0; i < s1.m_WordCount; ++i) {
+        if ((words_1[i] & ~words_2[i]) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+WorldSet operator&(WorldSet s1, const WorldSet& s2)
+{
+    return s1 &= s2;
+}
+
+WorldSet operator|(WorldSet s1, const WorldSet& s2)
+{
+    return s1 |= s2;
+}
+
+WorldSet operator-(WorldSet s1, const WorldSet& s2)
+{
+    return s1 -= s2;
+}
+
+/**
+ * @brief Determines whether an information state has no live pegs.
+ *
+ * A state is variable-free if none of its possibilities assigns an individual to a peg.
+ * Such a state is fully characterized by the set of worlds of its possibilities.
+ *
+ * @param state The information state to inspect.
+ * @return True if no possibility in the state has a non-empty assignment, false otherwise.
+ */
+bool isVariableFree(const InformationState& state)
+{
+    return std::ranges::all_of(state, [](const Possibility& p) -> bool { return p.assignment.empty(); });
+}
+
+/**
+ * @brief Converts an information state to the set of worlds of its possibilities.
+ *
+ * The conversion is lossless only if the state is variable-free.
+ *
+ * @param state The information state to convert.
+ * @param worlds The number of worlds in the base model.
+ * @return The world set of the state.
+ */
+WorldSet toWorldSet(const InformationState& state, int worlds)
+{
+    WorldSet output(worlds);
+    for (const Possibility& p : state) {
+        output.insert(p.world);
+    }
+    return output;
+}
+
+/**
+ * @brief Converts a world set back to an information state.
+ *
+ * The resulting state contains one possibility per world in the set, all of them
+ * sharing a single empty referent system, as those built by `create()`.
+ *
+ * @param state The world set to convert.
+ * @return The corresponding variable-free information state.
+ */
+InformationState toInformationState(const WorldSet& state)
+{
+    InformationState output;
+
+    auto r_system = std::make_shared<ReferentSystem>();
+    state.forEach([&](int world) { output.emplace_hint(output.end(), r_system, world); });
+
+    return output;
+}
+
+std::string str(const WorldSet& state)
+{
+    std::string contents;
+    state.forEach([&](int world) { contents += std::format("w{}, ", std::to_string(world)); });
+
+    if (contents.empty()) {
+        return "{ }";
+    }
+
+    contents.resize(contents.size() - 2);
+    return std::format("{{ {} }}", contents);
+}
+
+}
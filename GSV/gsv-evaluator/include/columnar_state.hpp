@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "idense_model.hpp"
+#include "imodel.hpp"
+#include "information_state.hpp"
+#include "program.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief A columnar (structure of arrays) copy of what an atomic formula reads from an information state.
+ *
+ * Row `i` describes the `i`-th possibility of the state, in the order of the state: its
+ * world, and the denotation at that possibility of every term of the formula. Each of
+ * these is stored in a contiguous column, so the selection kernels below check a whole
+ * state with branch-free loops over plain arrays, which compilers vectorize for the
+ * target instruction set, and record the outcome in a selection mask.
+ *
+ * Building the columns resolves every variable once per distinct referent system, and
+ * every constant once per world, rather than once per possibility. Columns are only
+ * built when every denotation can be read: `build()` gives up on unbound variables,
+ * uninterpreted constants and worlds out of the range of the model, so that callers can
+ * fall back to checking the possibilities one at a time, and report the same errors.
+ */
+class ColumnarState {
+public:
+    static std::optional<ColumnarState> build(const InformationState& state, std::span<const Program::Term> terms, const IModel& model, std::pmr::memory_resource* resource = nullptr);
+
+    std::size_t size() const;
+    std::size_t termCount() const;
+    std::span<const int> worlds() const;
+    std::span<const int> column(std::size_t term) const;
+
+private:
+    ColumnarState(std::size_t size, std::size_t term_count, std::pmr::memory_resource* resource);
+
+    std::size_t m_Size;
+    std::size_t m_TermCount;
+    std::pmr::vector<int> m_Data;
+};
+
+void selectIdentical(const ColumnarState& state, std::span<std::uint8_t> selection);
+void selectInExtension(const ColumnarState& state, const DenseExtension& extension, std::span<std::uint8_t> selection);
+
+}
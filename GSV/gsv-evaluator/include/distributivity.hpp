@@ -0,0 +1,9 @@
+#pragma once
+
+#include <QMLExpression/expression.hpp>
+
+namespace iif_sadaf::talk::GSV {
+
+bool isDistributive(const QMLExpression::Expression& expr);
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief A monotonic memory resource for the intermediate states of one evaluation.
+ *
+ * Allocations are carved out of large blocks and deallocation does nothing: all the
+ * memory is released at once when the arena is destroyed. Every thread allocates from a
+ * buffer of its own, so the arena can be used by the workers of a `ThreadPool` without
+ * contention, and memory allocated by one thread may be deallocated from any other. The
+ * first block of the thread that creates the arena is stored inside the arena itself, so
+ * small evaluations do not allocate blocks at all.
+ *
+ * States allocated from an arena must be destroyed before it, and must not be kept
+ * beyond the evaluation: copying a state (rather than moving it) yields a state on the
+ * default memory resource. Referent systems are never allocated from an arena.
+ */
+class EvaluationArena : public std::pmr::memory_resource {
+public:
+    static constexpr std::size_t INLINE_SIZE = 4096;
+
+    EvaluationArena();
+
+    EvaluationArena(const EvaluationArena&) = delete;
+    EvaluationArena& operator=(const EvaluationArena&) = delete;
+    EvaluationArena(EvaluationArena&&) = delete;
+    EvaluationArena& operator=(EvaluationArena&&) = delete;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    std::pmr::memory_resource& buffer();
+
+    std::uint64_t m_Id;
+    std::thread::id m_Owner;
+    alignas(std::max_align_t) std::array<std::byte, INLINE_SIZE> m_Inline;
+    std::pmr::monotonic_buffer_resource m_OwnerBuffer;
+    std::mutex m_Mutex;
+    std::vector<std::pair<std::thread::id, std::unique_ptr<std::pmr::monotonic_buffer_resource>>> m_Buffers;
+};
+
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <QMLExpression/expression.hpp>
+
+#include "imodel.hpp"
+#include "information_state.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief Assigns structural identities to expressions (hash-consing).
+ *
+ * Two expressions receive the same id if and only if they are structurally equal: same
+ * node types, operators, quantifiers, predicates and terms, in the same positions. Ids
+ * are stable for the lifetime of the interner, so they can be used as cache keys even
+ * for subformulas that are rebuilt on every evaluation (e.g. the negated disjunct).
+ *
+ * Nodes already seen are remembered by address, so interning an expression whose
+ * children were interned before is a constant-time operation. Interning is thread-safe.
+ */
+class ExpressionInterner {
+public:
+    std::uint64_t intern(const QMLExpression::Expression& expr);
+    std::size_t size() const;
+    void clear();
+
+private:
+    struct NodeEntry {
+        std::weak_ptr<const void> node;
+        std::uint64_t id;
+    };
+
+    std::uint64_t internLocked(const QMLExpression::Expression& expr);
+    std::uint64_t idOf(std::string&& structure);
+    void sweepExpiredNodes();
+
+    mutable std::mutex m_Mutex;
+    std::unordered_map<std::string, std::uint64_t> m_Ids;
+    std::unordered_map<const void*, NodeEntry> m_NodeIds;
+    std::size_t m_SweepThreshold = 1024;
+};
+
+/**
+ * @brief Bounded, thread-safe cache of evaluation results.
+ *
+ * Entries map a (subformula, model, input state) triple to the result of evaluating the
+ * subformula on the input state in the model. Subformulas are identified structurally
+ * through an `ExpressionInterner`, models by address, and input states by a hash that is
+ * always confirmed by a full comparison of the stored input state, so a hit is never a
+ * false positive.
+ *
+ * The cache holds at most `capacity` possibilities (summed over the input and result
+ * states of every entry); the least recently used entries are evicted to make room.
+ *
+ * A cache can be shared by any number of evaluations, including concurrent ones. Since
+ * models are identified by address, the cache must be cleared if a model it has seen is
+ * modified or destroyed.
+ *
+ * Cached states refer to variables by names interned in the global `SymbolTable`, so
+ * they remain valid after the expressions and programs that produced them are destroyed.
+ */
+class EvaluationCache {
+public:
+    struct Key {
+        std::uint64_t expression;
+        const IModel* model;
+        std::size_t state;
+
+        friend bool operator==(const Key& k1, const Key& k2) = default;
+    };
+
+    struct Statistics {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t evictions = 0;
+        std::size_t entries = 0;
+        std::size_t possibilities = 0;
+    };
+
+    explicit EvaluationCache(std::size_t capacity = 1 << 20);
+
+    Key key(const QMLExpression::Expression& expr, const InformationState& state, const IModel& model);
+    std::optional<std::expected<InformationState, std::string>> find(const Key& key, const InformationState& state);
+    void insert(const Key& key, InformationState state, std::expected<InformationState, std::string> result);
+
+    void clear();
+    std::size_t capacity() const;
+    Statistics statistics() const;
+
+private:
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        Key key;
+        InformationState input;
+        std::expected<InformationState, std::string> result;
+        std::size_t cost;
+    };
+
+    void evictLocked(std::size_t required);
+
+    std::size_t m_Capacity;
+    ExpressionInterner m_Interner;
+
+    mutable std::mutex m_Mutex;
+    std::list<Entry> m_Entries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_Index;
+    Statistics m_Statistics;
+};
+
+}
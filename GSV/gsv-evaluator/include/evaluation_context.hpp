@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <string_view>
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief How much work an evaluation context has admitted so far.
+ */
+struct EvaluationProgress {
+    std::uint64_t possibilities = 0;
+    std::uint64_t states = 0;
+    std::chrono::nanoseconds elapsed = std::chrono::nanoseconds::zero();
+};
+
+/**
+ * @brief Limits of the work done under an evaluation context.
+ *
+ * All limits are disabled by default.
+ *
+ * - **deadline**: the time after which no new work is started.
+ * - **maxPossibilities**: if non-zero, the maximum number of possibilities processed,
+ *   i.e. the sum of the cardinalities of the states every subformula is evaluated on.
+ * - **maxStates**: if non-zero, the maximum number of information states checked by the
+ *   searches of the semantic relations.
+ * - **stopToken**: a stop request on it cancels the work.
+ * - **progress**: if set, it is called, with the work admitted so far, every
+ *   `progressInterval` admissions.
+ */
+struct EvaluationLimits {
+    std::optional<std::chrono::steady_clock::time_point> deadline = std::nullopt;
+    std::uint64_t maxPossibilities = 0;
+    std::uint64_t maxStates = 0;
+    std::stop_token stopToken = {};
+    std::function<void(const EvaluationProgress&)> progress = nullptr;
+    std::uint64_t progressInterval = 4096;
+};
+
+/**
+ * @brief Bounds and cancels evaluations and relation checks cooperatively.
+ *
+ * Evaluations ask the context for admission before evaluating every subformula, and
+ * relation checks before checking every information state. Once a limit is hit, or a
+ * stop is requested, every later admission is refused, and the calls running under the
+ * context return an error as soon as they next ask. That error is `message()`, which
+ * starts with `INTERRUPTION_MESSAGE`, wrapped in the context of the enclosing formulas
+ * like any other error, so `status()` is the reliable way to tell an interrupted call
+ * from a failed one.
+ *
+ * A context may be shared by several calls, which then share its limits, and by the
+ * workers of a `ThreadPool`. Results of interrupted evaluations are never cached. The
+ * progress callback may be called from any thread running under the context, but never
+ * concurrently. The deadline is checked before every state, but only before every
+ * `DEADLINE_STRIDE`-th subformula, so that evaluations do not read the clock all the time.
+ */
+class EvaluationContext {
+public:
+    enum class Status {
+        RUNNING,
+        DEADLINE_EXCEEDED,
+        BUDGET_EXCEEDED,
+        CANCELLED
+    };
+
+    static constexpr std::string_view INTERRUPTION_MESSAGE = "Evaluation interrupted";
+    static constexpr std::uint64_t DEADLINE_STRIDE = 64;
+
+    explicit EvaluationContext(EvaluationLimits limits = {});
+
+    EvaluationContext(const EvaluationContext&) = delete;
+    EvaluationContext& operator=(const EvaluationContext&) = delete;
+
+    bool admitPossibilities(std::uint64_t count);
+    bool admitState();
+
+    Status status() const;
+    bool interrupted() const;
+    std::string message() const;
+    EvaluationProgress progress() const;
+
+private:
+    bool admit(std::uint64_t admissions, bool check_deadline);
+    void interrupt(Status status);
+    void report(std::uint64_t admissions);
+
+    EvaluationLimits m_Limits;
+    std::chrono::steady_clock::time_point m_Start;
+    std::atomic<Status> m_Status = Status::RUNNING;
+    std::atomic<std::uint64_t> m_Possibilities = 0;
+    std::atomic<std::uint64_t> m_States = 0;
+    std::atomic<std::uint64_t> m_Admissions = 0;
+    std::mutex m_ProgressMutex;
+};
+
+std::string_view str(EvaluationContext::Status status);
+
+}
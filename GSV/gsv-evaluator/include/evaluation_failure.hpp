@@ -0,0 +1,11 @@
+#pragma once
+
+#include <string>
+
+#include <QMLExpression/expression.hpp>
+
+namespace iif_sadaf::talk::GSV {
+
+std::string explain_failure(const QMLExpression::Expression& expr, const std::string& cause);
+
+}
@@ -1,32 +1,135 @@
 #pragma once
 
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <expected>
+#include <memory_resource>
+#include <optional>
+#include <string_view>
+#include <vector>
 
 #include <QMLExpression/expression.hpp>
 #include <SimpleLogger/simple_logger.hpp>
 
+#include "evaluation_arena.hpp"
+#include "evaluation_cache.hpp"
+#include "evaluation_context.hpp"
+#include "extension_index.hpp"
 #include "information_state.hpp"
+#include "profiler.hpp"
+#include "program.hpp"
+#include "symmetry_index.hpp"
+#include "thread_pool.hpp"
+#include "trace.hpp"
 
 namespace iif_sadaf::talk::GSV {
 
+/**
+ * @brief Optional collaborators of an evaluation.
+ *
+ * Everything is disabled by default. The trace level caps what is produced from the
+ * attached collaborators: events are only sent to `traceSink` at level EVENTS or above,
+ * and the free-text log is only sent to `logger` at level VERBOSE. When neither is
+ * attached, the evaluator does no formatting and no tracing-related allocation.
+ *
+ * When an `executor` is attached, the branches of each quantifier (one per individual)
+ * are evaluated in parallel, and then reduced in domain order, so results and error
+ * messages are the same as in serial evaluation. Parallelism is turned off while the
+ * free-text log is enabled. Trace events may then be recorded concurrently and
+ * out of order, so a sink used with an executor must be thread-safe.
+ *
+ * When a `cache` is attached, the result of every non-atomic subformula is looked up
+ * in it before being computed, and stored in it afterwards. The cache is bypassed while
+ * the free-text log is enabled. Subformulas answered from the cache emit no trace events
+ * for their own subformulas.
+ *
+ * When an `extensions` index is attached, and it indexes the model being evaluated on,
+ * atomic predications are checked against it, with tuples held on the stack. Indexes of
+ * other models are ignored.
+ *
+ * When `shortCircuit` is set, updates that are only tested for emptiness (the prejacent
+ * of epistemic possibility, and the updates of `hasNonEmptyUpdate()`) are evaluated up
+ * to their first surviving possibility (or their first non-empty existential branch).
+ * Errors that only the skipped possibilities or branches would have raised are then not
+ * reported. Short-circuiting is turned off while tracing.
+ *
+ * When `useArena` is set, every call to `evaluate()` or `hasNonEmptyUpdate()` allocates
+ * the intermediate states of the evaluation from an `EvaluationArena` of its own, which
+ * is released at once when the call returns. The result is copied out of the arena onto
+ * the default memory resource.
+ *
+ * When a `profiler` is attached, it receives the trace events of every node evaluated,
+ * whatever the trace level, and aggregates their cost (see `Profiler`). Unlike tracing,
+ * profiling does not change how subformulas are evaluated, except that quantifier branches
+ * are evaluated serially.
+ *
+ * When a `context` is attached, every subformula is admitted by it before being
+ * evaluated, and the evaluation fails as soon as the context refuses (see
+ * `EvaluationContext`).
+ *
+ * When a `symmetry` index is attached, and it partitions the domain of the model being
+ * evaluated on, the branch of a quantifier for an individual is derived from the branch
+ * of its representative (see `SymmetryIndex`) whenever swapping the two individuals
+ * leaves the input state unchanged, and a probed existential skips the individuals whose
+ * branch would be derived from an empty one.
+ * Results are the same as without the index. The index is ignored while tracing.
+ */
+struct EvaluationOptions {
+    simple_logger::SimpleLogger* logger = nullptr;
+    ITraceSink* traceSink = nullptr;
+    TraceLevel traceLevel = TraceLevel::VERBOSE;
+    ThreadPool* executor = nullptr;
+    EvaluationCache* cache = nullptr;
+    const ExtensionIndex* extensions = nullptr;
+    bool shortCircuit = false;
+    bool useArena = false;
+    Profiler* profiler = nullptr;
+    EvaluationContext* context = nullptr;
+    const SymmetryIndex* symmetry = nullptr;
+};
+
 /**
  * @brief Implements the GSV evaluation function for QML formulas
  *
  * The Evaluator struct applies logical operations on `InformationState` objects
  * using the visitor pattern. It also takes an IModel* as parameter.
- * 
+ *
  * It evaluates different types of logical expressions, including unary, binary,
- * quantification, identity, and predication nodes. The evaluation modifies or filters 
+ * quantification, identity, and predication nodes. The evaluation modifies or filters
  * the given `InformationState`, based on the logical rules applied, and the semantic information provided by `IModel*`.
- * 
+ *
  * Due to the way `std::visit` is implemented in C++, the input `InformationState`
  * and `IModel*` must be wrapped in a `std::variant` and passed as a single argument.
+ *
+ * Expressions are compiled to a `Program` before being evaluated, and the evaluator
+ * walks the instructions of the program. Callers that evaluate the same expression
+ * many times can compile it once and use the overloads taking a program.
+ *
+ * Internally, every node is evaluated in one of two modes. In owning mode the node
+ * receives its input state by rvalue and filters it in place. In hypothetical mode the
+ * node only borrows its input state and builds a fresh state from the surviving
+ * possibilities. Subformulas whose updates are only inspected (the prejacent of a test,
+ * the antecedent of a conditional, ...) are evaluated hypothetically, so no node makes
+ * a full copy of its input state.
+ *
+ * Unless the evaluation is traced, the update with the negated left disjunct of a
+ * disjunction is derived from the update with the left disjunct, and well-formed
+ * subformulas are not evaluated on the empty state, whose update they leave empty.
+ * Traced evaluations evaluate every subformula as written, so traces show all of them.
+ *
+ * Evaluation is reentrant. An evaluator is immutable, every call keeps its intermediate
+ * states to itself, and inputs (states, programs, models) are only read, so any number
+ * of threads may evaluate at once against the same model, with the same programs and
+ * input states, and with the same evaluator. Caches, thread pools, extension indexes,
+ * profilers and evaluation contexts may be shared by concurrent calls; loggers and trace
+ * sinks shared by concurrent calls must be thread-safe themselves.
  */
 struct Evaluator {
 public:
-    Evaluator(simple_logger::SimpleLogger* logger = nullptr)
-        : m_Logger(simple_logger::normalize(logger))
-    { }
+    Evaluator(simple_logger::SimpleLogger* logger = nullptr);
+    explicit Evaluator(const EvaluationOptions& options);
+    Evaluator(const EvaluationOptions& options, std::pmr::memory_resource* resource);
 
     std::expected<InformationState, std::string> operator()(const std::shared_ptr<QMLExpression::UnaryNode>& expr, std::pair<InformationState, const IModel*> params) const;
     std::expected<InformationState, std::string> operator()(const std::shared_ptr<QMLExpression::BinaryNode>& expr, std::pair<InformationState, const IModel*> params) const;
@@ -34,11 +137,72 @@ public:
     std::expected<InformationState, std::string> operator()(const std::shared_ptr<QMLExpression::IdentityNode>& expr, std::pair<InformationState, const IModel*> params) const;
     std::expected<InformationState, std::string> operator()(const std::shared_ptr<QMLExpression::PredicationNode>& expr, std::pair<InformationState, const IModel*> params) const;
 
+    std::expected<InformationState, std::string> evaluateOwned(const QMLExpression::Expression& expr, InformationState&& state, const IModel& model) const;
+    std::expected<InformationState, std::string> evaluateHypothetical(const QMLExpression::Expression& expr, const InformationState& state, const IModel& model) const;
+    std::expected<InformationState, std::string> evaluateOwned(const Program& program, InformationState&& state, const IModel& model) const;
+    std::expected<InformationState, std::string> evaluateHypothetical(const Program& program, const InformationState& state, const IModel& model) const;
+    std::expected<bool, std::string> evaluateNonEmpty(const Program& program, const InformationState& state, const IModel& model) const;
+
 private:
-    simple_logger::SimpleLogger* m_Logger;
+    template<typename State>
+    std::expected<InformationState, std::string> evaluateNode(const Program& program, std::uint32_t node, State&& state, const IModel* model) const;
+    template<typename State>
+    std::expected<InformationState, std::string> traced(const Program& program, std::uint32_t node, State&& state, const IModel* model) const;
+    template<typename State>
+    std::expected<InformationState, std::string> apply(const Program& program, std::uint32_t node, State&& state, const IModel* model) const;
+
+    template<typename State>
+    std::expected<InformationState, std::string> applyUnary(const Program& program, const Program::Instruction& instruction, State&& state, const IModel* model) const;
+    template<typename State>
+    std::expected<InformationState, std::string> applyBinary(const Program& program, const Program::Instruction& instruction, State&& state, const IModel* model) const;
+    template<typename State>
+    std::expected<InformationState, std::string> applyQuantification(const Program& program, const Program::Instruction& instruction, State&& state, const IModel* model) const;
+    template<typename State>
+    std::expected<InformationState, std::string> applyIdentity(const Program& program, const Program::Instruction& instruction, State&& state, const IModel* model) const;
+    template<typename State>
+    std::expected<InformationState, std::string> applyPredication(const Program& program, const Program::Instruction& instruction, State&& state, const IModel* model) const;
 
+    std::vector<std::expected<InformationState, std::string>> evaluateBranches(const Program& program, const Program::Instruction& instruction, const InformationState& input_state, const IModel* model) const;
+    std::vector<int> branchSources(const InformationState& input_state, const IModel* model) const;
+
+    Evaluator descend() const;
+    Evaluator probe() const;
+    std::optional<SymmetryPlan> symmetryPlan(const Program& program, const IModel& model) const;
+    Evaluator reduced(const std::optional<SymmetryPlan>& plan) const;
+    bool shortCircuits() const;
+    std::pmr::memory_resource* resource() const;
+    void emit(TraceEvent::Type type, const void* node, TraceOperator op, std::size_t input_cardinality, std::size_t output_cardinality, std::size_t allocated = 0) const;
+
+    bool tracesEvents() const;
+    bool tracesVerbose() const;
+    bool profiles() const;
+
+    void log(std::string_view message) const;
+
+    template<std::invocable MessageBuilder>
+    void log(MessageBuilder&& build_message) const
+    {
+        if (tracesVerbose()) {
+            m_Options.logger->info(build_message());
+        }
+    }
+
+    EvaluationOptions m_Options;
+    std::pmr::memory_resource* m_Resource = nullptr;
+    const SymmetryPlan* m_Symmetry = nullptr;
+    int m_Depth = 0;
+    bool m_Probing = false;
 };
 
 std::expected<InformationState, std::string> evaluate(const QMLExpression::Expression& expr, const InformationState& input_state, const IModel& model, simple_logger::SimpleLogger* logger = nullptr);
+std::expected<InformationState, std::string> evaluate(const QMLExpression::Expression& expr, const InformationState& input_state, const IModel& model, const EvaluationOptions& options);
+std::expected<InformationState, std::string> evaluate(const QMLExpression::Expression& expr, InformationState&& input_state, const IModel& model, simple_logger::SimpleLogger* logger = nullptr);
+std::expected<InformationState, std::string> evaluate(const QMLExpression::Expression& expr, InformationState&& input_state, const IModel& model, const EvaluationOptions& options);
+
+std::expected<InformationState, std::string> evaluate(const Program& program, const InformationState& input_state, const IModel& model, simple_logger::SimpleLogger* logger = nullptr);
+std::expected<InformationState, std::string> evaluate(const Program& program, const InformationState& input_state, const IModel& model, const EvaluationOptions& options);
+std::expected<InformationState, std::string> evaluate(const Program& program, InformationState&& input_state, const IModel& model, simple_logger::SimpleLogger* logger = nullptr);
+std::expected<InformationState, std::string> evaluate(const Program& program, InformationState&& input_state, const IModel& model, const EvaluationOptions& options);
+std::expected<bool, std::string> hasNonEmptyUpdate(const Program& program, const InformationState& input_state, const IModel& model, const EvaluationOptions& options);
 
 }
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <expected>
+#include <memory>
+#include <span>
+#include <string>
+
+#include "imodel.hpp"
+#include "symbol_table.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief Precomputed extensions of the predicates of a model, for allocation-free lookups.
+ *
+ * The first time a predicate is queried, its interpretation is resolved through the model
+ * at every world (by id if the model is an `IIndexedModel`, by name otherwise) and stored
+ * in a flat form: a bitmap over the domain for the unary tuples, a bitmap over pairs of
+ * individuals for the binary tuples when the domain is small enough, and an open-addressing
+ * hash table per arity for every other tuple. Later queries for that predicate read the
+ * stored extensions only, with the tuple passed as a span, so they neither allocate nor
+ * compare vectors.
+ *
+ * `contains()` answers exactly as `model.predicateInterpretation(name, world)` followed by
+ * a lookup of the tuple in the returned set would, including the error messages. Queries
+ * are thread-safe. The index refers to the model, which must outlive it and must not be
+ * modified while the index is in use.
+ */
+class ExtensionIndex {
+public:
+    explicit ExtensionIndex(const IModel& model);
+
+    ExtensionIndex(const ExtensionIndex&) = delete;
+    ExtensionIndex& operator=(const ExtensionIndex&) = delete;
+    ExtensionIndex(ExtensionIndex&&) noexcept;
+    ExtensionIndex& operator=(ExtensionIndex&&) noexcept;
+    ~ExtensionIndex();
+
+    const IModel& model() const;
+    std::expected<bool, std::string> contains(SymbolId predicate, int world, std::span<const int> tuple) const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+}
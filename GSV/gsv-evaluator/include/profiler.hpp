@@ -0,0 +1,137 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <QMLExpression/expression.hpp>
+
+#include "program.hpp"
+#include "trace.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief The aggregated cost of the evaluations of one AST node.
+ *
+ * Times and allocations are totals over every call. `totalTime` and
+ * `allocatedPossibilities` include the subformulas of the node; `selfTime` and
+ * `selfAllocatedPossibilities` do not. Cardinalities are sums of the sizes of the
+ * input states of every call, and of the output states of the calls that did not fail.
+ */
+struct NodeProfile {
+    std::uintptr_t nodeId = 0;
+    TraceOperator op = TraceOperator::INVALID;
+    std::string formula;
+    std::uint64_t calls = 0;
+    std::uint64_t failures = 0;
+    std::chrono::nanoseconds totalTime{ 0 };
+    std::chrono::nanoseconds selfTime{ 0 };
+    std::uint64_t inputPossibilities = 0;
+    std::uint64_t outputPossibilities = 0;
+    std::uint64_t allocatedPossibilities = 0;
+    std::uint64_t selfAllocatedPossibilities = 0;
+};
+
+/**
+ * @brief The aggregated counters of the calls to one model-level relation.
+ *
+ * `statesChecked` counts the information states the searches probed. A search exits
+ * early when a state settles it (a counterexample, a witness, or an error) before every
+ * state was checked.
+ */
+struct RelationProfile {
+    std::string relation;
+    std::uint64_t calls = 0;
+    std::uint64_t statesChecked = 0;
+    std::uint64_t earlyExits = 0;
+    std::chrono::nanoseconds totalTime{ 0 };
+};
+
+/**
+ * @brief A trace sink aggregating the cost of every node of the evaluated expressions.
+ *
+ * Attached as `EvaluationOptions::profiler` (or `RelationOptions::profiler`), the profiler
+ * receives the ENTER and EXIT events of every node actually evaluated, without switching
+ * the evaluation to the as-written mode used by tracing, so the profile is the one of an
+ * ordinary evaluation. Those events also carry the number of possibilities each node
+ * allocated. Quantifier branches are evaluated serially while profiling, so that calls
+ * nest as in the formula. It can also be attached as an ordinary `ITraceSink`.
+ *
+ * Calls are aggregated per node, and per call path for `collapsedStacks()`. Nodes are
+ * identified by address: `describe()` an expression to report its subformulas by their
+ * formula rather than by their operator.
+ *
+ * `record()` is thread-safe and does not contend: every thread aggregates into tables of
+ * its own. The reports and `reset()` must not run concurrently with an evaluation.
+ */
+class Profiler : public ITraceSink {
+public:
+    Profiler();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    void record(const TraceEvent& event) override;
+    void recordRelation(std::string_view relation, std::uint64_t states_checked, bool early_exit, std::chrono::nanoseconds time);
+
+    void describe(const QMLExpression::Expression& expr);
+    void describe(const Program& program);
+
+    std::vector<NodeProfile> nodes() const;
+    std::vector<RelationProfile> relations() const;
+    std::string json() const;
+    std::string collapsedStacks() const;
+    void reset();
+
+private:
+    /**
+     * @brief A node of the call tree of one thread: one call path, ending at `nodeId`.
+     */
+    struct CallNode {
+        std::uintptr_t nodeId;
+        TraceOperator op;
+        std::uint32_t parent;
+        std::vector<std::uint32_t> children;
+        std::uint64_t calls = 0;
+        std::uint64_t failures = 0;
+        std::chrono::nanoseconds totalTime{ 0 };
+        std::chrono::nanoseconds childTime{ 0 };
+        std::uint64_t inputPossibilities = 0;
+        std::uint64_t outputPossibilities = 0;
+        std::uint64_t allocatedPossibilities = 0;
+        std::uint64_t childAllocatedPossibilities = 0;
+    };
+
+    struct Frame {
+        std::uint32_t node;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    /**
+     * @brief The call tree and call stack of one thread. Node 0 is the root of the tree.
+     */
+    struct ThreadProfile {
+        std::vector<CallNode> calls;
+        std::vector<Frame> stack;
+    };
+
+    ThreadProfile& threadProfile();
+    std::string label(const CallNode& node) const;
+
+    std::uint64_t m_Id;
+    mutable std::mutex m_Mutex;
+    std::vector<std::pair<std::thread::id, std::unique_ptr<ThreadProfile>>> m_Threads;
+    std::unordered_map<std::uintptr_t, std::string> m_Formulas;
+    std::map<std::string, RelationProfile, std::less<>> m_Relations;
+};
+
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <QMLExpression/expression.hpp>
+
+#include "symbol_table.hpp"
+#include "trace.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief A QML expression lowered to a flat array of instructions.
+ *
+ * Compiling an expression walks its tree once and stores one instruction per node, in
+ * post-order, so the operands of an instruction always precede it and the root is the
+ * last instruction. Instructions refer to their operands by index. The names of variables,
+ * constants and predicates are interned in the global `SymbolTable`, and the arguments of
+ * every atomic formula are laid out contiguously, with their arity precomputed.
+ *
+ * The negation of the left disjunct of every disjunction, which the semantic clause of
+ * disjunction evaluates, is compiled once as an instruction of its own. Untraced
+ * evaluations derive its update from the left disjunct instead of evaluating it.
+ *
+ * A program does not depend on any state or model, so it can be compiled once and
+ * evaluated any number of times, including concurrently. Copies share the same
+ * instructions.
+ */
+class Program {
+public:
+    enum class Opcode {
+        NEGATION,
+        EPISTEMIC_POSSIBILITY,
+        EPISTEMIC_NECESSITY,
+        INVALID_UNARY,
+        CONJUNCTION,
+        DISJUNCTION,
+        CONDITIONAL,
+        INVALID_BINARY,
+        EXISTENTIAL,
+        UNIVERSAL,
+        INVALID_QUANTIFIER,
+        IDENTITY,
+        PREDICATION
+    };
+
+    /**
+     * @brief An argument of an atomic formula.
+     */
+    struct Term {
+        bool variable;
+        SymbolId symbol;
+        std::string_view name;
+    };
+
+    /**
+     * @brief One node of the compiled expression.
+     *
+     * - **lhs**: the prejacent of a unary operator, the scope of a quantifier, or the
+     *   left operand of a binary operator.
+     * - **rhs**: the right operand of a binary operator.
+     * - **negatedLhs**: for disjunctions, the negation of the left operand.
+     * - **symbol**, **name**: the quantified variable, or the predicate.
+     * - **firstTerm**, **arity**: the arguments of an atomic formula, in `terms()`.
+     * - **wellFormed**: false if the subformula contains an INVALID opcode. Well-formed
+     *   subformulas can only fail on a possibility, so they never fail on the empty state.
+     * - **source**: the node it was compiled from, for messages and trace events.
+     */
+    struct Instruction {
+        Opcode opcode;
+        TraceOperator traceOperator;
+        std::uint32_t lhs = 0;
+        std::uint32_t rhs = 0;
+        std::uint32_t negatedLhs = 0;
+        SymbolId symbol = -1;
+        std::string_view name = {};
+        std::uint32_t firstTerm = 0;
+        std::uint32_t arity = 0;
+        bool wellFormed = true;
+        QMLExpression::Expression source;
+    };
+
+    explicit Program(const QMLExpression::Expression& expr);
+
+    std::uint32_t root() const;
+    std::size_t size() const;
+    const Instruction& operator[](std::uint32_t index) const;
+    std::span<const Term> terms(const Instruction& instruction) const;
+    const QMLExpression::Expression& source() const;
+
+private:
+    struct Code {
+        std::vector<Instruction> instructions;
+        std::vector<Term> terms;
+    };
+
+    std::shared_ptr<const Code> m_Code;
+};
+
+bool isAtomic(const Program::Instruction& instruction);
+
+}
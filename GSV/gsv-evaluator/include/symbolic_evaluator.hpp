@@ -0,0 +1,30 @@
+#pragma once
+
+#include <expected>
+#include <string>
+#include <vector>
+
+#include <QMLExpression/expression.hpp>
+
+#include "decision_diagram.hpp"
+#include "imodel.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief The updates of a family of variable-free states, all at once.
+ *
+ * Element `w` is the diagram of the states of the family whose update contains the world
+ * `w`. The update of one state `s` is then the set of the worlds whose diagrams contain `s`.
+ */
+using SymbolicState = std::vector<DecisionDiagram::Node>;
+
+SymbolicState everyState(DecisionDiagram& diagram);
+
+std::expected<SymbolicState, std::string> evaluate(const QMLExpression::Expression& expr, const SymbolicState& input_state, const IModel& model, DecisionDiagram& diagram);
+
+DecisionDiagram::Node nonEmpty(const SymbolicState& state, DecisionDiagram& diagram);
+DecisionDiagram::Node isSubsetOf(const SymbolicState& s1, const SymbolicState& s2, DecisionDiagram& diagram);
+DecisionDiagram::Node differ(const SymbolicState& s1, const SymbolicState& s2, DecisionDiagram& diagram);
+
+}
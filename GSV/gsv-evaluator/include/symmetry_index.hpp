@@ -0,0 +1,65 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "imodel.hpp"
+#include "program.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief What the evaluation of one program needs from a `SymmetryIndex`.
+ *
+ * - **representatives**: for every individual, the least individual interchangeable with
+ *   it in the vocabulary of the program.
+ */
+struct SymmetryPlan {
+    std::span<const int> representatives;
+};
+
+/**
+ * @brief Partitions of the domain of a model into individuals that a vocabulary cannot tell apart.
+ *
+ * Two individuals are interchangeable in a vocabulary (a set of predicates and constants)
+ * if swapping them maps the extension of every predicate of the vocabulary at every world
+ * onto itself, and no constant of the vocabulary denotes either of them at any world.
+ * Swapping two interchangeable individuals throughout a state then commutes with updating
+ * it with any formula over the vocabulary, so the evaluator can derive the branch of a
+ * quantifier for an individual from the branch of its representative, instead of
+ * evaluating it, whenever the swap leaves the input state of the quantifier unchanged.
+ * This holds for every scope, since the existential quantifier unites all of its branches.
+ *
+ * The partition of a vocabulary is computed the first time a program over it is
+ * evaluated, and kept for the lifetime of the index. Queries are thread-safe. The index
+ * refers to the model, which must outlive it and must not be modified while the index is
+ * in use.
+ */
+class SymmetryIndex {
+public:
+    explicit SymmetryIndex(const IModel& model);
+
+    SymmetryIndex(const SymmetryIndex&) = delete;
+    SymmetryIndex& operator=(const SymmetryIndex&) = delete;
+
+    const IModel& model() const;
+    std::span<const int> representatives(const Program& program) const;
+    SymmetryPlan plan(const Program& program) const;
+
+private:
+    /**
+     * @brief A vocabulary: the predicates, with their arities, and then the constants (with arity -1).
+     */
+    using Vocabulary = std::vector<std::pair<SymbolId, int>>;
+
+    std::vector<int> partition(const Vocabulary& vocabulary) const;
+
+    const IModel* m_Model;
+    mutable std::mutex m_Mutex;
+    mutable std::map<Vocabulary, std::vector<int>> m_Partitions;
+};
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief A fixed-size pool of worker threads running index-parallel loops.
+ *
+ * The only scheduling primitive is `parallelFor()`. The calling thread takes part in
+ * its own loop, and it only waits for indices that other threads have already started.
+ * This makes nested calls safe: a worker that issues a `parallelFor()` from inside a loop
+ * body can always finish the inner loop by itself, even if every other worker is busy.
+ *
+ * A pool can be shared by any number of concurrent evaluations.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned thread_count = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    std::size_t threadCount() const;
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& body);
+
+private:
+    struct Job {
+        const std::function<void(std::size_t)>* body;
+        std::size_t count;
+        std::atomic<std::size_t> next = 0;
+        std::atomic<std::size_t> done = 0;
+        std::mutex errorMutex;
+        std::exception_ptr error;
+    };
+
+    void work(std::stop_token stop_token);
+    void run(Job& job);
+    void retire(const std::shared_ptr<Job>& job);
+
+    std::mutex m_Mutex;
+    std::condition_variable_any m_JobAvailable;
+    std::deque<std::shared_ptr<Job>> m_Jobs;
+    std::vector<std::jthread> m_Workers;
+};
+
+}
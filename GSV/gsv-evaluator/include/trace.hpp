@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <QMLExpression/expression.hpp>
+
+/**
+ * @brief Compile-time upper bound on the trace level (0 = OFF, 1 = EVENTS, 2 = VERBOSE).
+ *
+ * Tracing code above this level is compiled out of the evaluator. It is set through
+ * the `GSV_MAX_TRACE_LEVEL` CMake cache variable.
+ */
+#ifndef GSV_MAX_TRACE_LEVEL
+#define GSV_MAX_TRACE_LEVEL 2
+#endif
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief Amount of tracing produced by an evaluation.
+ *
+ * - **OFF**: no tracing at all. Nothing is formatted and nothing is allocated.
+ * - **EVENTS**: one structured `TraceEvent` per node entry and exit, sent to an `ITraceSink`.
+ * - **VERBOSE**: events, plus the free-text evaluation log sent to a `SimpleLogger`.
+ */
+enum class TraceLevel { OFF = 0, EVENTS = 1, VERBOSE = 2 };
+
+inline constexpr TraceLevel MAX_TRACE_LEVEL = static_cast<TraceLevel>(GSV_MAX_TRACE_LEVEL);
+
+/**
+ * @brief The operator applied by an AST node, as reported in trace events.
+ */
+enum class TraceOperator {
+    NEGATION,
+    EPISTEMIC_POSSIBILITY,
+    EPISTEMIC_NECESSITY,
+    CONJUNCTION,
+    DISJUNCTION,
+    CONDITIONAL,
+    EXISTENTIAL,
+    UNIVERSAL,
+    IDENTITY,
+    PREDICATION,
+    INVALID
+};
+
+/**
+ * @brief A structured record of one step in the evaluation of an expression.
+ *
+ * The node id is the address of the AST node being evaluated, so it is stable for the
+ * lifetime of the expression and can be mapped back to the subformula by the sink.
+ * Cardinalities are sizes of information states; `outputCardinality` is only
+ * meaningful in EXIT events. So is `allocatedPossibilities`, the number of possibilities
+ * allocated by the evaluation of the node, subformulas included; possibilities filtered
+ * in place are not allocated.
+ */
+struct TraceEvent {
+    enum class Type { ENTER, EXIT, FAILURE };
+
+    Type type;
+    std::uintptr_t nodeId;
+    TraceOperator op;
+    int depth;
+    std::size_t inputCardinality;
+    std::size_t outputCardinality;
+    std::size_t allocatedPossibilities = 0;
+};
+
+/**
+ * @brief Interface for receivers of structured trace events.
+ *
+ * Sinks are called synchronously from the evaluator, so `record()` should be cheap. If
+ * the evaluation has an executor, `record()` may be called concurrently from several threads.
+ */
+struct ITraceSink {
+public:
+    virtual void record(const TraceEvent& event) = 0;
+    virtual ~ITraceSink() {}
+};
+
+TraceOperator traceOperator(QMLExpression::Operator op);
+TraceOperator traceOperator(QMLExpression::Quantifier quantifier);
+std::string_view str(TraceOperator op);
+
+}
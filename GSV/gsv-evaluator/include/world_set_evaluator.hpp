@@ -0,0 +1,17 @@
+#pragma once
+
+#include <expected>
+#include <string>
+
+#include <QMLExpression/expression.hpp>
+
+#include "imodel.hpp"
+#include "world_set.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+bool isVariableFree(const QMLExpression::Expression& expr);
+
+std::expected<WorldSet, std::string> evaluate(const QMLExpression::Expression& expr, const WorldSet& input_state, const IModel& model);
+
+}
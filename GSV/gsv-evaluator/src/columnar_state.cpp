@@ -0,0 +1,196 @@
+#include "columnar_state.hpp"
+
+#include "iindexed_model.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+namespace {
+
+/**
+ * @brief Fills the column of a variable, resolving its peg once per referent system.
+ */
+bool fillVariableColumn(const InformationState& state, SymbolId variable, std::span<int> column)
+{
+    const ReferentSystem* resolved_system = nullptr;
+    int peg = 0;
+    std::size_t row = 0;
+    for (const Possibility& p : state) {
+        if (p.referentSystem.get() != resolved_system) {
+            const auto resolved_peg = p.referentSystem->value(variable);
+            if (!resolved_peg.has_value()) {
+                return false;
+            }
+            resolved_system = p.referentSystem.get();
+            peg = resolved_peg.value();
+        }
+        if (!p.assignment.contains(peg)) {
+            return false;
+        }
+        column[row++] = p.assignment.slots()[peg - 1];
+    }
+    return true;
+}
+
+/**
+ * @brief Fills the column of a constant, from its table in dense models, or resolving it once per world.
+ */
+bool fillConstantColumn(const Program::Term& constant, std::span<const int> worlds, const IModel& model, std::span<int> column, std::pmr::memory_resource* resource)
+{
+    const IDenseModel* dense_model = dynamic_cast<const IDenseModel*>(&model);
+    if (const int* table = dense_model != nullptr ? dense_model->termTable(constant.symbol) : nullptr) {
+        for (std::size_t row = 0; row < worlds.size(); ++row) {
+            column[row] = table[worlds[row]];
+        }
+        return true;
+    }
+
+    const IIndexedModel* indexed_model = dynamic_cast<const IIndexedModel*>(&model);
+    std::pmr::vector<int> denotations(model.worldCardinality(), 0, resource);
+    std::pmr::vector<std::uint8_t> resolved(model.worldCardinality(), 0, resource);
+    for (std::size_t row = 0; row < worlds.size(); ++row) {
+        const int world = worlds[row];
+        if (!resolved[world]) {
+            const auto denotation = indexed_model != nullptr ? indexed_model->termInterpretationById(constant.symbol, world) : model.termInterpretation(constant.name, world);
+            if (!denotation.has_value()) {
+                return false;
+            }
+            denotations[world] = denotation.value();
+            resolved[world] = 1;
+        }
+        column[row] = denotations[world];
+    }
+    return true;
+}
+
+} // ANONYMOUS NAMESPACE
+
+ColumnarState::ColumnarState(std::size_t size, std::size_t term_count, std::pmr::memory_resource* resource)
+    : m_Size(size)
+    , m_TermCount(term_count)
+    , m_Data((term_count + 1) * size, 0, resource)
+{ }
+
+/**
+ * @brief Builds the columns of a state for the terms of an atomic formula.
+ *
+ * @param state The state whose possibilities become the rows.
+ * @param terms The terms to denote at every possibility, in column order.
+ * @param model The model interpreting the constants. Worlds must be in its range.
+ * @param resource The resource to allocate the columns from, or nullptr for the default one.
+ * @return The columns, or nullopt if some denotation cannot be read (see the class).
+ */
+std::optional<ColumnarState> ColumnarState::build(const InformationState& state, std::span<const Program::Term> terms, const IModel& model, std::pmr::memory_resource* resource)
+{
+    if (resource == nullptr) {
+        resource = std::pmr::get_default_resource();
+    }
+
+    ColumnarState columns(state.size(), terms.size(), resource);
+    const std::span<int> worlds(columns.m_Data.data(), columns.m_Size);
+    const int world_cardinality = model.worldCardinality();
+
+    std::size_t row = 0;
+    for (const Possibility& p : state) {
+        if (p.world < 0 || p.world >= world_cardinality) {
+            return std::nullopt;
+        }
+        worlds[row++] = p.world;
+    }
+
+    for (std::size_t i = 0; i < terms.size(); ++i) {
+        const std::span<int> column(columns.m_Data.data() + (i + 1) * columns.m_Size, columns.m_Size);
+        const bool filled = terms[i].variable ? fillVariableColumn(state, terms[i].symbol, column) : fillConstantColumn(terms[i], worlds, model, column, resource);
+        if (!filled) {
+            return std::nullopt;
+        }
+    }
+    return columns;
+}
+
+std::size_t ColumnarState::size() const
+{
+    return m_Size;
+}
+
+std::size_t ColumnarState::termCount() const
+{
+    return m_TermCount;
+}
+
+std::span<const int> ColumnarState::worlds() const
+{
+    return { m_Data.data(), m_Size };
+}
+
+/**
+ * @brief The denotations of the `term`-th term, one per row.
+ */
+std::span<const int> ColumnarState::column(std::size_t term) const
+{
+    return { m_Data.data() + (term + 1) * m_Size, m_Size };
+}
+
+/**
+ * @brief Selects the rows at which the two terms of the columns denote the same individual.
+ *
+ * @param state Columns built for exactly two terms.
+ * @param selection Receives 1 for every selected row and 0 for every other row.
+ */
+void selectIdentical(const ColumnarState& state, std::span<std::uint8_t> selection)
+{
+    const int* lhs = state.column(0).data();
+    const int* rhs = state.column(1).data();
+    std::uint8_t* selected = selection.data();
+    for (std::size_t row = 0; row < state.size(); ++row) {
+        selected[row] = lhs[row] == rhs[row];
+    }
+}
+
+/**
+ * @brief Selects the rows at which the tuple of the terms of the columns belongs to an extension.
+ *
+ * The tuples are packed into bit indices one column at a time, and the extension bits are
+ * then gathered for every row, so that each pass is a branch-free loop. Tuples with an
+ * element outside the domain, or of the wrong arity, are not selected.
+ *
+ * @param state The columns, whose worlds must all be in `[0, extension.worlds)`.
+ * @param extension The packed extension of the predicate.
+ * @param selection Receives 1 for every selected row and 0 for every other row.
+ */
+void selectInExtension(const ColumnarState& state, const DenseExtension& extension, std::span<std::uint8_t> selection)
+{
+    std::uint8_t* selected = selection.data();
+    if (state.termCount() != extension.arity || (extension.arity > 0 && extension.domain <= 0)) {
+        for (std::size_t row = 0; row < state.size(); ++row) {
+            selected[row] = 0;
+        }
+        return;
+    }
+
+    const std::uint64_t domain = static_cast<std::uint64_t>(extension.domain);
+    std::vector<std::uint64_t> bits(state.size());
+    const int* worlds = state.worlds().data();
+    for (std::size_t row = 0; row < state.size(); ++row) {
+        bits[row] = 0;
+        selected[row] = 1;
+    }
+
+    for (std::size_t term = 0; term < state.termCount(); ++term) {
+        const int* elements = state.column(term).data();
+        for (std::size_t row = 0; row < state.size(); ++row) {
+            const std::uint64_t element = static_cast<std::uint64_t>(static_cast<std::uint32_t>(elements[row]));
+            const bool in_domain = elements[row] >= 0 && element < domain;
+            selected[row] &= in_domain;
+            bits[row] = bits[row] * domain + (in_domain ? element : 0);
+        }
+    }
+
+    const std::uint64_t stride = extension.worldStride;
+    const std::uint64_t* words = extension.bits;
+    for (std::size_t row = 0; row < state.size(); ++row) {
+        const std::uint64_t bit = static_cast<std::uint64_t>(worlds[row]) * stride + bits[row];
+        selected[row] &= static_cast<std::uint8_t>((words[bit / 64] >> (bit % 64)) & 1);
+    }
+}
+
+}
@@ -0,0 +1,61 @@
+#include "distributivity.hpp"
+
+#include <variant>
+
+namespace iif_sadaf::talk::GSV {
+
+namespace {
+
+struct DistributivityChecker {
+    bool operator()(const std::shared_ptr<QMLExpression::UnaryNode>& expr) const
+    {
+        return expr->op == QMLExpression::Operator::NEGATION && std::visit(*this, expr->scope);
+    }
+
+    bool operator()(const std::shared_ptr<QMLExpression::BinaryNode>& expr) const
+    {
+        const bool is_distributive_operator = expr->op == QMLExpression::Operator::CONJUNCTION
+            || expr->op == QMLExpression::Operator::DISJUNCTION
+            || expr->op == QMLExpression::Operator::CONDITIONAL;
+        return is_distributive_operator && std::visit(*this, expr->lhs) && std::visit(*this, expr->rhs);
+    }
+
+    bool operator()(const std::shared_ptr<QMLExpression::QuantificationNode>& expr) const
+    {
+        return std::visit(*this, expr->scope);
+    }
+
+    bool operator()(const std::shared_ptr<QMLExpression::IdentityNode>&) const
+    {
+        return true;
+    }
+
+    bool operator()(const std::shared_ptr<QMLExpression::PredicationNode>&) const
+    {
+        return true;
+    }
+};
+
+} // ANONYMOUS NAMESPACE
+
+/**
+ * @brief Determines whether updates with an expression are computed possibility by possibility.
+ *
+ * An expression is distributive if it contains no epistemic modals (and no invalid operators).
+ * Every other clause of the semantics decides the fate of a possibility by looking only at
+ * that possibility and its descendants, so for a distributive expression `s[expr]` is the
+ * union of the updates of the singletons `{p}` for `p` in `s`, and evaluation fails on `s`
+ * iff it fails on one of these singletons. In particular, a state supports a distributive
+ * expression iff each of its possibilities does, and is consistent with it iff one of them is.
+ *
+ * Epistemic modals are tests on the whole input state, and break this property.
+ *
+ * @param expr The expression to inspect.
+ * @return True if the expression contains no epistemic modals or invalid operators, false otherwise.
+ */
+bool isDistributive(const QMLExpression::Expression& expr)
+{
+    return std::visit(DistributivityChecker(), expr);
+}
+
+}
@@ -0,0 +1,69 @@
+#include "evaluation_arena.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace iif_sadaf::talk::GSV {
+
+namespace {
+
+/**
+ * @brief Ids of arenas are never reused, so a stale entry of `ThreadBuffer` never matches a newer arena at the same address.
+ */
+std::atomic<std::uint64_t> next_arena_id = 1;
+
+/**
+ * @brief The buffer of the last arena a thread other than its owner allocated from.
+ */
+struct ThreadBuffer {
+    std::uint64_t arena = 0;
+    std::pmr::memory_resource* buffer = nullptr;
+};
+
+thread_local ThreadBuffer thread_buffer;
+
+} // ANONYMOUS NAMESPACE
+
+EvaluationArena::EvaluationArena()
+    : m_Id(next_arena_id.fetch_add(1, std::memory_order_relaxed))
+    , m_Owner(std::this_thread::get_id())
+    , m_OwnerBuffer(m_Inline.data(), m_Inline.size(), std::pmr::new_delete_resource())
+{ }
+
+void* EvaluationArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    return buffer().allocate(bytes, alignment);
+}
+
+void EvaluationArena::do_deallocate(void*, std::size_t, std::size_t)
+{ }
+
+bool EvaluationArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+/**
+ * @brief The buffer of the calling thread, created on its first allocation.
+ */
+std::pmr::memory_resource& EvaluationArena::buffer()
+{
+    const std::thread::id thread = std::this_thread::get_id();
+    if (thread == m_Owner) {
+        return m_OwnerBuffer;
+    }
+    if (thread_buffer.arena == m_Id) {
+        return *thread_buffer.buffer;
+    }
+
+    const std::lock_guard lock(m_Mutex);
+    auto it = std::ranges::find(m_Buffers, thread, &decltype(m_Buffers)::value_type::first);
+    if (it == m_Buffers.end()) {
+        m_Buffers.emplace_back(thread, std::make_unique<std::pmr::monotonic_buffer_resource>(std::pmr::new_delete_resource()));
+        it = std::prev(m_Buffers.end());
+    }
+    thread_buffer = { m_Id, it->second.get() };
+    return *it->second;
+}
+
+}
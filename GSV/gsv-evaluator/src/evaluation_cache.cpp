@@ -0,0 +1,238 @@
+#include "evaluation_cache.hpp"
+
+#include <algorithm>
+#include <type_traits>
+#include <variant>
+
+namespace iif_sadaf::talk::GSV {
+
+namespace {
+
+void appendTerm(std::string& structure, const QMLExpression::Term& term)
+{
+    structure += std::to_string(static_cast<int>(term.type));
+    structure += ':';
+    structure += std::to_string(term.literal.size());
+    structure += ':';
+    structure += term.literal;
+}
+
+void appendId(std::string& structure, std::uint64_t id)
+{
+    structure += std::to_string(id);
+    structure += ',';
+}
+
+} // ANONYMOUS NAMESPACE
+
+/**
+ * @brief Returns the structural id of an expression, assigning a new one if needed.
+ *
+ * @param expr The expression to intern.
+ * @return An id shared by all expressions structurally equal to `expr`.
+ */
+std::uint64_t ExpressionInterner::intern(const QMLExpression::Expression& expr)
+{
+    std::scoped_lock lock(m_Mutex);
+    const std::uint64_t id = internLocked(expr);
+    if (m_NodeIds.size() > m_SweepThreshold) {
+        sweepExpiredNodes();
+    }
+    return id;
+}
+
+/**
+ * @brief Returns the number of distinct structures interned so far.
+ */
+std::size_t ExpressionInterner::size() const
+{
+    std::scoped_lock lock(m_Mutex);
+    return m_Ids.size();
+}
+
+void ExpressionInterner::clear()
+{
+    std::scoped_lock lock(m_Mutex);
+    m_Ids.clear();
+    m_NodeIds.clear();
+}
+
+std::uint64_t ExpressionInterner::internLocked(const QMLExpression::Expression& expr)
+{
+    return std::visit([&]<typename Node>(const std::shared_ptr<Node>& node) -> std::uint64_t {
+        const auto known = m_NodeIds.find(node.get());
+        if (known != m_NodeIds.end() && !known->second.node.expired()) {
+            return known->second.id;
+        }
+
+        // Children are interned first, so a structure is fully described by the node's
+        // own fields and the ids of its children
+        std::string structure;
+        if constexpr (std::is_same_v<Node, QMLExpression::UnaryNode>) {
+            structure = "U" + std::to_string(static_cast<int>(node->op)) + "|";
+            appendId(structure, internLocked(node->scope));
+        }
+        else if constexpr (std::is_same_v<Node, QMLExpression::BinaryNode>) {
+            structure = "B" + std::to_string(static_cast<int>(node->op)) + "|";
+            appendId(structure, internLocked(node->lhs));
+            appendId(structure, internLocked(node->rhs));
+        }
+        else if constexpr (std::is_same_v<Node, QMLExpression::QuantificationNode>) {
+            structure = "Q" + std::to_string(static_cast<int>(node->quantifier)) + "|";
+            appendTerm(structure, node->variable);
+            structure += '|';
+            appendId(structure, internLocked(node->scope));
+        }
+        else if constexpr (std::is_same_v<Node, QMLExpression::IdentityNode>) {
+            structure = "I|";
+            appendTerm(structure, node->lhs);
+            structure += '|';
+            appendTerm(structure, node->rhs);
+        }
+        else {
+            structure = "P" + std::to_string(node->predicate.size()) + ":" + node->predicate + "|";
+            for (const QMLExpression::Term& argument : node->arguments) {
+                appendTerm(structure, argument);
+                structure += '|';
+            }
+        }
+
+        const std::uint64_t id = idOf(std::move(structure));
+        m_NodeIds.insert_or_assign(node.get(), NodeEntry{ .node = node, .id = id });
+        return id;
+    }, expr);
+}
+
+std::uint64_t ExpressionInterner::idOf(std::string&& structure)
+{
+    const auto [it, inserted] = m_Ids.try_emplace(std::move(structure), m_Ids.size());
+    return it->second;
+}
+
+/**
+ * @brief Forgets the addresses of destroyed nodes, whose memory may be reused.
+ */
+void ExpressionInterner::sweepExpiredNodes()
+{
+    std::erase_if(m_NodeIds, [](const auto& item) { return item.second.node.expired(); });
+    m_SweepThreshold = std::max<std::size_t>(1024, 2 * m_NodeIds.size());
+}
+
+/**
+ * @brief Creates an empty cache.
+ *
+ * @param capacity Maximum number of possibilities held, over all entries.
+ */
+EvaluationCache::EvaluationCache(std::size_t capacity)
+    : m_Capacity(capacity)
+{ }
+
+/**
+ * @brief Computes the cache key of evaluating an expression on a state, in a model.
+ */
+EvaluationCache::Key EvaluationCache::key(const QMLExpression::Expression& expr, const InformationState& state, const IModel& model)
+{
+    return { .expression = m_Interner.intern(expr), .model = &model, .state = hashValue(state) };
+}
+
+/**
+ * @brief Looks up a cached result.
+ *
+ * @param key The key of the evaluation, as returned by `key()`.
+ * @param state The input state of the evaluation, compared against the stored one.
+ * @return A copy of the cached result, or nullopt on a miss.
+ */
+std::optional<std::expected<InformationState, std::string>> EvaluationCache::find(const Key& key, const InformationState& state)
+{
+    std::scoped_lock lock(m_Mutex);
+
+    const auto it = m_Index.find(key);
+    if (it == m_Index.end() || it->second->input != state) {
+        ++m_Statistics.misses;
+        return std::nullopt;
+    }
+
+    m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+    ++m_Statistics.hits;
+    return it->second->result;
+}
+
+/**
+ * @brief Stores the result of an evaluation, evicting least recently used entries if needed.
+ *
+ * An existing entry with the same key is replaced. Results larger than the whole cache
+ * are not stored.
+ *
+ * @param key The key of the evaluation, as returned by `key()`.
+ * @param state The input state of the evaluation.
+ * @param result The result of the evaluation.
+ */
+void EvaluationCache::insert(const Key& key, InformationState state, std::expected<InformationState, std::string> result)
+{
+    const std::size_t cost = 1 + state.size() + (result.has_value() ? result.value().size() : 0);
+    if (cost > m_Capacity) {
+        return;
+    }
+
+    std::scoped_lock lock(m_Mutex);
+
+    const auto existing = m_Index.find(key);
+    if (existing != m_Index.end()) {
+        m_Statistics.possibilities -= existing->second->cost;
+        m_Entries.erase(existing->second);
+        m_Index.erase(existing);
+    }
+
+    evictLocked(cost);
+
+    m_Entries.push_front({ .key = key, .input = std::move(state), .result = std::move(result), .cost = cost });
+    m_Index.emplace(key, m_Entries.begin());
+    m_Statistics.possibilities += cost;
+    m_Statistics.entries = m_Entries.size();
+}
+
+void EvaluationCache::clear()
+{
+    std::scoped_lock lock(m_Mutex);
+    m_Entries.clear();
+    m_Index.clear();
+    m_Statistics.entries = 0;
+    m_Statistics.possibilities = 0;
+    m_Interner.clear();
+}
+
+std::size_t EvaluationCache::capacity() const
+{
+    return m_Capacity;
+}
+
+/**
+ * @brief Returns a snapshot of the hit, miss and eviction counters, and of the cache size.
+ */
+EvaluationCache::Statistics EvaluationCache::statistics() const
+{
+    std::scoped_lock lock(m_Mutex);
+    return m_Statistics;
+}
+
+std::size_t EvaluationCache::KeyHash::operator()(const Key& key) const
+{
+    std::size_t seed = std::hash<std::uint64_t>()(key.expression);
+    seed ^= std::hash<const IModel*>()(key.model) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    seed ^= key.state + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    return seed;
+}
+
+void EvaluationCache::evictLocked(std::size_t required)
+{
+    while (!m_Entries.empty() && m_Statistics.possibilities + required > m_Capacity) {
+        const Entry& victim = m_Entries.back();
+        m_Statistics.possibilities -= victim.cost;
+        m_Index.erase(victim.key);
+        m_Entries.pop_back();
+        ++m_Statistics.evictions;
+    }
+    m_Statistics.entries = m_Entries.size();
+}
+
+}
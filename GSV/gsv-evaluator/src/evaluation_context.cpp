@@ -0,0 +1,131 @@
+#include "evaluation_context.hpp"
+
+#include <format>
+#include <utility>
+
+namespace iif_sadaf::talk::GSV {
+
+EvaluationContext::EvaluationContext(EvaluationLimits limits)
+    : m_Limits(std::move(limits))
+    , m_Start(std::chrono::steady_clock::now())
+{ }
+
+/**
+ * @brief Asks for admission of the evaluation of a subformula.
+ * @param count The cardinality of the state the subformula is evaluated on.
+ * @return Whether the evaluation may go on.
+ */
+bool EvaluationContext::admitPossibilities(std::uint64_t count)
+{
+    if (interrupted()) {
+        return false;
+    }
+
+    const std::uint64_t possibilities = m_Possibilities.fetch_add(count, std::memory_order_relaxed) + count;
+    if (m_Limits.maxPossibilities != 0 && possibilities > m_Limits.maxPossibilities) {
+        interrupt(Status::BUDGET_EXCEEDED);
+        return false;
+    }
+
+    const std::uint64_t admissions = m_Admissions.fetch_add(1, std::memory_order_relaxed) + 1;
+    return admit(admissions, admissions % DEADLINE_STRIDE == 1);
+}
+
+/**
+ * @brief Asks for admission of the check of an information state by a relation.
+ * @return Whether the check may go on.
+ */
+bool EvaluationContext::admitState()
+{
+    if (interrupted()) {
+        return false;
+    }
+
+    const std::uint64_t states = m_States.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (m_Limits.maxStates != 0 && states > m_Limits.maxStates) {
+        interrupt(Status::BUDGET_EXCEEDED);
+        return false;
+    }
+
+    const std::uint64_t admissions = m_Admissions.fetch_add(1, std::memory_order_relaxed) + 1;
+    return admit(admissions, true);
+}
+
+EvaluationContext::Status EvaluationContext::status() const
+{
+    return m_Status.load(std::memory_order_acquire);
+}
+
+bool EvaluationContext::interrupted() const
+{
+    return status() != Status::RUNNING;
+}
+
+/**
+ * @brief The error message of the calls interrupted by this context.
+ */
+std::string EvaluationContext::message() const
+{
+    return std::format("{}: {}", INTERRUPTION_MESSAGE, str(status()));
+}
+
+EvaluationProgress EvaluationContext::progress() const
+{
+    return EvaluationProgress {
+        .possibilities = m_Possibilities.load(std::memory_order_relaxed),
+        .states = m_States.load(std::memory_order_relaxed),
+        .elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_Start)
+    };
+}
+
+/**
+ * @brief Checks cancellation, and the deadline if asked to, then reports progress if due.
+ */
+bool EvaluationContext::admit(std::uint64_t admissions, bool check_deadline)
+{
+    if (m_Limits.stopToken.stop_requested()) {
+        interrupt(Status::CANCELLED);
+        return false;
+    }
+    if (check_deadline && m_Limits.deadline.has_value() && std::chrono::steady_clock::now() >= m_Limits.deadline.value()) {
+        interrupt(Status::DEADLINE_EXCEEDED);
+        return false;
+    }
+    report(admissions);
+    return true;
+}
+
+/**
+ * @brief Records why the context stopped admitting work. The first reason recorded is kept.
+ */
+void EvaluationContext::interrupt(Status status)
+{
+    Status running = Status::RUNNING;
+    m_Status.compare_exchange_strong(running, status, std::memory_order_acq_rel);
+}
+
+void EvaluationContext::report(std::uint64_t admissions)
+{
+    if (!m_Limits.progress || m_Limits.progressInterval == 0 || admissions % m_Limits.progressInterval != 0) {
+        return;
+    }
+    std::scoped_lock lock(m_ProgressMutex);
+    m_Limits.progress(progress());
+}
+
+std::string_view str(EvaluationContext::Status status)
+{
+    switch (status) {
+    case EvaluationContext::Status::RUNNING:
+        return "running";
+    case EvaluationContext::Status::DEADLINE_EXCEEDED:
+        return "deadline exceeded";
+    case EvaluationContext::Status::BUDGET_EXCEEDED:
+        return "budget exceeded";
+    case EvaluationContext::Status::CANCELLED:
+        return "cancelled";
+    }
+    return "unknown";
+}
+
+}
@@ -0,0 +1,20 @@
+#include "evaluation_failure.hpp"
+
+#include <format>
+
+#include <QMLExpression/formatter.hpp>
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief The error message of an evaluation of `expr` that failed because of `cause`.
+ *
+ * Every evaluator reports the failures of a subformula through this function, so that
+ * they all report the same failure with the same message.
+ */
+std::string explain_failure(const QMLExpression::Expression& expr, const std::string& cause)
+{
+    return std::format("In evaluating formula {}:\n{}", QMLExpression::format(expr), cause);
+}
+
+}
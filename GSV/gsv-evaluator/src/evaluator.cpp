@@ -1,38 +1,284 @@
 #include "evaluator.hpp"
 
 #include <algorithm>
+#include <array>
 #include <expected>
 #include <format>
-#include <functional>
+#include <optional>
 #include <ranges>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 #include <QMLExpression/formatter.hpp>
 
+#include "columnar_state.hpp"
+#include "evaluation_failure.hpp"
+#include "idense_model.hpp"
+#include "iindexed_model.hpp"
 #include "possibility.hpp"
+#include "possibility_set.hpp"
 
 namespace iif_sadaf::talk::GSV {
 
 namespace {
 
-    std::string explain_failure(const std::string& formula, const std::string cause) {
-        return std::format("In evaluating formula {}:\n{}", formula, cause);
+/**
+ * @brief Predications of up to this many arguments are checked against an extension index with a tuple on the stack.
+ */
+constexpr std::size_t MAX_STACK_ARITY = 8;
+
+/**
+ * @brief Atomic formulas are checked on states of at least this many possibilities through a `ColumnarState`.
+ */
+constexpr std::size_t MIN_COLUMNAR_SIZE = 16;
+
+/**
+ * @brief The number of possibilities allocated by the evaluator on this thread, for the trace events of profilers.
+ */
+thread_local std::uint64_t allocated_possibilities = 0;
+
+/**
+ * @brief True if states of type State are borrowed (hypothetical mode) rather than owned.
+ */
+template<typename State>
+constexpr bool isBorrowed = std::is_lvalue_reference_v<State>;
+
+template<typename State>
+void assertEvaluationState()
+{
+    static_assert(std::is_same_v<std::remove_cvref_t<State>, InformationState>);
+    static_assert(!isBorrowed<State> || std::is_const_v<std::remove_reference_t<State>>,
+                  "Borrowed information states must be const");
+}
+
+/**
+ * @brief Keeps the possibilities of a state that satisfy a predicate.
+ *
+ * An owned state is filtered in place and moved into the result. A borrowed state is
+ * left untouched, and only the surviving possibilities are copied into the result.
+ *
+ * With `first_only`, filtering stops at the first surviving possibility, and the result
+ * holds that possibility alone. This is enough for callers that only test the result
+ * for emptiness.
+ *
+ * The result of filtering a borrowed state is allocated from `resource`.
+ */
+template<typename State, typename Predicate>
+InformationState filter(State&& state, const Predicate& predicate, std::pmr::memory_resource* resource, bool first_only = false)
+{
+    assertEvaluationState<State>();
+
+    if constexpr (isBorrowed<State>) {
+        InformationState output(resource);
+        for (const Possibility& p : state) {
+            if (predicate(p)) {
+                output.insert(output.end(), p);
+                if (first_only) {
+                    break;
+                }
+            }
+        }
+        allocated_possibilities += output.size();
+        return output;
+    }
+    else {
+        for (auto it = state.begin(); it != state.end(); ) {
+            if (!predicate(*it)) {
+                it = state.erase(it);
+            }
+            else if (first_only) {
+                state.erase(std::next(it), state.end());
+                break;
+            }
+            else {
+                ++it;
+            }
+        }
+        return std::move(state);
+    }
+}
+
+/**
+ * @brief Keeps the possibilities of a state whose row is set in a selection mask.
+ */
+template<typename State>
+InformationState select(State&& state, std::span<const std::uint8_t> selection, std::pmr::memory_resource* resource)
+{
+    std::size_t row = 0;
+    return filter(std::forward<State>(state), [&](const Possibility&) { return selection[row++] != 0; }, resource);
+}
+
+/**
+ * @brief Returns a state unchanged: an owned state is moved, a borrowed state is copied.
+ *
+ * With `first_only`, only the first possibility of a non-empty state is kept. Copies are
+ * allocated from `resource`.
+ */
+template<typename State>
+InformationState keep(State&& state, std::pmr::memory_resource* resource, bool first_only = false)
+{
+    assertEvaluationState<State>();
+
+    if (first_only && state.size() > 1) {
+        return filter(std::forward<State>(state), [](const Possibility&) { return true; }, resource, true);
+    }
+
+    if constexpr (isBorrowed<State>) {
+        allocated_possibilities += state.size();
+        return InformationState(state, resource);
+    }
+    else {
+        return std::move(state);
+    }
+}
+
+/**
+ * @brief The update of a state with an assignment of a variable, allocated from `resource`.
+ */
+InformationState variant(const InformationState& state, SymbolId variable, int individual, std::pmr::memory_resource* resource)
+{
+    allocated_possibilities += state.size();
+    return update(state, variable, individual, resource);
+}
+
+/**
+ * @brief Swaps two individuals in an assignment. Returns whether the assignment changed.
+ */
+bool swapIndividuals(Assignment& assignment, int a, int b)
+{
+    bool changed = false;
+    for (std::size_t i = 0; i < assignment.slots().size(); ++i) {
+        const int individual = assignment.slots()[i];
+        if (individual == a || individual == b) {
+            assignment.assign(static_cast<int>(i + 1), individual == a ? b : a);
+            changed = changed || a != b;
+        }
+    }
+    return changed;
+}
+
+/**
+ * @brief Determines whether swapping two individuals in every assignment maps a state onto itself.
+ *
+ * @param state The state.
+ * @param possibilities The possibilities of `state`, tested for the images of the swap.
+ */
+bool fixedBySwap(const InformationState& state, const PossibilitySet& possibilities, int a, int b)
+{
+    for (const Possibility& p : state) {
+        Possibility image = p;
+        if (swapIndividuals(image.assignment, a, b) && !possibilities.contains(image)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief The image of an update under the swap of two individuals in every assignment, allocated from `resource`.
+ *
+ * Failed updates are copied as they are.
+ */
+std::expected<InformationState, std::string> transpose(const std::expected<InformationState, std::string>& update, int a, int b, std::pmr::memory_resource* resource)
+{
+    if (!update.has_value()) {
+        return update;
+    }
+    InformationState output(resource);
+    for (const Possibility& p : update.value()) {
+        Possibility image = p;
+        swapIndividuals(image.assignment, a, b);
+        output.insert(output.end(), std::move(image));
     }
+    allocated_possibilities += output.size();
+    return output;
+}
 
-void filter(InformationState& state, const std::function<bool(const Possibility&)>& predicate) {
-    for (auto it = state.begin(); it != state.end(); ) {
-        if (!predicate(*it)) {
-            it = state.erase(it);
+/**
+ * @brief The union of the successful updates of the branches of an existential quantifier, allocated from `resource`.
+ *
+ * The updates are ordered, so they are merged in a single pass, and every possibility is
+ * inserted at the end of the union, in amortized constant time. Identical possibilities
+ * of several branches are adjacent in the pass, and are kept once. Nodes are moved out of
+ * the updates sharing the memory resource of the union, and copied out of the others.
+ */
+InformationState unite(std::vector<std::expected<InformationState, std::string>>& updates, std::pmr::memory_resource* resource)
+{
+    InformationState output(resource);
+
+    struct Cursor {
+        InformationState* state;
+        InformationState::iterator next;
+    };
+    std::vector<Cursor> heap;
+    for (auto& update : updates) {
+        if (!update.value().empty()) {
+            heap.push_back({ &update.value(), update.value().begin() });
+        }
+    }
+    if (heap.size() == 1 && heap.front().state->get_allocator() == output.get_allocator()) {
+        return std::move(*heap.front().state);
+    }
+
+    const auto later = [](const Cursor& c1, const Cursor& c2) -> bool { return *c2.next < *c1.next; };
+    std::ranges::make_heap(heap, later);
+    while (!heap.empty()) {
+        std::ranges::pop_heap(heap, later);
+        Cursor& cursor = heap.back();
+        const auto it = cursor.next++;
+        if (output.empty() || *std::prev(output.end()) < *it) {
+            if (cursor.state->get_allocator() == output.get_allocator()) {
+                output.insert(output.end(), cursor.state->extract(it));
+            }
+            else {
+                output.insert(output.end(), *it);
+                ++allocated_possibilities;
+            }
+        }
+        if (cursor.next == cursor.state->end()) {
+            heap.pop_back();
         }
         else {
-            ++it;
+            std::ranges::push_heap(heap, later);
         }
     }
+    return output;
 }
 
-QMLExpression::Expression negate(const QMLExpression::Expression& expr)
+/**
+ * @brief The denotations of a constant at every world, fetched once from a dense model.
+ */
+struct TermTable {
+    const int* denotations = nullptr;
+    int worlds = 0;
+};
+
+TermTable termTable(const Program::Term& term, const IDenseModel* dense_model)
 {
-    return std::make_shared<QMLExpression::UnaryNode>(QMLExpression::Operator::NEGATION, expr);
+    if (dense_model == nullptr || term.variable) {
+        return {};
+    }
+    return { dense_model->termTable(term.symbol), dense_model->worldCardinality() };
+}
+
+/**
+ * @brief The denotation of a term at a possibility: read from its table if it has one, looked
+ *        up by id in indexed models, by name otherwise.
+ */
+std::expected<int, std::string> termDenotation(const Program::Term& term, const Possibility& p, const IModel* model, const IIndexedModel* indexed_model, const TermTable& table = {})
+{
+    if (term.variable) {
+        return variableDenotation(term.symbol, p);
+    }
+    if (table.denotations != nullptr && p.world >= 0 && p.world < table.worlds) {
+        return table.denotations[p.world];
+    }
+    if (indexed_model != nullptr) {
+        return indexed_model->termInterpretationById(term.symbol, p.world);
+    }
+    return model->termInterpretation(term.name, p.world);
 }
 
 void startLog(simple_logger::SimpleLogger* logger, const std::string& formula, const InformationState& state)
@@ -47,25 +293,397 @@ void endLog(simple_logger::SimpleLogger* logger, const std::string& formula, con
     logger->info("Output information state is:\n" + str(state, false));
 }
 
-template<typename Visitor>
-std::expected<InformationState, std::string> visit(const QMLExpression::Expression& expr,
-                                                   std::pair<InformationState,
-                                                   const IModel*> params,
-                                                   Visitor&& visitor)
+/**
+ * @brief Copies the result of an evaluation out of an arena, onto the default memory resource.
+ */
+std::expected<InformationState, std::string> detach(std::expected<InformationState, std::string>&& result, const EvaluationArena& arena)
 {
-    return std::visit([&](const auto& node) { return visitor(node, params); }, expr);
+    if (result.has_value() && result.value().get_allocator().resource() == &arena) {
+        return InformationState(result.value(), std::pmr::get_default_resource());
+    }
+    return std::move(result);
 }
 
 } // ANONYMOUS NAMESPACE
 
+Evaluator::Evaluator(simple_logger::SimpleLogger* logger)
+    : m_Options({ .logger = logger })
+{ }
+
+Evaluator::Evaluator(const EvaluationOptions& options)
+    : m_Options(options)
+{ }
+
+/**
+ * @brief Constructs an evaluator allocating the states it creates from a memory resource.
+ *
+ * States owned by the caller are still filtered in place, on their own resource.
+ */
+Evaluator::Evaluator(const EvaluationOptions& options, std::pmr::memory_resource* resource)
+    : m_Options(options)
+    , m_Resource(resource)
+{ }
+
+/**
+ * @brief Evaluates a unary node. See `Evaluator::applyUnary()` for the semantic clauses.
+ */
+std::expected<InformationState, std::string> Evaluator::operator()(const std::shared_ptr<QMLExpression::UnaryNode>& expr, std::pair<InformationState, const IModel*> params) const
+{
+    const Program program(expr);
+    return evaluateNode(program, program.root(), std::move(params.first), params.second);
+}
+
+/**
+ * @brief Evaluates a binary node. See `Evaluator::applyBinary()` for the semantic clauses.
+ */
+std::expected<InformationState, std::string> Evaluator::operator()(const std::shared_ptr<QMLExpression::BinaryNode>& expr, std::pair<InformationState, const IModel*> params) const
+{
+    const Program program(expr);
+    return evaluateNode(program, program.root(), std::move(params.first), params.second);
+}
+
+/**
+ * @brief Evaluates a quantification node. See `Evaluator::applyQuantification()` for the semantic clauses.
+ */
+std::expected<InformationState, std::string> Evaluator::operator()(const std::shared_ptr<QMLExpression::QuantificationNode>& expr, std::pair<InformationState, const IModel*> params) const
+{
+    const Program program(expr);
+    return evaluateNode(program, program.root(), std::move(params.first), params.second);
+}
+
+/**
+ * @brief Evaluates an identity node. See `Evaluator::applyIdentity()` for the semantic clauses.
+ */
+std::expected<InformationState, std::string> Evaluator::operator()(const std::shared_ptr<QMLExpression::IdentityNode>& expr, std::pair<InformationState, const IModel*> params) const
+{
+    const Program program(expr);
+    return evaluateNode(program, program.root(), std::move(params.first), params.second);
+}
+
+/**
+ * @brief Evaluates a predication node. See `Evaluator::applyPredication()` for the semantic clauses.
+ */
+std::expected<InformationState, std::string> Evaluator::operator()(const std::shared_ptr<QMLExpression::PredicationNode>& expr, std::pair<InformationState, const IModel*> params) const
+{
+    const Program program(expr);
+    return evaluateNode(program, program.root(), std::move(params.first), params.second);
+}
+
+/**
+ * @brief Evaluates an expression, taking ownership of the input state.
+ *
+ * The input state is filtered in place wherever the semantic clauses allow it, and moved
+ * into the result.
+ */
+std::expected<InformationState, std::string> Evaluator::evaluateOwned(const QMLExpression::Expression& expr, InformationState&& state, const IModel& model) const
+{
+    return evaluateOwned(Program(expr), std::move(state), model);
+}
+
+/**
+ * @brief Evaluates an expression without modifying the input state.
+ *
+ * Only the possibilities that survive the update are copied into the result.
+ */
+std::expected<InformationState, std::string> Evaluator::evaluateHypothetical(const QMLExpression::Expression& expr, const InformationState& state, const IModel& model) const
+{
+    return evaluateHypothetical(Program(expr), state, model);
+}
+
+/**
+ * @brief Evaluates a compiled expression, taking ownership of the input state.
+ */
+std::expected<InformationState, std::string> Evaluator::evaluateOwned(const Program& program, InformationState&& state, const IModel& model) const
+{
+    const std::optional<SymmetryPlan> plan = symmetryPlan(program, model);
+    return reduced(plan).evaluateNode(program, program.root(), std::move(state), &model);
+}
+
+/**
+ * @brief Evaluates a compiled expression without modifying the input state.
+ */
+std::expected<InformationState, std::string> Evaluator::evaluateHypothetical(const Program& program, const InformationState& state, const IModel& model) const
+{
+    const std::optional<SymmetryPlan> plan = symmetryPlan(program, model);
+    return reduced(plan).evaluateNode(program, program.root(), state, &model);
+}
+
+/**
+ * @brief Determines whether the update of a state with a compiled expression is non-empty.
+ *
+ * With `shortCircuit` in the options, the expression is only evaluated up to its first
+ * surviving possibility (see `EvaluationOptions`).
+ */
+std::expected<bool, std::string> Evaluator::evaluateNonEmpty(const Program& program, const InformationState& state, const IModel& model) const
+{
+    const std::optional<SymmetryPlan> plan = symmetryPlan(program, model);
+    Evaluator evaluator = reduced(plan);
+    evaluator.m_Probing = shortCircuits();
+    const auto update = evaluator.evaluateNode(program, program.root(), state, &model);
+    if (!update.has_value()) {
+        return std::unexpected(update.error());
+    }
+    return !update.value().empty();
+}
+
+/**
+ * @brief Evaluates an instruction in owning or hypothetical mode, going through the cache if one is attached.
+ *
+ * Atomic formulas are never cached: filtering a state with them is cheaper than
+ * looking the result up. Unless the evaluation is traced, well-formed instructions
+ * are not evaluated at all on the empty state, since their update is then empty.
+ * Instructions that are evaluated are first admitted by the context, if any, and
+ * interrupted evaluations are kept out of the cache.
+ */
+template<typename State>
+std::expected<InformationState, std::string> Evaluator::evaluateNode(const Program& program, std::uint32_t node, State&& state, const IModel* model) const
+{
+    assertEvaluationState<State>();
+
+    const bool traces = tracesEvents() || tracesVerbose();
+    if (state.empty() && program[node].wellFormed && !traces) {
+        return InformationState();
+    }
+
+    EvaluationContext* context = m_Options.context;
+    if (context != nullptr && !context->admitPossibilities(state.size())) {
+        return std::unexpected(context->message());
+    }
+
+    // Probed results are partial, so they are kept out of the cache
+    EvaluationCache* cache = m_Options.cache;
+    if (cache == nullptr || isAtomic(program[node]) || tracesVerbose() || m_Probing) {
+        return traced(program, node, std::forward<State>(state), model);
+    }
+
+    const EvaluationCache::Key key = cache->key(program[node].source, state, *model);
+    if (auto cached = cache->find(key, state)) {
+        return std::move(cached.value());
+    }
+
+    // An entry costs at least its input state, so inputs over capacity are never copied.
+    // A borrowed input outlives the evaluation, so only an owned one is copied before it.
+    const bool admissible = 1 + state.size() <= cache->capacity();
+    const auto keeps = [&](const std::expected<InformationState, std::string>& result) {
+        return admissible && (result.has_value() || context == nullptr || !context->interrupted());
+    };
+
+    if constexpr (isBorrowed<State>) {
+        auto result = traced(program, node, state, model);
+        if (keeps(result)) {
+            cache->insert(key, state, result);
+        }
+        return result;
+    }
+    else {
+        std::optional<InformationState> input_state;
+        if (admissible) {
+            input_state.emplace(state);
+        }
+        auto result = traced(program, node, std::move(state), model);
+        if (keeps(result)) {
+            cache->insert(key, std::move(input_state.value()), result);
+        }
+        return result;
+    }
+}
+
+/**
+ * @brief Applies the semantic clause for an instruction, surrounded by the tracing enabled in the options.
+ *
+ * When tracing is off this is a direct call to `apply()`: neither the formula nor the
+ * information states are formatted.
+ */
+template<typename State>
+std::expected<InformationState, std::string> Evaluator::traced(const Program& program, std::uint32_t node, State&& state, const IModel* model) const
+{
+    const bool events = tracesEvents() || profiles();
+    const bool verbose = tracesVerbose();
+
+    if (!events && !verbose) {
+        return apply(program, node, std::forward<State>(state), model);
+    }
+
+    const std::uint64_t allocated_before = allocated_possibilities;
+
+    const Program::Instruction& instruction = program[node];
+    const void* node_id = std::visit([](const auto& source) -> const void* { return source.get(); }, instruction.source);
+    const std::size_t input_cardinality = state.size();
+    if (events) {
+        emit(TraceEvent::Type::ENTER, node_id, instruction.traceOperator, input_cardinality, 0);
+    }
+    if (verbose) {
+        startLog(m_Options.logger, QMLExpression::format(instruction.source), state);
+    }
+
+    auto result = apply(program, node, std::forward<State>(state), model);
+
+    if (!result.has_value()) {
+        if (events) {
+            emit(TraceEvent::Type::FAILURE, node_id, instruction.traceOperator, input_cardinality, 0);
+        }
+        return result;
+    }
+
+    if (events) {
+        emit(TraceEvent::Type::EXIT, node_id, instruction.traceOperator, input_cardinality, result.value().size(), allocated_possibilities - allocated_before);
+    }
+    if (verbose) {
+        endLog(m_Options.logger, QMLExpression::format(instruction.source), result.value());
+    }
+    return result;
+}
+
+/**
+ * @brief Dispatches an instruction to the semantic clause of its opcode.
+ */
+template<typename State>
+std::expected<InformationState, std::string> Evaluator::apply(const Program& program, std::uint32_t node, State&& state, const IModel* model) const
+{
+    const Program::Instruction& instruction = program[node];
+
+    switch (instruction.opcode) {
+    case Program::Opcode::NEGATION:
+    case Program::Opcode::EPISTEMIC_POSSIBILITY:
+    case Program::Opcode::EPISTEMIC_NECESSITY:
+    case Program::Opcode::INVALID_UNARY:
+        return applyUnary(program, instruction, std::forward<State>(state), model);
+    case Program::Opcode::CONJUNCTION:
+    case Program::Opcode::DISJUNCTION:
+    case Program::Opcode::CONDITIONAL:
+    case Program::Opcode::INVALID_BINARY:
+        return applyBinary(program, instruction, std::forward<State>(state), model);
+    case Program::Opcode::EXISTENTIAL:
+    case Program::Opcode::UNIVERSAL:
+    case Program::Opcode::INVALID_QUANTIFIER:
+        return applyQuantification(program, instruction, std::forward<State>(state), model);
+    case Program::Opcode::IDENTITY:
+        return applyIdentity(program, instruction, std::forward<State>(state), model);
+    case Program::Opcode::PREDICATION:
+        return applyPredication(program, instruction, std::forward<State>(state), model);
+    }
+    return std::unexpected(explain_failure(instruction.source, "Invalid instruction"));
+}
+
+Evaluator Evaluator::descend() const
+{
+    Evaluator child = *this;
+    ++child.m_Depth;
+    child.m_Probing = false;
+    return child;
+}
+
+/**
+ * @brief An evaluator for a subformula whose update is only tested for emptiness.
+ *
+ * A probing evaluator returns an arbitrary non-empty subset of the update when the update
+ * is not empty, so filtering stops at the first surviving possibility.
+ */
+Evaluator Evaluator::probe() const
+{
+    Evaluator child = descend();
+    child.m_Probing = true;
+    return child;
+}
+
+/**
+ * @brief The symmetry plan of a program, if the options carry a symmetry index of the model and the evaluation is not traced.
+ */
+std::optional<SymmetryPlan> Evaluator::symmetryPlan(const Program& program, const IModel& model) const
+{
+    const SymmetryIndex* symmetry = m_Options.symmetry;
+    if (symmetry == nullptr || &symmetry->model() != &model || tracesEvents() || tracesVerbose()) {
+        return std::nullopt;
+    }
+    return symmetry->plan(program);
+}
+
+/**
+ * @brief An evaluator reducing quantifiers with a symmetry plan, or with none if there is no plan.
+ */
+Evaluator Evaluator::reduced(const std::optional<SymmetryPlan>& plan) const
+{
+    Evaluator evaluator = *this;
+    evaluator.m_Symmetry = plan.has_value() ? &plan.value() : nullptr;
+    return evaluator;
+}
+
+/**
+ * @brief True if subformulas tested for emptiness are probed rather than fully evaluated.
+ */
+bool Evaluator::shortCircuits() const
+{
+    return m_Options.shortCircuit && !tracesEvents() && !tracesVerbose();
+}
+
+/**
+ * @brief The memory resource of the states created by the evaluator.
+ */
+std::pmr::memory_resource* Evaluator::resource() const
+{
+    return m_Resource != nullptr ? m_Resource : std::pmr::get_default_resource();
+}
+
+/**
+ * @brief Sends a trace event to the trace sink, if events are traced, and to the profiler, if one is attached.
+ */
+void Evaluator::emit(TraceEvent::Type type, const void* node, TraceOperator op, std::size_t input_cardinality, std::size_t output_cardinality, std::size_t allocated) const
+{
+    const TraceEvent event{
+        .type = type,
+        .nodeId = reinterpret_cast<std::uintptr_t>(node),
+        .op = op,
+        .depth = m_Depth,
+        .inputCardinality = input_cardinality,
+        .outputCardinality = output_cardinality,
+        .allocatedPossibilities = allocated
+    };
+    if (tracesEvents()) {
+        m_Options.traceSink->record(event);
+    }
+    if (profiles()) {
+        m_Options.profiler->record(event);
+    }
+}
+
+bool Evaluator::tracesEvents() const
+{
+    if constexpr (MAX_TRACE_LEVEL < TraceLevel::EVENTS) {
+        return false;
+    }
+    return m_Options.traceSink != nullptr && m_Options.traceLevel >= TraceLevel::EVENTS;
+}
+
+bool Evaluator::profiles() const
+{
+    return m_Options.profiler != nullptr;
+}
+
+bool Evaluator::tracesVerbose() const
+{
+    if constexpr (MAX_TRACE_LEVEL < TraceLevel::VERBOSE) {
+        return false;
+    }
+    return m_Options.logger != nullptr && m_Options.traceLevel >= TraceLevel::VERBOSE;
+}
+
+void Evaluator::log(std::string_view message) const
+{
+    if (tracesVerbose()) {
+        m_Options.logger->info(std::string(message));
+    }
+}
+
 /**
  * @brief Evaluates a unary logical expression and updates the information state accordingly.
  *
  * This function applies a unary operator (such as necessity, possibility, or negation)
  * to an expression and modifies the provided information state based on the result.
  *
- * @param expr A shared pointer to a QMLExpression::UnaryNode representing the unary expression.
- * @param params A variant containing a pair of the current InformationState and a pointer to the model (IModel).
+ * @param program The program the instruction belongs to.
+ * @param instruction The unary instruction.
+ * @param input_state The current InformationState, owned (filtered in place) or borrowed (left untouched).
+ * @param model A pointer to the model (IModel).
  * @return std::expected<InformationState, std::string> The updated information state if evaluation is successful,
  *         or an error message if evaluation fails.
  *
@@ -78,51 +696,45 @@ std::expected<InformationState, std::string> visit(const QMLExpression::Expressi
  *
  *          If an unrecognized operator is encountered, an error message is returned.
  */
-std::expected<InformationState, std::string> Evaluator::operator()(const std::shared_ptr<QMLExpression::UnaryNode>& expr, std::pair<InformationState, const IModel*> params) const
+template<typename State>
+std::expected<InformationState, std::string> Evaluator::applyUnary(const Program& program, const Program::Instruction& instruction, State&& input_state, const IModel* model) const
 {
-    const std::string formula = QMLExpression::format(QMLExpression::Expression(expr));
-    InformationState& input_state = params.first;
-
-    startLog(m_Logger, formula, input_state);
+    const QMLExpression::Expression& expr = instruction.source;
 
-    m_Logger->info("Calculating prejacent update");
-    const auto prejacent_update = visit(expr->scope, params, Evaluator(m_Logger));
-    m_Logger->info(std::format("Returning to evaluation of {}", formula));
+    log("Calculating prejacent update");
+    const Evaluator prejacent_evaluator = instruction.opcode == Program::Opcode::EPISTEMIC_POSSIBILITY && shortCircuits() ? probe() : descend();
+    const auto prejacent_update = prejacent_evaluator.evaluateNode(program, instruction.lhs, std::as_const(input_state), model);
+    log([&] { return std::format("Returning to evaluation of {}", QMLExpression::format(expr)); });
 
     if (!prejacent_update.has_value()) {
-        return std::unexpected(explain_failure(formula, prejacent_update.error()));
+        return std::unexpected(explain_failure(expr, prejacent_update.error()));
     }
 
-    if (expr->op == QMLExpression::Operator::EPISTEMIC_POSSIBILITY) {
-        m_Logger->info("Applying test for epistemic possibilty: ");
+    if (instruction.opcode == Program::Opcode::EPISTEMIC_POSSIBILITY) {
+        log("Applying test for epistemic possibilty: ");
         if (prejacent_update.value().empty()) {
-            m_Logger->info("compatibility test failed");
-            input_state.clear();
-        }
-        else {
-            m_Logger->info("compatibility test passed");
+            log("compatibility test failed");
+            return InformationState();
         }
+        log("compatibility test passed");
     }
-    else if (expr->op == QMLExpression::Operator::EPISTEMIC_NECESSITY) {
-        m_Logger->info("Applying test for epistemic necessity: ");
+    else if (instruction.opcode == Program::Opcode::EPISTEMIC_NECESSITY) {
+        log("Applying test for epistemic necessity: ");
         if (!subsistsIn(input_state, prejacent_update.value())) {
-            m_Logger->info("support test failed");
-            input_state.clear();
-        }
-        else {
-            m_Logger->info("support test passed");
+            log("support test failed");
+            return InformationState();
         }
+        log("support test passed");
     }
-    else if (expr->op == QMLExpression::Operator::NEGATION) {
-        m_Logger->info("Filtering with negation of the prejacent");
-        filter(input_state, [&](const Possibility& p) -> bool { return !subsistsIn(p, prejacent_update.value()); });
+    else if (instruction.opcode == Program::Opcode::NEGATION) {
+        log("Filtering with negation of the prejacent");
+        return filter(std::forward<State>(input_state), [&](const Possibility& p) -> bool { return !subsistsIn(p, prejacent_update.value()); }, resource(), m_Probing);
     }
     else {
-        return std::unexpected(explain_failure(formula, "Invalid unary operator"));
+        return std::unexpected(explain_failure(expr, "Invalid unary operator"));
     }
 
-    endLog(m_Logger, formula, input_state);
-    return input_state;
+    return keep(std::forward<State>(input_state), resource(), m_Probing);
 }
 
 /**
@@ -131,8 +743,10 @@ std::expected<InformationState, std::string> Evaluator::operator()(const std::sh
  * This function applies binary logical operators (such as conjunction, disjunction, and implication)
  * to an expression and modifies the provided information state based on the result.
  *
- * @param expr A shared pointer to a QMLExpression::BinaryNode representing the binary expression.
- * @param params A variant containing a pair of the current InformationState and a pointer to the model (IModel).
+ * @param program The program the instruction belongs to.
+ * @param instruction The binary instruction.
+ * @param input_state The current InformationState, owned (filtered in place) or borrowed (left untouched).
+ * @param model A pointer to the model (IModel).
  * @return std::expected<InformationState, std::string> The updated information state if evaluation is successful,
  *         or an error message if evaluation fails.
  *
@@ -150,101 +764,107 @@ std::expected<InformationState, std::string> Evaluator::operator()(const std::sh
  *          If any evaluation fails at any step, the function returns an error message indicating which part of
  *          the formula caused the failure.
  */
-std::expected<InformationState, std::string> Evaluator::operator()(const std::shared_ptr<QMLExpression::BinaryNode>& expr, std::pair<InformationState, const IModel*> params) const
+template<typename State>
+std::expected<InformationState, std::string> Evaluator::applyBinary(const Program& program, const Program::Instruction& instruction, State&& input_state, const IModel* model) const
 {
-    const std::string formula = QMLExpression::format(QMLExpression::Expression(expr));
-    InformationState& input_state = params.first;
-    const IModel* model = params.second;
-
-    startLog(m_Logger, formula, input_state);
+    const QMLExpression::Expression& expr = instruction.source;
 
     // Conjunction is sequential update, treated separately
-    if (expr->op == QMLExpression::Operator::CONJUNCTION) {
-        m_Logger->info("Performing sequential update");
-        m_Logger->info("Updating with LHS");
-        const auto lhs_update = visit(expr->lhs, params, Evaluator(m_Logger));
-        m_Logger->info(std::format("Returning to evaluation of {}", formula));
+    if (instruction.opcode == Program::Opcode::CONJUNCTION) {
+        log("Performing sequential update");
+        log("Updating with LHS");
+        auto lhs_update = descend().evaluateNode(program, instruction.lhs, std::forward<State>(input_state), model);
+        log([&] { return std::format("Returning to evaluation of {}", QMLExpression::format(expr)); });
 
         if (!lhs_update.has_value()) {
-            return std::unexpected(explain_failure(formula, lhs_update.error()));
+            return std::unexpected(explain_failure(expr, lhs_update.error()));
         }
 
-        m_Logger->info("Updating with RHS");
-        const auto rhs_update = visit(expr->rhs, { lhs_update.value(), model }, Evaluator(m_Logger));
+        log("Updating with RHS");
+        const Evaluator rhs_evaluator = m_Probing ? probe() : descend();
+        auto rhs_update = rhs_evaluator.evaluateNode(program, instruction.rhs, std::move(lhs_update.value()), model);
 
         if (!rhs_update.has_value()) {
-            return std::unexpected(explain_failure(formula, rhs_update.error()));
+            return std::unexpected(explain_failure(expr, rhs_update.error()));
         }
 
-        endLog(m_Logger, formula, rhs_update.value());
-        return rhs_update.value();
+        return rhs_update;
     }
 
     // All other updates are filtering updates
-    m_Logger->info("Calculating hypothetical LHS update");
-    const auto hypothetical_lhs_update = visit(expr->lhs, params, Evaluator(m_Logger));
+    log("Calculating hypothetical LHS update");
+    const auto hypothetical_lhs_update = descend().evaluateNode(program, instruction.lhs, std::as_const(input_state), model);
 
     if (!hypothetical_lhs_update.has_value()) {
-        return std::unexpected(explain_failure(formula, hypothetical_lhs_update.error()));
+        return std::unexpected(explain_failure(expr, hypothetical_lhs_update.error()));
     }
 
-    m_Logger->info(std::format("Returning to evaluation of {}", formula));
+    log([&] { return std::format("Returning to evaluation of {}", QMLExpression::format(expr)); });
+
+    if (instruction.opcode == Program::Opcode::DISJUNCTION) {
+        log("Starting calculation of hypothetical RHS update");
+        log("Assuming negation of LHS");
+        std::expected<InformationState, std::string> negated_lhs_update;
+        if (tracesEvents() || tracesVerbose()) {
+            negated_lhs_update = descend().evaluateNode(program, instruction.negatedLhs, std::as_const(input_state), model);
+        }
+        else {
+            // The update with the negated LHS filters the input state with the LHS update,
+            // which is already known, so the LHS is not evaluated again
+            negated_lhs_update = filter(std::as_const(input_state), [&](const Possibility& p) -> bool {
+                return !subsistsIn(p, hypothetical_lhs_update.value());
+            }, resource());
+        }
+        log([&] { return std::format("Returning to evaluation of {}", QMLExpression::format(expr)); });
 
-    if (expr->op == QMLExpression::Operator::DISJUNCTION) {
-        m_Logger->info("Starting calculation of hypothetical RHS update");
-        m_Logger->info("Assuming negation of LHS");
-        const auto negated_lhs_update = visit(negate(expr->lhs), params, Evaluator(m_Logger));
-        m_Logger->info(std::format("Returning to evaluation of {}", formula));
-        
         if (!negated_lhs_update.has_value()) {
-            return std::unexpected(explain_failure(formula, negated_lhs_update.error()));
+            return std::unexpected(explain_failure(expr, negated_lhs_update.error()));
         }
-        
-        m_Logger->info("Finishing calculation of hypothetical RHS update");
-        const auto hypothetical_rhs_update = visit(expr->rhs, { negated_lhs_update.value(), model }, Evaluator(m_Logger));
+
+        log("Finishing calculation of hypothetical RHS update");
+        const auto hypothetical_rhs_update = descend().evaluateNode(program, instruction.rhs, std::move(negated_lhs_update.value()), model);
 
         if (!hypothetical_rhs_update.has_value()) {
-            return std::unexpected(explain_failure(formula, hypothetical_rhs_update.error()));
+            return std::unexpected(explain_failure(expr, hypothetical_rhs_update.error()));
         }
 
         const auto in_lhs_or_in_rhs = [&](const Possibility& p) -> bool {
-            return hypothetical_lhs_update.value().contains(p) || hypothetical_rhs_update.value().contains(p);
+            return subsistsIn(p, hypothetical_lhs_update.value()) || subsistsIn(p, hypothetical_rhs_update.value());
         };
 
-        m_Logger->info("Filtering for disjunction");
+        log("Filtering for disjunction");
 
-        filter(input_state, in_lhs_or_in_rhs);
+        return filter(std::forward<State>(input_state), in_lhs_or_in_rhs, resource(), m_Probing);
     }
-    else if (expr->op == QMLExpression::Operator::CONDITIONAL) {
-        m_Logger->info("Calculating hypothetical RHS update");
-        const auto hypothetical_consequent_update = visit(expr->rhs, { hypothetical_lhs_update.value(), model }, Evaluator(m_Logger));
+    else if (instruction.opcode == Program::Opcode::CONDITIONAL) {
+        log("Calculating hypothetical RHS update");
+        const auto hypothetical_consequent_update = descend().evaluateNode(program, instruction.rhs, hypothetical_lhs_update.value(), model);
 
-        m_Logger->info(std::format("Returning to evaluation of {}", formula));
+        log([&] { return std::format("Returning to evaluation of {}", QMLExpression::format(expr)); });
 
         if (!hypothetical_consequent_update.has_value()) {
-            return std::unexpected(explain_failure(formula, hypothetical_consequent_update.error()));
+            return std::unexpected(explain_failure(expr, hypothetical_consequent_update.error()));
         }
 
+        // Descendants share the world of their ancestor, so only the possibilities of the
+        // antecedent update at that world need to be checked
         const auto all_descendants_subsist = [&](const Possibility& p) -> bool {
             const auto not_descendant_or_subsists = [&](const Possibility& p_star) -> bool {
-                return !isDescendantOf(p_star, p, hypothetical_lhs_update.value()) || subsistsIn(p_star, hypothetical_consequent_update.value());
+                return !extends(p_star, p) || subsistsIn(p_star, hypothetical_consequent_update.value());
             };
-            return std::ranges::all_of(hypothetical_lhs_update.value(), not_descendant_or_subsists);
+            return std::ranges::all_of(descendantCandidates(p, hypothetical_lhs_update.value()), not_descendant_or_subsists);
         };
 
         const auto if_subsists_all_descendants_do = [&](const Possibility& p) -> bool {
             return !subsistsIn(p, hypothetical_lhs_update.value()) || all_descendants_subsist(p);
         };
 
-        m_Logger->info("Filtering for conditional");
-        filter(input_state, if_subsists_all_descendants_do);
+        log("Filtering for conditional");
+        return filter(std::forward<State>(input_state), if_subsists_all_descendants_do, resource(), m_Probing);
     }
     else {
-        return std::unexpected(explain_failure(formula, "Invalid operator for binary formula"));
+        return std::unexpected(explain_failure(expr, "Invalid operator for binary formula"));
     }
-
-    endLog(m_Logger, formula, input_state);
-    return input_state;
 }
 
 /**
@@ -253,8 +873,10 @@ std::expected<InformationState, std::string> Evaluator::operator()(const std::sh
  * This function processes logical quantification (existential or universal) over a variable,
  * applying the quantifier's scope to all possible values in the model's domain.
  *
- * @param expr A shared pointer to the `QuantificationNode` representing the quantified expression.
- * @param params A variant containing the current `InformationState` and a pointer to the `IModel`.
+ * @param program The program the instruction belongs to.
+ * @param instruction The quantification instruction.
+ * @param input_state The current InformationState, owned (filtered in place) or borrowed (left untouched).
+ * @param model A pointer to the model (IModel).
  * @return std::expected<InformationState, std::string> The updated information state after
  *         applying quantification, or an error message if evaluation fails.
  *
@@ -266,75 +888,172 @@ std::expected<InformationState, std::string> Evaluator::operator()(const std::sh
  * - If an error occurs during evaluation (e.g., invalid quantifier or undefined term),
  *   an error message is returned instead of an updated state.
  */
-std::expected<InformationState, std::string> Evaluator::operator()(const std::shared_ptr<QMLExpression::QuantificationNode>& expr, std::pair<InformationState, const IModel*> params) const
+template<typename State>
+std::expected<InformationState, std::string> Evaluator::applyQuantification(const Program& program, const Program::Instruction& instruction, State&& input_state, const IModel* model) const
 {
-    const std::string formula = QMLExpression::format(QMLExpression::Expression(expr));
-    InformationState& input_state = params.first;
-    const IModel* model = params.second;
-
-    startLog(m_Logger, formula, input_state);
+    const QMLExpression::Expression& expr = instruction.source;
 
-    if (expr->quantifier == QMLExpression::Quantifier::EXISTENTIAL) {
-        std::vector<InformationState> all_state_variants;
+    if (instruction.opcode == Program::Opcode::INVALID_QUANTIFIER) {
+        return std::unexpected(explain_failure(expr, "Invalid quantifier"));
+    }
 
+    // A probed existential only needs one non-empty branch. Branches derived from the
+    // branch of a lower individual are empty if it was.
+    if (instruction.opcode == Program::Opcode::EXISTENTIAL && m_Probing) {
+        const std::vector<int> sources = branchSources(input_state, model);
         for (const int d : std::views::iota(0, model->domainCardinality())) {
-            const std::string scope = QMLExpression::format(expr->scope);
-            const InformationState s_variant = update(input_state, expr->variable.literal, d);
-            m_Logger->info(std::format("Evaluating {} with respect to association {} -> e{}", scope, expr->variable.literal, std::to_string(d)));
-            const auto hypothetical_s_variant_update = visit(expr->scope, { s_variant, model }, Evaluator(m_Logger));
+            if (!sources.empty() && sources[d] != d) {
+                continue;
+            }
+            auto branch_update = probe().evaluateNode(program, instruction.lhs, variant(input_state, instruction.symbol, d, resource()), model);
+            if (!branch_update.has_value()) {
+                return std::unexpected(explain_failure(expr, branch_update.error()));
+            }
+            if (!branch_update.value().empty()) {
+                return branch_update;
+            }
+        }
+        return InformationState();
+    }
+
+    auto branch_updates = evaluateBranches(program, instruction, input_state, model);
 
-            m_Logger->info(std::format("Finished evaluation of {} with respect to association {} -> e{}", scope, expr->variable.literal, std::to_string(d)));
-            
+    if (instruction.opcode == Program::Opcode::EXISTENTIAL) {
+        for (const auto& hypothetical_s_variant_update : branch_updates) {
             if (!hypothetical_s_variant_update.has_value()) {
-                return std::unexpected(explain_failure(formula, hypothetical_s_variant_update.error()));
+                return std::unexpected(explain_failure(expr, hypothetical_s_variant_update.error()));
             }
-
-            all_state_variants.push_back(hypothetical_s_variant_update.value());
         }
 
-        InformationState output;
-        for (const auto& state_variant : all_state_variants) {
-            for (const auto& p : state_variant) {
-                output.insert(p);
-            }
+        return unite(branch_updates, resource());
+    }
+
+    std::vector<InformationState> all_hypothetical_updates;
+
+    for (auto& hypothetical_update : branch_updates) {
+        if (!hypothetical_update.has_value()) {
+            return std::unexpected(explain_failure(expr, hypothetical_update.error()));
         }
 
-        endLog(m_Logger, formula, output);
-        return output;
+        all_hypothetical_updates.push_back(std::move(hypothetical_update.value()));
     }
-    if (expr->quantifier == QMLExpression::Quantifier::UNIVERSAL) {
-        std::vector<InformationState> all_hypothetical_updates;
 
-        for (const int d : std::views::iota(0, model->domainCardinality())) {
-            const std::string scope = QMLExpression::format(expr->scope);
-            m_Logger->info(std::format("Evaluating {} with respect to association {} -> e{}", scope, expr->variable.literal, std::to_string(d)));
-            const auto hypothetical_update = visit(expr->scope, { update(input_state, expr->variable.literal, d), model }, Evaluator(m_Logger));
+    const auto subsists_in_all_hyp_updates = [&](const Possibility& p) -> bool {
+        const auto p_subsists_in_hyp_update = [&](const InformationState& hypothetical_update) -> bool {
+            return subsistsIn(p, hypothetical_update);
+        };
+        return std::ranges::all_of(all_hypothetical_updates, p_subsists_in_hyp_update);
+    };
+
+    log("Filtering for universal quantification");
+    return filter(std::forward<State>(input_state), subsists_in_all_hyp_updates, resource(), m_Probing);
+}
+
+/**
+ * @brief Evaluates the scope of a quantifier once for every individual in the domain.
+ *
+ * Branch `d` is the update of `input_state[x/d]` with the scope. The branches are independent,
+ * so when an executor is attached they run in parallel; the free-text log is serial by
+ * nature, so branches run serially whenever it is enabled.
+ *
+ * @param program The program the instruction belongs to.
+ * @param instruction The quantification instruction.
+ * @param input_state The input state of the quantified formula.
+ * @param model A pointer to the model (IModel).
+ * Branches that `branchSources()` derives from the branch of a lower individual are not
+ * evaluated, but copied from that branch with the two individuals swapped.
+ *
+ * @return The branch updates, indexed by individual. Serial evaluation stops at the first
+ *         failing branch, so the vector may be shorter than the domain; callers must report
+ *         the lowest-indexed failure, which is the one serial evaluation would have reported.
+ */
+std::vector<std::expected<InformationState, std::string>> Evaluator::evaluateBranches(const Program& program, const Program::Instruction& instruction, const InformationState& input_state, const IModel* model) const
+{
+    const int domain_cardinality = model->domainCardinality();
+    std::vector<std::expected<InformationState, std::string>> branch_updates;
 
-            m_Logger->info(std::format("Finished evaluation of {} with respect to association {} -> e{}", scope, expr->variable.literal, std::to_string(d)));
+    const std::vector<int> sources = branchSources(input_state, model);
+    const auto derived = [&](int d) { return !sources.empty() && sources[d] != d; };
 
-            if (!hypothetical_update.has_value()) {
-                return std::unexpected(explain_failure(formula, hypothetical_update.error()));
+    if (m_Options.executor != nullptr && !tracesVerbose() && !profiles() && domain_cardinality > 1) {
+        branch_updates.resize(domain_cardinality);
+        m_Options.executor->parallelFor(domain_cardinality, [&](std::size_t d) {
+            if (!derived(static_cast<int>(d))) {
+                branch_updates[d] = descend().evaluateNode(program, instruction.lhs, variant(input_state, instruction.symbol, static_cast<int>(d), resource()), model);
+            }
+        });
+        for (const int d : std::views::iota(0, domain_cardinality)) {
+            if (derived(d)) {
+                branch_updates[d] = transpose(branch_updates[sources[d]], sources[d], d, resource());
             }
+        }
+        return branch_updates;
+    }
 
-            all_hypothetical_updates.push_back(hypothetical_update.value());
+    const QMLExpression::Expression& scope = program[instruction.lhs].source;
+    for (const int d : std::views::iota(0, domain_cardinality)) {
+        if (derived(d)) {
+            branch_updates.push_back(transpose(branch_updates[sources[d]], sources[d], d, resource()));
+            continue;
         }
+        log([&] { return std::format("Evaluating {} with respect to association {} -> e{}", QMLExpression::format(scope), instruction.name, std::to_string(d)); });
+        branch_updates.push_back(descend().evaluateNode(program, instruction.lhs, variant(input_state, instruction.symbol, d, resource()), model));
+        log([&] { return std::format("Finished evaluation of {} with respect to association {} -> e{}", QMLExpression::format(scope), instruction.name, std::to_string(d)); });
 
-        const auto subsists_in_all_hyp_updates = [&](const Possibility& p) -> bool {
-            const auto p_subsists_in_hyp_update = [&](const InformationState& hypothetical_update) -> bool {
-                return subsistsIn(p, hypothetical_update);
-            };
-            return std::ranges::all_of(all_hypothetical_updates, p_subsists_in_hyp_update);
-        };
+        if (!branch_updates.back().has_value()) {
+            break;
+        }
+    }
+    return branch_updates;
+}
 
-        m_Logger->info("Filtering for universal quantification");
-        filter(input_state, subsists_in_all_hyp_updates);
+/**
+ * @brief For every individual, the individual whose branch of a quantifier its own branch is derived from.
+ *
+ * The branch for an individual is derived from the branch for its representative in the
+ * symmetry plan if swapping the two leaves the input state unchanged: the update of the
+ * state for the individual is then the update for its representative, with the two
+ * individuals swapped.
+ *
+ * @return The source of the branch of every individual (the individual itself if its
+ *         branch must be evaluated), or an empty vector if no branch can be derived.
+ */
+std::vector<int> Evaluator::branchSources(const InformationState& input_state, const IModel* model) const
+{
+    if (m_Symmetry == nullptr || std::cmp_not_equal(m_Symmetry->representatives.size(), model->domainCardinality())) {
+        return {};
     }
-    else {
-        return std::unexpected(explain_failure(formula, "Invalid quantifier"));
+
+    // Only the individuals assigned in the input state can keep it from being fixed
+    std::vector<std::uint8_t> assigned(m_Symmetry->representatives.size(), 0);
+    for (const Possibility& p : input_state) {
+        for (const int individual : p.assignment.slots()) {
+            if (individual >= 0 && std::cmp_less(individual, assigned.size())) {
+                assigned[individual] = 1;
+            }
+        }
     }
 
-    endLog(m_Logger, formula, input_state);
-    return input_state;
+    // Every swap tests the whole state for its images, so its possibilities are hashed once
+    std::optional<PossibilitySet> possibilities;
+    std::vector<int> sources(m_Symmetry->representatives.begin(), m_Symmetry->representatives.end());
+    bool derives = false;
+    for (std::size_t d = 0; d < sources.size(); ++d) {
+        const int r = sources[d];
+        if (r != static_cast<int>(d) && (assigned[r] || assigned[d])) {
+            if (!possibilities.has_value()) {
+                possibilities.emplace(input_state);
+            }
+            if (!fixedBySwap(input_state, possibilities.value(), r, static_cast<int>(d))) {
+                sources[d] = static_cast<int>(d);
+            }
+        }
+        derives = derives || sources[d] != static_cast<int>(d);
+    }
+    if (!derives) {
+        return {};
+    }
+    return sources;
 }
 
 /**
@@ -344,8 +1063,10 @@ std::expected<InformationState, std::string> Evaluator::operator()(const std::sh
  * denote the same entity within the provided model and information state. It then filters
  * the information state, retaining only those possibilities where the denotations match.
  *
- * @param expr A shared pointer to an IdentityNode representing the identity expression.
- * @param params A variant containing a pair of the current InformationState and a pointer to the model (IModel).
+ * @param program The program the instruction belongs to.
+ * @param instruction The identity instruction.
+ * @param input_state The current InformationState, owned (filtered in place) or borrowed (left untouched).
+ * @param model A pointer to the model (IModel).
  * @return std::expected<InformationState, std::string> The updated information state if evaluation is successful,
  *         or an error message if evaluation fails.
  *
@@ -360,17 +1081,19 @@ std::expected<InformationState, std::string> Evaluator::operator()(const std::sh
  *
  *          If a denotation is out of range (e.g., an unbound variable), an error message is returned.
  */
-std::expected<InformationState, std::string> Evaluator::operator()(const std::shared_ptr<QMLExpression::IdentityNode>& expr, std::pair<InformationState, const IModel*> params) const
+template<typename State>
+std::expected<InformationState, std::string> Evaluator::applyIdentity(const Program& program, const Program::Instruction& instruction, State&& input_state, const IModel* model) const
 {
-    const std::string formula = QMLExpression::format(QMLExpression::Expression(expr));
-    InformationState& input_state = params.first;
-    const IModel& model = *params.second;
-
-    startLog(m_Logger, formula, input_state);
+    const Program::Term& lhs = program.terms(instruction)[0];
+    const Program::Term& rhs = program.terms(instruction)[1];
+    const IIndexedModel* indexed_model = dynamic_cast<const IIndexedModel*>(model);
+    const IDenseModel* dense_model = dynamic_cast<const IDenseModel*>(model);
+    const TermTable lhs_table = termTable(lhs, dense_model);
+    const TermTable rhs_table = termTable(rhs, dense_model);
 
     auto assigns_same_denotation = [&](const Possibility& p) -> bool {
-        const auto lhs_denotation = expr->lhs.type == QMLExpression::Term::Type::VARIABLE ? variableDenotation(expr->lhs.literal, p) : model.termInterpretation(expr->lhs.literal, p.world);
-        const auto rhs_denotation = expr->rhs.type == QMLExpression::Term::Type::VARIABLE ? variableDenotation(expr->rhs.literal, p) : model.termInterpretation(expr->rhs.literal, p.world);
+        const auto lhs_denotation = termDenotation(lhs, p, model, indexed_model, lhs_table);
+        const auto rhs_denotation = termDenotation(rhs, p, model, indexed_model, rhs_table);
 
         if (!lhs_denotation.has_value()) {
             throw std::out_of_range(lhs_denotation.error());
@@ -378,18 +1101,24 @@ std::expected<InformationState, std::string> Evaluator::operator()(const std::sh
         if (!rhs_denotation.has_value()) {
             throw std::out_of_range(rhs_denotation.error());
         }
-        
+
         return lhs_denotation.value() == rhs_denotation.value();
     };
 
+    log("Filtering for identity");
+    if (!m_Probing && input_state.size() >= MIN_COLUMNAR_SIZE) {
+        if (const auto columns = ColumnarState::build(input_state, program.terms(instruction), *model, resource())) {
+            std::pmr::vector<std::uint8_t> selection(columns->size(), resource());
+            selectIdentical(columns.value(), selection);
+            return select(std::forward<State>(input_state), selection, resource());
+        }
+    }
+
     try {
-        m_Logger->info("Filtering for identity");
-        filter(input_state, assigns_same_denotation);
-        endLog(m_Logger, formula, input_state);
-        return input_state;
+        return filter(std::forward<State>(input_state), assigns_same_denotation, resource(), m_Probing);
     }
     catch (const std::out_of_range& e) {
-        return std::unexpected(explain_failure(formula, e.what()));
+        return std::unexpected(explain_failure(instruction.source, e.what()));
     }
 }
 
@@ -400,44 +1129,95 @@ std::expected<InformationState, std::string> Evaluator::operator()(const std::sh
  * in each possibility of the current information state. It retains only those possibilities where
  * the predicate applies to the corresponding denotations.
  *
- * @param expr A shared pointer to a PredicationNode representing the predication expression.
- * @param params A variant containing a pair of the current InformationState and a pointer to the model (IModel).
+ * @param program The program the instruction belongs to.
+ * @param instruction The predication instruction.
+ * @param input_state The current InformationState, owned (filtered in place) or borrowed (left untouched).
+ * @param model A pointer to the model (IModel).
  * @return std::expected<InformationState, std::string> The updated information state if evaluation is successful,
  *         or an error message if evaluation fails.
  *
  * @details The function performs the following steps:
  *          1. Extracts the arguments of the predicate and determines their denotations:
  *             - If an argument is a variable, its denotation is obtained from the current possibility.
- *             - If an argument is a constant, its interpretation is retrieved from the model.
+ *             - If an argument is a constant, its interpretation is retrieved from the model
+ *               (from its table, for dense models).
  *          2. Constructs a tuple of these denotations.
- *          3. Checks if the tuple belongs to the extension of the predicate in the given world.
+ *          3. Checks if the tuple belongs to the extension of the predicate in the given world,
+ *             through the packed extension of dense models, or else through the extension
+ *             index of the options when it indexes the model.
  *          4. Filters the information state, keeping only those possibilities where the predicate holds.
  *
  *          If an argument's denotation is out of range (e.g., an unbound variable) or the predicate
  *          interpretation is missing, an error message is returned.
  */
-std::expected<InformationState, std::string> Evaluator::operator()(const std::shared_ptr<QMLExpression::PredicationNode>& expr, std::pair<InformationState, const IModel*> params) const
+template<typename State>
+std::expected<InformationState, std::string> Evaluator::applyPredication(const Program& program, const Program::Instruction& instruction, State&& input_state, const IModel* model) const
 {
-    const std::string formula = QMLExpression::format(QMLExpression::Expression(expr));
-    InformationState& input_state = params.first;
-    const IModel* model = params.second;
-    
-    startLog(m_Logger, formula, input_state);
-        
-    const auto tuple_in_extension = [&](const Possibility& p) -> bool {
-        std::vector<int> tuple;
-        
-        for (const QMLExpression::Term& argument : expr->arguments) {
-            const auto denotation = argument.type == QMLExpression::Term::Type::VARIABLE ? variableDenotation(argument.literal, p) : model->termInterpretation(argument.literal, p.world);
+    const std::span<const Program::Term> arguments = program.terms(instruction);
+    const IIndexedModel* indexed_model = dynamic_cast<const IIndexedModel*>(model);
+    const IDenseModel* dense_model = instruction.arity <= MAX_STACK_ARITY ? dynamic_cast<const IDenseModel*>(model) : nullptr;
+    const DenseExtension* dense_extension = dense_model != nullptr ? dense_model->denseExtension(instruction.symbol) : nullptr;
+    const ExtensionIndex* extensions = m_Options.extensions != nullptr && &m_Options.extensions->model() == model ? m_Options.extensions : nullptr;
+
+    std::array<TermTable, MAX_STACK_ARITY> tables{};
+    if (dense_model != nullptr) {
+        for (std::size_t i = 0; i < arguments.size(); ++i) {
+            tables[i] = termTable(arguments[i], dense_model);
+        }
+    }
+
+    const auto denote_arguments = [&](const Possibility& p, std::span<int> tuple) {
+        for (std::size_t i = 0; i < arguments.size(); ++i) {
+            const auto denotation = termDenotation(arguments[i], p, model, indexed_model, i < MAX_STACK_ARITY ? tables[i] : TermTable{});
             if (denotation.has_value()) {
-                tuple.push_back(denotation.value());
+                tuple[i] = denotation.value();
             }
             else {
                 throw std::out_of_range(denotation.error());
             }
         }
+    };
+
+    const auto indexed_tuple_in_extension = [&](const Possibility& p, std::span<const int> tuple) -> bool {
+        if (dense_extension != nullptr && p.world >= 0 && p.world < dense_extension->worlds) {
+            return dense_extension->contains(p.world, tuple);
+        }
+        if (extensions != nullptr) {
+            const auto in_extension = extensions->contains(instruction.symbol, p.world, tuple);
+            if (in_extension.has_value()) {
+                return in_extension.value();
+            }
+            else {
+                throw std::out_of_range(in_extension.error());
+            }
+        }
 
-        const auto predint = model->predicateInterpretation(expr->predicate, p.world);
+        // Worlds out of range of a dense extension fail as the model fails them
+        const auto predint = indexed_model->predicateInterpretationById(instruction.symbol, p.world);
+        if (predint.has_value()) {
+            return predint.value()->contains(std::vector<int>(tuple.begin(), tuple.end()));
+        }
+        else {
+            throw std::out_of_range(predint.error());
+        }
+    };
+
+    const auto stack_tuple_in_extension = [&](const Possibility& p) -> bool {
+        std::array<int, MAX_STACK_ARITY> tuple;
+        const std::span<int> arguments_tuple(tuple.data(), instruction.arity);
+        denote_arguments(p, arguments_tuple);
+        return indexed_tuple_in_extension(p, arguments_tuple);
+    };
+
+    const auto tuple_in_extension = [&](const Possibility& p) -> bool {
+        std::vector<int> tuple(instruction.arity);
+        denote_arguments(p, tuple);
+
+        if (extensions != nullptr) {
+            return indexed_tuple_in_extension(p, tuple);
+        }
+
+        const auto predint = indexed_model != nullptr ? indexed_model->predicateInterpretationById(instruction.symbol, p.world) : model->predicateInterpretation(instruction.name, p.world);
         if (predint.has_value()) {
             return predint.value()->contains(tuple);
         }
@@ -446,14 +1226,23 @@ std::expected<InformationState, std::string> Evaluator::operator()(const std::sh
         }
     };
 
+    log("Filtering for predication");
+    if (dense_extension != nullptr && dense_extension->worlds >= model->worldCardinality() && !m_Probing && input_state.size() >= MIN_COLUMNAR_SIZE) {
+        if (const auto columns = ColumnarState::build(input_state, arguments, *model, resource())) {
+            std::pmr::vector<std::uint8_t> selection(columns->size(), resource());
+            selectInExtension(columns.value(), *dense_extension, selection);
+            return select(std::forward<State>(input_state), selection, resource());
+        }
+    }
+
     try {
-        m_Logger->info("Filtering for predication");
-        filter(input_state, tuple_in_extension);
-        endLog(m_Logger, formula, input_state);
-        return input_state;
+        if ((extensions != nullptr || dense_extension != nullptr) && instruction.arity <= MAX_STACK_ARITY) {
+            return filter(std::forward<State>(input_state), stack_tuple_in_extension, resource(), m_Probing);
+        }
+        return filter(std::forward<State>(input_state), tuple_in_extension, resource(), m_Probing);
     }
     catch (const std::out_of_range& e) {
-        return std::unexpected(explain_failure(formula, e.what()));
+        return std::unexpected(explain_failure(instruction.source, e.what()));
     }
 }
 
@@ -469,14 +1258,126 @@ std::expected<InformationState, std::string> Evaluator::operator()(const std::sh
  * @return std::expected<InformationState, std::string> The updated information state if
  *         evaluation is successful, or an error message if evaluation fails.
  *
- * @details The function processes the expression using `std::visit`, dispatching to the
- *          appropriate `Evaluator` method based on the expression type. If evaluation
+ * @details The function compiles the expression to a `Program` and evaluates its
+ *          instructions, dispatching on their opcodes. If evaluation
  *          encounters an error (e.g., an invalid operator or undefined term interpretation),
  *          an error message is returned instead of an updated state.
  */
 std::expected<InformationState, std::string> evaluate(const QMLExpression::Expression& expr, const InformationState& input_state, const IModel& model, simple_logger::SimpleLogger* logger)
 {
-    return visit(expr, { input_state, &model }, Evaluator(logger));
+    return evaluate(Program(expr), input_state, model, logger);
+}
+
+/**
+ * @brief Evaluates a logical expression with the given evaluation options.
+ *
+ * @param expr The logical expression to evaluate.
+ * @param input_state The initial information state in which the expression is evaluated.
+ * @param model The model providing the interpretation of terms and predicates.
+ * @param options The logger, trace sink and trace level for the evaluation.
+ * @return std::expected<InformationState, std::string> The updated information state if
+ *         evaluation is successful, or an error message if evaluation fails.
+ */
+std::expected<InformationState, std::string> evaluate(const QMLExpression::Expression& expr, const InformationState& input_state, const IModel& model, const EvaluationOptions& options)
+{
+    return evaluate(Program(expr), input_state, model, options);
+}
+
+/**
+ * @brief Evaluates a logical expression, consuming the input information state.
+ *
+ * Same as the overload taking a const reference, but the input state is updated in place
+ * and moved into the result, so callers that no longer need it avoid a copy.
+ *
+ * @param expr The logical expression to evaluate.
+ * @param input_state The initial information state, which is left in a valid but unspecified state.
+ * @param model The model providing the interpretation of terms and predicates.
+ * @param logger The logger for the evaluation, or nullptr.
+ * @return std::expected<InformationState, std::string> The updated information state if
+ *         evaluation is successful, or an error message if evaluation fails.
+ */
+std::expected<InformationState, std::string> evaluate(const QMLExpression::Expression& expr, InformationState&& input_state, const IModel& model, simple_logger::SimpleLogger* logger)
+{
+    return evaluate(Program(expr), std::move(input_state), model, logger);
+}
+
+/**
+ * @brief Evaluates a logical expression with the given evaluation options, consuming the input information state.
+ *
+ * @param expr The logical expression to evaluate.
+ * @param input_state The initial information state, which is left in a valid but unspecified state.
+ * @param model The model providing the interpretation of terms and predicates.
+ * @param options The logger, trace sink and trace level for the evaluation.
+ * @return std::expected<InformationState, std::string> The updated information state if
+ *         evaluation is successful, or an error message if evaluation fails.
+ */
+std::expected<InformationState, std::string> evaluate(const QMLExpression::Expression& expr, InformationState&& input_state, const IModel& model, const EvaluationOptions& options)
+{
+    return evaluate(Program(expr), std::move(input_state), model, options);
+}
+
+/**
+ * @brief Evaluates a compiled expression within a given information state, relative to a base model.
+ *
+ * Same as the overload taking an expression, without compiling the expression again.
+ *
+ * @param program The compiled expression to evaluate.
+ * @param input_state The initial information state in which the expression is evaluated.
+ * @param model The model providing the interpretation of terms and predicates.
+ * @param logger The logger for the evaluation, or nullptr.
+ * @return std::expected<InformationState, std::string> The updated information state if
+ *         evaluation is successful, or an error message if evaluation fails.
+ */
+std::expected<InformationState, std::string> evaluate(const Program& program, const InformationState& input_state, const IModel& model, simple_logger::SimpleLogger* logger)
+{
+    return Evaluator(logger).evaluateHypothetical(program, input_state, model);
+}
+
+/**
+ * @brief Evaluates a compiled expression with the given evaluation options.
+ */
+std::expected<InformationState, std::string> evaluate(const Program& program, const InformationState& input_state, const IModel& model, const EvaluationOptions& options)
+{
+    if (options.useArena) {
+        EvaluationArena arena;
+        return detach(Evaluator(options, &arena).evaluateHypothetical(program, input_state, model), arena);
+    }
+    return Evaluator(options).evaluateHypothetical(program, input_state, model);
+}
+
+/**
+ * @brief Determines whether the update of a state with a compiled expression is non-empty.
+ *
+ * Same as evaluating the program and testing the result for emptiness, except that with
+ * `options.shortCircuit` the evaluation stops as soon as the outcome is known.
+ */
+std::expected<bool, std::string> hasNonEmptyUpdate(const Program& program, const InformationState& input_state, const IModel& model, const EvaluationOptions& options)
+{
+    if (options.useArena) {
+        EvaluationArena arena;
+        return Evaluator(options, &arena).evaluateNonEmpty(program, input_state, model);
+    }
+    return Evaluator(options).evaluateNonEmpty(program, input_state, model);
+}
+
+/**
+ * @brief Evaluates a compiled expression, consuming the input information state.
+ */
+std::expected<InformationState, std::string> evaluate(const Program& program, InformationState&& input_state, const IModel& model, simple_logger::SimpleLogger* logger)
+{
+    return Evaluator(logger).evaluateOwned(program, std::move(input_state), model);
+}
+
+/**
+ * @brief Evaluates a compiled expression with the given evaluation options, consuming the input information state.
+ */
+std::expected<InformationState, std::string> evaluate(const Program& program, InformationState&& input_state, const IModel& model, const EvaluationOptions& options)
+{
+    if (options.useArena) {
+        EvaluationArena arena;
+        return detach(Evaluator(options, &arena).evaluateOwned(program, std::move(input_state), model), arena);
+    }
+    return Evaluator(options).evaluateOwned(program, std::move(input_state), model);
 }
 
 }
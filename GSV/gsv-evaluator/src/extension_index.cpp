@@ -0,0 +1,267 @@
+#include "extension_index.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "iindexed_model.hpp"
+#include "lazy_symbol_map.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+namespace {
+
+/**
+ * @brief Binary bitmaps of up to this many bits are always built.
+ */
+constexpr std::size_t MIN_BINARY_BITMAP_BITS = std::size_t{ 1 } << 16;
+
+/**
+ * @brief Larger binary bitmaps are only built if they take at most this many bits per binary tuple.
+ */
+constexpr std::size_t MAX_BINARY_BITMAP_BITS_PER_TUPLE = 256;
+
+std::size_t hashTuple(std::span<const int> tuple)
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (const int element : tuple) {
+        hash ^= static_cast<std::uint32_t>(element);
+        hash *= 1099511628211ULL;
+    }
+    return static_cast<std::size_t>(hash ^ (hash >> 32));
+}
+
+bool testBit(const std::vector<std::uint64_t>& bits, std::size_t index)
+{
+    return (bits[index / 64] >> (index % 64)) & 1;
+}
+
+void setBit(std::vector<std::uint64_t>& bits, std::size_t index)
+{
+    bits[index / 64] |= std::uint64_t{ 1 } << (index % 64);
+}
+
+/**
+ * @brief An open-addressing hash set of distinct tuples of the same arity.
+ *
+ * Tuples are stored contiguously in `elements`, and slots hold the position of a tuple
+ * plus one (zero marks an empty slot). Slots are probed linearly.
+ */
+class TupleTable {
+public:
+    TupleTable(std::size_t arity, std::size_t count, std::vector<int> elements)
+        : m_Arity(arity), m_Elements(std::move(elements)), m_Slots(std::bit_ceil(2 * count), 0)
+    {
+        const std::size_t mask = m_Slots.size() - 1;
+        for (std::size_t position = 0; position < count; ++position) {
+            std::size_t slot = hashTuple(tuple(position)) & mask;
+            while (m_Slots[slot] != 0) {
+                slot = (slot + 1) & mask;
+            }
+            m_Slots[slot] = static_cast<std::uint32_t>(position + 1);
+        }
+    }
+
+    std::size_t arity() const { return m_Arity; }
+
+    bool contains(std::span<const int> candidate) const
+    {
+        const std::size_t mask = m_Slots.size() - 1;
+        for (std::size_t slot = hashTuple(candidate) & mask; m_Slots[slot] != 0; slot = (slot + 1) & mask) {
+            if (std::ranges::equal(tuple(m_Slots[slot] - 1), candidate)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    std::span<const int> tuple(std::size_t position) const
+    {
+        return std::span<const int>(m_Elements).subspan(position * m_Arity, m_Arity);
+    }
+
+    std::size_t m_Arity;
+    std::vector<int> m_Elements;
+    std::vector<std::uint32_t> m_Slots;
+};
+
+/**
+ * @brief The extension of a predicate at a single world.
+ *
+ * Unary tuples over the domain are kept in a bitmap of `domain` bits, and binary tuples
+ * over the domain in a bitmap of `domain * domain` bits when that is not too large.
+ * Every other tuple (other arities, individuals outside the domain) goes to the hash
+ * table of its arity.
+ */
+class WorldExtension {
+public:
+    WorldExtension(const std::set<std::vector<int>>& tuples, int domain)
+        : m_Domain(std::max(domain, 0)), m_Unary((static_cast<std::size_t>(m_Domain) + 63) / 64, 0)
+    {
+        const std::size_t domain_size = static_cast<std::size_t>(m_Domain);
+        const std::size_t binary_count = static_cast<std::size_t>(std::ranges::count_if(tuples, [](const std::vector<int>& tuple) {
+            return tuple.size() == 2;
+        }));
+        const std::size_t binary_bits = domain_size * domain_size;
+        m_DenseBinary = binary_count > 0 && binary_bits <= std::max(MIN_BINARY_BITMAP_BITS, MAX_BINARY_BITMAP_BITS_PER_TUPLE * binary_count);
+        if (m_DenseBinary) {
+            m_Binary.assign((binary_bits + 63) / 64, 0);
+        }
+
+        std::map<std::size_t, std::pair<std::size_t, std::vector<int>>> sparse_tuples;
+        for (const std::vector<int>& tuple : tuples) {
+            const bool in_domain = std::ranges::all_of(tuple, [&](int element) { return inDomain(element); });
+            if (tuple.size() == 1 && in_domain) {
+                setBit(m_Unary, static_cast<std::size_t>(tuple[0]));
+            }
+            else if (tuple.size() == 2 && in_domain && m_DenseBinary) {
+                setBit(m_Binary, binaryIndex(tuple[0], tuple[1]));
+            }
+            else {
+                auto& [count, elements] = sparse_tuples[tuple.size()];
+                ++count;
+                elements.insert(elements.end(), tuple.begin(), tuple.end());
+            }
+        }
+
+        for (auto& [arity, entry] : sparse_tuples) {
+            m_Tables.emplace_back(arity, entry.first, std::move(entry.second));
+        }
+    }
+
+    bool contains(std::span<const int> tuple) const
+    {
+        if (tuple.size() == 1 && inDomain(tuple[0])) {
+            return testBit(m_Unary, static_cast<std::size_t>(tuple[0]));
+        }
+        if (tuple.size() == 2 && m_DenseBinary && inDomain(tuple[0]) && inDomain(tuple[1])) {
+            return testBit(m_Binary, binaryIndex(tuple[0], tuple[1]));
+        }
+        for (const TupleTable& table : m_Tables) {
+            if (table.arity() == tuple.size()) {
+                return table.contains(tuple);
+            }
+        }
+        return false;
+    }
+
+private:
+    bool inDomain(int element) const { return element >= 0 && element < m_Domain; }
+
+    std::size_t binaryIndex(int first, int second) const
+    {
+        return static_cast<std::size_t>(first) * static_cast<std::size_t>(m_Domain) + static_cast<std::size_t>(second);
+    }
+
+    int m_Domain;
+    bool m_DenseBinary = false;
+    std::vector<std::uint64_t> m_Unary;
+    std::vector<std::uint64_t> m_Binary;
+    std::vector<TupleTable> m_Tables;
+};
+
+} // ANONYMOUS NAMESPACE
+
+class ExtensionIndex::Impl {
+public:
+    using PredicateExtension = std::vector<std::expected<WorldExtension, std::string>>;
+
+    explicit Impl(const IModel& model)
+        : m_Model(&model), m_IndexedModel(dynamic_cast<const IIndexedModel*>(&model)) {}
+
+    const IModel& model() const { return *m_Model; }
+
+    /**
+     * @brief The interpretation of a predicate, queried by id if the model supports it.
+     */
+    std::expected<const std::set<std::vector<int>>*, std::string> interpretation(SymbolId predicate, int world) const
+    {
+        if (m_IndexedModel != nullptr) {
+            return m_IndexedModel->predicateInterpretationById(predicate, world);
+        }
+        return m_Model->predicateInterpretation(SymbolTable::global().name(predicate), world);
+    }
+
+    /**
+     * @brief The extensions of a predicate at every world, or nullptr if the id cannot be stored.
+     */
+    const PredicateExtension* extension(SymbolId predicate)
+    {
+        return m_Extensions.get(predicate, [&] {
+            const int domain = m_Model->domainCardinality();
+            PredicateExtension extension;
+            for (int world = 0; world < m_Model->worldCardinality(); ++world) {
+                const auto predint = interpretation(predicate, world);
+                if (predint.has_value()) {
+                    extension.emplace_back(WorldExtension(*predint.value(), domain));
+                }
+                else {
+                    extension.emplace_back(std::unexpected(predint.error()));
+                }
+            }
+            return extension;
+        });
+    }
+
+private:
+    const IModel* m_Model;
+    const IIndexedModel* m_IndexedModel;
+    LazySymbolMap<PredicateExtension> m_Extensions;
+};
+
+/**
+ * @brief Constructs an empty index for a model; predicates are indexed when first queried.
+ *
+ * @param model The model whose predicate extensions are indexed.
+ */
+ExtensionIndex::ExtensionIndex(const IModel& model)
+    : pImpl(std::make_unique<Impl>(model)) {}
+
+ExtensionIndex::ExtensionIndex(ExtensionIndex&&) noexcept = default;
+ExtensionIndex& ExtensionIndex::operator=(ExtensionIndex&&) noexcept = default;
+ExtensionIndex::~ExtensionIndex() = default;
+
+/**
+ * @brief The model whose predicate extensions are indexed.
+ */
+const IModel& ExtensionIndex::model() const
+{
+    return pImpl->model();
+}
+
+/**
+ * @brief Checks whether a tuple belongs to the extension of a predicate at a world.
+ *
+ * Worlds out of range are forwarded to the model, so they fail as they would without the index.
+ *
+ * @param predicate The id of the predicate in the global `SymbolTable`.
+ * @param world The world at which the extension is taken.
+ * @param tuple The tuple of individuals.
+ * @return std::expected<bool, std::string> Whether the tuple is in the extension, or the
+ *         error returned by the model when interpreting the predicate at the world.
+ */
+std::expected<bool, std::string> ExtensionIndex::contains(SymbolId predicate, int world, std::span<const int> tuple) const
+{
+    const Impl::PredicateExtension* extension = pImpl->extension(predicate);
+    if (extension == nullptr || world < 0 || static_cast<std::size_t>(world) >= extension->size()) {
+        const auto predint = pImpl->interpretation(predicate, world);
+        if (!predint.has_value()) {
+            return std::unexpected(predint.error());
+        }
+        return predint.value()->contains(std::vector<int>(tuple.begin(), tuple.end()));
+    }
+
+    const auto& world_extension = (*extension)[static_cast<std::size_t>(world)];
+    if (!world_extension.has_value()) {
+        return std::unexpected(world_extension.error());
+    }
+    return world_extension.value().contains(tuple);
+}
+
+}
@@ -0,0 +1,327 @@
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <format>
+#include <ranges>
+#include <variant>
+
+#include <QMLExpression/formatter.hpp>
+
+namespace iif_sadaf::talk::GSV {
+
+namespace {
+
+std::atomic<std::uint64_t> next_profiler_id = 1;
+
+/**
+ * @brief The thread profile of the last profiler that recorded an event on this thread.
+ */
+struct ThreadProfileCache {
+    std::uint64_t profiler = 0;
+    void* profile = nullptr;
+};
+
+thread_local ThreadProfileCache thread_profile_cache;
+
+std::string escapeJson(std::string_view text)
+{
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (const char c : text) {
+        switch (c) {
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        case '\t':
+            escaped += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                constexpr char HEX_DIGITS[] = "0123456789abcdef";
+                escaped += "\\u00";
+                escaped += HEX_DIGITS[static_cast<unsigned char>(c) >> 4];
+                escaped += HEX_DIGITS[static_cast<unsigned char>(c) & 0xf];
+            }
+            else {
+                escaped += c;
+            }
+        }
+    }
+    return escaped;
+}
+
+/**
+ * @brief A stack frame of the collapsed-stack format: frames are separated by semicolons, and the count by a space at the end.
+ */
+std::string frameName(std::string_view label)
+{
+    std::string frame(label);
+    std::ranges::replace(frame, ';', ',');
+    std::ranges::replace(frame, '\n', ' ');
+    return frame;
+}
+
+} // ANONYMOUS NAMESPACE
+
+Profiler::Profiler()
+    : m_Id(next_profiler_id.fetch_add(1, std::memory_order_relaxed))
+{ }
+
+/**
+ * @brief Aggregates a trace event into the call tree of the calling thread.
+ *
+ * ENTER events open a call of their node, below the innermost open call of the same
+ * thread; EXIT and FAILURE events close it, and are timed against it.
+ */
+void Profiler::record(const TraceEvent& event)
+{
+    const auto now = std::chrono::steady_clock::now();
+    ThreadProfile& profile = threadProfile();
+
+    if (event.type == TraceEvent::Type::ENTER) {
+        const std::uint32_t parent = profile.stack.empty() ? 0 : profile.stack.back().node;
+        const auto& siblings = profile.calls[parent].children;
+        const auto same_node = [&](std::uint32_t child) -> bool { return profile.calls[child].nodeId == event.nodeId; };
+        auto it = std::ranges::find_if(siblings, same_node);
+        std::uint32_t node = 0;
+        if (it != siblings.end()) {
+            node = *it;
+        }
+        else {
+            node = static_cast<std::uint32_t>(profile.calls.size());
+            profile.calls.push_back({ .nodeId = event.nodeId, .op = event.op, .parent = parent, .children = {} });
+            profile.calls[parent].children.push_back(node);
+        }
+        ++profile.calls[node].calls;
+        profile.calls[node].inputPossibilities += event.inputCardinality;
+        profile.stack.push_back({ node, now });
+        return;
+    }
+
+    if (profile.stack.empty()) {
+        return;
+    }
+
+    const Frame frame = profile.stack.back();
+    profile.stack.pop_back();
+    CallNode& node = profile.calls[frame.node];
+    CallNode& parent = profile.calls[node.parent];
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - frame.start);
+    node.totalTime += elapsed;
+    parent.childTime += elapsed;
+    if (event.type == TraceEvent::Type::EXIT) {
+        node.outputPossibilities += event.outputCardinality;
+        node.allocatedPossibilities += event.allocatedPossibilities;
+        parent.childAllocatedPossibilities += event.allocatedPossibilities;
+    }
+    else {
+        ++node.failures;
+    }
+}
+
+/**
+ * @brief Records one call to a model-level relation.
+ *
+ * @param relation The name of the relation.
+ * @param states_checked The number of information states probed by the call.
+ * @param early_exit Whether a state settled the search before every state was checked.
+ * @param time The wall time of the call.
+ */
+void Profiler::recordRelation(std::string_view relation, std::uint64_t states_checked, bool early_exit, std::chrono::nanoseconds time)
+{
+    const std::lock_guard lock(m_Mutex);
+    auto it = m_Relations.find(relation);
+    if (it == m_Relations.end()) {
+        it = m_Relations.emplace(std::string(relation), RelationProfile{ .relation = std::string(relation) }).first;
+    }
+    ++it->second.calls;
+    it->second.statesChecked += states_checked;
+    it->second.earlyExits += early_exit ? 1 : 0;
+    it->second.totalTime += time;
+}
+
+/**
+ * @brief Labels the nodes of an expression with their formulas in the reports.
+ */
+void Profiler::describe(const QMLExpression::Expression& expr)
+{
+    describe(Program(expr));
+}
+
+/**
+ * @brief Labels the nodes of a compiled expression with their formulas in the reports.
+ */
+void Profiler::describe(const Program& program)
+{
+    const std::lock_guard lock(m_Mutex);
+    for (const std::uint32_t i : std::views::iota(std::uint32_t{ 0 }, static_cast<std::uint32_t>(program.size()))) {
+        const QMLExpression::Expression& source = program[i].source;
+        const void* node = std::visit([](const auto& n) -> const void* { return n.get(); }, source);
+        m_Formulas.try_emplace(reinterpret_cast<std::uintptr_t>(node), QMLExpression::format(source));
+    }
+}
+
+/**
+ * @brief The totals of every node evaluated, by decreasing total time.
+ */
+std::vector<NodeProfile> Profiler::nodes() const
+{
+    const std::lock_guard lock(m_Mutex);
+    std::unordered_map<std::uintptr_t, NodeProfile> totals;
+    for (const auto& entry : m_Threads) {
+        const std::vector<CallNode>& calls = entry.second->calls;
+        for (const CallNode& call : calls | std::views::drop(1)) {
+            NodeProfile& total = totals[call.nodeId];
+            total.nodeId = call.nodeId;
+            total.op = call.op;
+            total.calls += call.calls;
+            total.failures += call.failures;
+            total.totalTime += call.totalTime;
+            total.selfTime += call.totalTime - call.childTime;
+            total.inputPossibilities += call.inputPossibilities;
+            total.outputPossibilities += call.outputPossibilities;
+            total.allocatedPossibilities += call.allocatedPossibilities;
+            total.selfAllocatedPossibilities += call.allocatedPossibilities - std::min(call.allocatedPossibilities, call.childAllocatedPossibilities);
+        }
+    }
+
+    std::vector<NodeProfile> profiles;
+    profiles.reserve(totals.size());
+    for (auto& entry : totals) {
+        const auto formula = m_Formulas.find(entry.first);
+        entry.second.formula = formula != m_Formulas.end() ? formula->second : std::string(str(entry.second.op));
+        profiles.push_back(std::move(entry.second));
+    }
+    std::ranges::sort(profiles, [](const NodeProfile& p1, const NodeProfile& p2) -> bool {
+        return p1.totalTime != p2.totalTime ? p1.totalTime > p2.totalTime : p1.nodeId < p2.nodeId;
+    });
+    return profiles;
+}
+
+/**
+ * @brief The counters of every model-level relation called, by name.
+ */
+std::vector<RelationProfile> Profiler::relations() const
+{
+    const std::lock_guard lock(m_Mutex);
+    std::vector<RelationProfile> profiles;
+    for (const auto& entry : m_Relations) {
+        profiles.push_back(entry.second);
+    }
+    return profiles;
+}
+
+/**
+ * @brief The totals of every node and relation, as a JSON document.
+ *
+ * The document is an object with a `nodes` array, ordered as `nodes()`, and a `relations`
+ * array, ordered as `relations()`. Times are in nanoseconds.
+ */
+std::string Profiler::json() const
+{
+    std::string document = "{\n  \"nodes\": [";
+    const std::vector<NodeProfile> node_profiles = nodes();
+    for (std::size_t i = 0; i < node_profiles.size(); ++i) {
+        const NodeProfile& node = node_profiles[i];
+        document += std::format("{}\n    {{\"node\": {}, \"operator\": \"{}\", \"formula\": \"{}\", \"calls\": {}, \"failures\": {}, "
+                                "\"totalNs\": {}, \"selfNs\": {}, \"inputPossibilities\": {}, \"outputPossibilities\": {}, "
+                                "\"allocatedPossibilities\": {}, \"selfAllocatedPossibilities\": {}}}",
+                                i == 0 ? "" : ",", node.nodeId, str(node.op), escapeJson(node.formula), node.calls, node.failures,
+                                node.totalTime.count(), node.selfTime.count(), node.inputPossibilities, node.outputPossibilities,
+                                node.allocatedPossibilities, node.selfAllocatedPossibilities);
+    }
+    document += node_profiles.empty() ? "],\n  \"relations\": [" : "\n  ],\n  \"relations\": [";
+
+    const std::vector<RelationProfile> relation_profiles = relations();
+    for (std::size_t i = 0; i < relation_profiles.size(); ++i) {
+        const RelationProfile& relation = relation_profiles[i];
+        document += std::format("{}\n    {{\"relation\": \"{}\", \"calls\": {}, \"statesChecked\": {}, \"earlyExits\": {}, \"totalNs\": {}}}",
+                                i == 0 ? "" : ",", escapeJson(relation.relation), relation.calls, relation.statesChecked,
+                                relation.earlyExits, relation.totalTime.count());
+    }
+    document += relation_profiles.empty() ? "]\n}\n" : "\n  ]\n}\n";
+    return document;
+}
+
+/**
+ * @brief The self time of every call path, in the collapsed-stack format of flame graph tools.
+ *
+ * Each line holds the labels of the nodes of a call path, outermost first, separated by
+ * semicolons, followed by a space and the self time of the path in nanoseconds. Paths
+ * are merged across threads and sorted.
+ */
+std::string Profiler::collapsedStacks() const
+{
+    const std::lock_guard lock(m_Mutex);
+    std::map<std::string, std::int64_t> stacks;
+    for (const auto& entry : m_Threads) {
+        const std::vector<CallNode>& calls = entry.second->calls;
+        std::vector<std::string> paths(calls.size());
+        for (std::uint32_t i = 1; i < calls.size(); ++i) {
+            // Nodes are created after their parents, so the path of the parent is known
+            const CallNode& call = calls[i];
+            paths[i] = call.parent == 0 ? frameName(label(call)) : paths[call.parent] + ";" + frameName(label(call));
+            stacks[paths[i]] += (call.totalTime - call.childTime).count();
+        }
+    }
+
+    std::string output;
+    for (const auto& [path, self_time] : stacks) {
+        output += std::format("{} {}\n", path, std::max<std::int64_t>(self_time, 0));
+    }
+    return output;
+}
+
+/**
+ * @brief Discards every call and relation recorded so far. Labels are kept.
+ */
+void Profiler::reset()
+{
+    const std::lock_guard lock(m_Mutex);
+    for (auto& entry : m_Threads) {
+        entry.second->calls.resize(1);
+        entry.second->calls.front().children.clear();
+        entry.second->stack.clear();
+    }
+    m_Relations.clear();
+}
+
+/**
+ * @brief The profile of the calling thread, created on its first event.
+ */
+Profiler::ThreadProfile& Profiler::threadProfile()
+{
+    if (thread_profile_cache.profiler == m_Id) {
+        return *static_cast<ThreadProfile*>(thread_profile_cache.profile);
+    }
+
+    const std::thread::id thread = std::this_thread::get_id();
+    const std::lock_guard lock(m_Mutex);
+    auto it = std::ranges::find(m_Threads, thread, &decltype(m_Threads)::value_type::first);
+    if (it == m_Threads.end()) {
+        auto profile = std::make_unique<ThreadProfile>();
+        profile->calls.push_back({ .nodeId = 0, .op = TraceOperator::INVALID, .parent = 0, .children = {} });
+        m_Threads.emplace_back(thread, std::move(profile));
+        it = std::prev(m_Threads.end());
+    }
+    thread_profile_cache = { m_Id, it->second.get() };
+    return *it->second;
+}
+
+/**
+ * @brief The label of a node in the reports: its formula if it was described, its operator otherwise.
+ */
+std::string Profiler::label(const CallNode& node) const
+{
+    const auto formula = m_Formulas.find(node.nodeId);
+    return formula != m_Formulas.end() ? formula->second : std::string(str(node.op));
+}
+
+}
@@ -0,0 +1,193 @@
+#include "program.hpp"
+
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace iif_sadaf::talk::GSV {
+
+namespace {
+
+Program::Opcode unaryOpcode(QMLExpression::Operator op)
+{
+    switch (op) {
+    case QMLExpression::Operator::NEGATION:
+        return Program::Opcode::NEGATION;
+    case QMLExpression::Operator::EPISTEMIC_POSSIBILITY:
+        return Program::Opcode::EPISTEMIC_POSSIBILITY;
+    case QMLExpression::Operator::EPISTEMIC_NECESSITY:
+        return Program::Opcode::EPISTEMIC_NECESSITY;
+    default:
+        return Program::Opcode::INVALID_UNARY;
+    }
+}
+
+Program::Opcode binaryOpcode(QMLExpression::Operator op)
+{
+    switch (op) {
+    case QMLExpression::Operator::CONJUNCTION:
+        return Program::Opcode::CONJUNCTION;
+    case QMLExpression::Operator::DISJUNCTION:
+        return Program::Opcode::DISJUNCTION;
+    case QMLExpression::Operator::CONDITIONAL:
+        return Program::Opcode::CONDITIONAL;
+    default:
+        return Program::Opcode::INVALID_BINARY;
+    }
+}
+
+Program::Opcode quantifierOpcode(QMLExpression::Quantifier quantifier)
+{
+    switch (quantifier) {
+    case QMLExpression::Quantifier::EXISTENTIAL:
+        return Program::Opcode::EXISTENTIAL;
+    case QMLExpression::Quantifier::UNIVERSAL:
+        return Program::Opcode::UNIVERSAL;
+    default:
+        return Program::Opcode::INVALID_QUANTIFIER;
+    }
+}
+
+Program::Term compileTerm(const QMLExpression::Term& term)
+{
+    const SymbolId symbol = SymbolTable::global().intern(term.literal);
+    return { .variable = term.type == QMLExpression::Term::Type::VARIABLE, .symbol = symbol, .name = SymbolTable::global().name(symbol) };
+}
+
+struct Compiler {
+    std::vector<Program::Instruction>& instructions;
+    std::vector<Program::Term>& terms;
+
+    std::uint32_t push(Program::Instruction&& instruction)
+    {
+        instruction.wellFormed = isWellFormed(instruction);
+        instructions.push_back(std::move(instruction));
+        return static_cast<std::uint32_t>(instructions.size() - 1);
+    }
+
+    bool isWellFormed(const Program::Instruction& instruction) const
+    {
+        switch (instruction.opcode) {
+        case Program::Opcode::INVALID_UNARY:
+        case Program::Opcode::INVALID_BINARY:
+        case Program::Opcode::INVALID_QUANTIFIER:
+            return false;
+        case Program::Opcode::NEGATION:
+        case Program::Opcode::EPISTEMIC_POSSIBILITY:
+        case Program::Opcode::EPISTEMIC_NECESSITY:
+        case Program::Opcode::EXISTENTIAL:
+        case Program::Opcode::UNIVERSAL:
+            return instructions[instruction.lhs].wellFormed;
+        case Program::Opcode::CONJUNCTION:
+        case Program::Opcode::DISJUNCTION:
+        case Program::Opcode::CONDITIONAL:
+            return instructions[instruction.lhs].wellFormed && instructions[instruction.rhs].wellFormed;
+        case Program::Opcode::IDENTITY:
+        case Program::Opcode::PREDICATION:
+            return true;
+        }
+        return false;
+    }
+
+    std::uint32_t lower(const QMLExpression::Expression& expr)
+    {
+        return std::visit([&]<typename Node>(const std::shared_ptr<Node>& node) -> std::uint32_t {
+            if constexpr (std::is_same_v<Node, QMLExpression::UnaryNode>) {
+                const std::uint32_t scope = lower(node->scope);
+                return push({ .opcode = unaryOpcode(node->op), .traceOperator = traceOperator(node->op), .lhs = scope, .source = expr });
+            }
+            else if constexpr (std::is_same_v<Node, QMLExpression::BinaryNode>) {
+                const std::uint32_t lhs = lower(node->lhs);
+                std::uint32_t negated_lhs = 0;
+                if (binaryOpcode(node->op) == Program::Opcode::DISJUNCTION) {
+                    const QMLExpression::Expression negation = std::make_shared<QMLExpression::UnaryNode>(QMLExpression::Operator::NEGATION, node->lhs);
+                    negated_lhs = push({ .opcode = Program::Opcode::NEGATION, .traceOperator = TraceOperator::NEGATION, .lhs = lhs, .source = negation });
+                }
+                const std::uint32_t rhs = lower(node->rhs);
+                return push({ .opcode = binaryOpcode(node->op), .traceOperator = traceOperator(node->op), .lhs = lhs, .rhs = rhs, .negatedLhs = negated_lhs, .source = expr });
+            }
+            else if constexpr (std::is_same_v<Node, QMLExpression::QuantificationNode>) {
+                const std::uint32_t scope = lower(node->scope);
+                const SymbolId variable = SymbolTable::global().intern(node->variable.literal);
+                return push({ .opcode = quantifierOpcode(node->quantifier), .traceOperator = traceOperator(node->quantifier), .lhs = scope,
+                              .symbol = variable, .name = SymbolTable::global().name(variable), .source = expr });
+            }
+            else if constexpr (std::is_same_v<Node, QMLExpression::IdentityNode>) {
+                const std::uint32_t first_term = static_cast<std::uint32_t>(terms.size());
+                terms.push_back(compileTerm(node->lhs));
+                terms.push_back(compileTerm(node->rhs));
+                return push({ .opcode = Program::Opcode::IDENTITY, .traceOperator = TraceOperator::IDENTITY, .firstTerm = first_term, .arity = 2, .source = expr });
+            }
+            else {
+                const std::uint32_t first_term = static_cast<std::uint32_t>(terms.size());
+                for (const QMLExpression::Term& argument : node->arguments) {
+                    terms.push_back(compileTerm(argument));
+                }
+                const SymbolId predicate = SymbolTable::global().intern(node->predicate);
+                return push({ .opcode = Program::Opcode::PREDICATION, .traceOperator = TraceOperator::PREDICATION,
+                              .symbol = predicate, .name = SymbolTable::global().name(predicate),
+                              .firstTerm = first_term, .arity = static_cast<std::uint32_t>(node->arguments.size()), .source = expr });
+            }
+        }, expr);
+    }
+};
+
+} // ANONYMOUS NAMESPACE
+
+/**
+ * @brief Compiles an expression.
+ *
+ * Compilation never fails: nodes with an operator or quantifier outside the GSV grammar
+ * are compiled to an INVALID opcode, and fail when evaluated, at the same point as the
+ * tree would.
+ */
+Program::Program(const QMLExpression::Expression& expr)
+{
+    auto code = std::make_shared<Code>();
+    Compiler{ .instructions = code->instructions, .terms = code->terms }.lower(expr);
+    m_Code = std::move(code);
+}
+
+/**
+ * @brief Returns the index of the instruction of the whole expression.
+ */
+std::uint32_t Program::root() const
+{
+    return static_cast<std::uint32_t>(m_Code->instructions.size() - 1);
+}
+
+std::size_t Program::size() const
+{
+    return m_Code->instructions.size();
+}
+
+const Program::Instruction& Program::operator[](std::uint32_t index) const
+{
+    return m_Code->instructions[index];
+}
+
+/**
+ * @brief Returns the arguments of an atomic formula of this program.
+ */
+std::span<const Program::Term> Program::terms(const Instruction& instruction) const
+{
+    return std::span<const Term>(m_Code->terms).subspan(instruction.firstTerm, instruction.arity);
+}
+
+/**
+ * @brief Returns the expression the program was compiled from.
+ */
+const QMLExpression::Expression& Program::source() const
+{
+    return m_Code->instructions.back().source;
+}
+
+/**
+ * @brief True for identity and predication instructions, which only filter their input state.
+ */
+bool isAtomic(const Program::Instruction& instruction)
+{
+    return instruction.opcode == Program::Opcode::IDENTITY || instruction.opcode == Program::Opcode::PREDICATION;
+}
+
+}
@@ -0,0 +1,253 @@
+#include "symbolic_evaluator.hpp"
+
+#include <variant>
+
+#include "evaluation_failure.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+namespace {
+
+/*
+ * Evaluation kernels for variable-free formulas on families of world sets.
+ *
+ * Every kernel mirrors the corresponding `WorldSetEvaluator` kernel, applied to every
+ * state of the family at once: set operations on the updates become boolean operations
+ * on the diagrams of their worlds, and the tests of the epistemic modals become the
+ * diagrams of the states passing them.
+ */
+struct SymbolicEvaluator {
+    const IModel& model;
+    DecisionDiagram& diagram;
+
+    std::expected<SymbolicState, std::string> visit(const QMLExpression::Expression& expr, const SymbolicState& input_state) const
+    {
+        return std::visit([&](const auto& node) { return (*this)(node, input_state); }, expr);
+    }
+
+    /**
+     * @brief The worlds of `s1` in the states where they are not in `s2`.
+     */
+    SymbolicState difference(const SymbolicState& s1, const SymbolicState& s2) const
+    {
+        SymbolicState output(s1.size());
+        for (std::size_t world = 0; world < s1.size(); ++world) {
+            output[world] = diagram.conjunction(s1[world], diagram.negation(s2[world]));
+        }
+        return output;
+    }
+
+    /**
+     * @brief The worlds of a state in the states passing a test.
+     */
+    SymbolicState restriction(const SymbolicState& state, DecisionDiagram::Node test) const
+    {
+        SymbolicState output(state.size());
+        for (std::size_t world = 0; world < state.size(); ++world) {
+            output[world] = diagram.conjunction(state[world], test);
+        }
+        return output;
+    }
+
+    std::expected<SymbolicState, std::string> operator()(const std::shared_ptr<QMLExpression::UnaryNode>& expr, const SymbolicState& input_state) const
+    {
+        const auto prejacent_update = visit(expr->scope, input_state);
+
+        if (!prejacent_update.has_value()) {
+            return std::unexpected(explain_failure(expr, prejacent_update.error()));
+        }
+
+        if (expr->op == QMLExpression::Operator::EPISTEMIC_POSSIBILITY) {
+            return restriction(input_state, nonEmpty(prejacent_update.value(), diagram));
+        }
+        if (expr->op == QMLExpression::Operator::EPISTEMIC_NECESSITY) {
+            return restriction(input_state, isSubsetOf(input_state, prejacent_update.value(), diagram));
+        }
+        if (expr->op == QMLExpression::Operator::NEGATION) {
+            return difference(input_state, prejacent_update.value());
+        }
+
+        return std::unexpected(explain_failure(expr, "Invalid unary operator"));
+    }
+
+    std::expected<SymbolicState, std::string> operator()(const std::shared_ptr<QMLExpression::BinaryNode>& expr, const SymbolicState& input_state) const
+    {
+        const auto lhs_update = visit(expr->lhs, input_state);
+
+        if (!lhs_update.has_value()) {
+            return std::unexpected(explain_failure(expr, lhs_update.error()));
+        }
+
+        if (expr->op == QMLExpression::Operator::CONJUNCTION) {
+            const auto rhs_update = visit(expr->rhs, lhs_update.value());
+
+            if (!rhs_update.has_value()) {
+                return std::unexpected(explain_failure(expr, rhs_update.error()));
+            }
+            return rhs_update.value();
+        }
+
+        if (expr->op == QMLExpression::Operator::DISJUNCTION) {
+            const auto rhs_update = visit(expr->rhs, difference(input_state, lhs_update.value()));
+
+            if (!rhs_update.has_value()) {
+                return std::unexpected(explain_failure(expr, rhs_update.error()));
+            }
+            SymbolicState output(input_state.size());
+            for (std::size_t world = 0; world < input_state.size(); ++world) {
+                output[world] = diagram.conjunction(input_state[world], diagram.disjunction(lhs_update.value()[world], rhs_update.value()[world]));
+            }
+            return output;
+        }
+
+        if (expr->op == QMLExpression::Operator::CONDITIONAL) {
+            const auto consequent_update = visit(expr->rhs, lhs_update.value());
+
+            if (!consequent_update.has_value()) {
+                return std::unexpected(explain_failure(expr, consequent_update.error()));
+            }
+            // A world survives where it is outside the antecedent update, or survives the consequent
+            SymbolicState output(input_state.size());
+            for (std::size_t world = 0; world < input_state.size(); ++world) {
+                const DecisionDiagram::Node survives = diagram.ifThenElse(lhs_update.value()[world], consequent_update.value()[world], DecisionDiagram::ONE);
+                output[world] = diagram.conjunction(input_state[world], survives);
+            }
+            return output;
+        }
+
+        return std::unexpected(explain_failure(expr, "Invalid operator for binary formula"));
+    }
+
+    std::expected<SymbolicState, std::string> operator()(const std::shared_ptr<QMLExpression::QuantificationNode>& expr, const SymbolicState&) const
+    {
+        return std::unexpected(explain_failure(expr, "Quantified formulas cannot be evaluated on world sets"));
+    }
+
+    std::expected<SymbolicState, std::string> operator()(const std::shared_ptr<QMLExpression::IdentityNode>& expr, const SymbolicState& input_state) const
+    {
+        SymbolicState output(input_state.size(), DecisionDiagram::ZERO);
+
+        for (std::size_t world = 0; world < input_state.size(); ++world) {
+            if (input_state[world] == DecisionDiagram::ZERO) {
+                continue;
+            }
+            const auto lhs_denotation = model.termInterpretation(expr->lhs.literal, static_cast<int>(world));
+            if (!lhs_denotation.has_value()) {
+                return std::unexpected(explain_failure(expr, lhs_denotation.error()));
+            }
+            const auto rhs_denotation = model.termInterpretation(expr->rhs.literal, static_cast<int>(world));
+            if (!rhs_denotation.has_value()) {
+                return std::unexpected(explain_failure(expr, rhs_denotation.error()));
+            }
+            if (lhs_denotation.value() == rhs_denotation.value()) {
+                output[world] = input_state[world];
+            }
+        }
+        return output;
+    }
+
+    std::expected<SymbolicState, std::string> operator()(const std::shared_ptr<QMLExpression::PredicationNode>& expr, const SymbolicState& input_state) const
+    {
+        SymbolicState output(input_state.size(), DecisionDiagram::ZERO);
+        std::vector<int> tuple;
+        tuple.reserve(expr->arguments.size());
+
+        for (std::size_t world = 0; world < input_state.size(); ++world) {
+            if (input_state[world] == DecisionDiagram::ZERO) {
+                continue;
+            }
+            tuple.clear();
+            for (const QMLExpression::Term& argument : expr->arguments) {
+                const auto denotation = model.termInterpretation(argument.literal, static_cast<int>(world));
+                if (!denotation.has_value()) {
+                    return std::unexpected(explain_failure(expr, denotation.error()));
+                }
+                tuple.push_back(denotation.value());
+            }
+            const auto predint = model.predicateInterpretation(expr->predicate, static_cast<int>(world));
+            if (!predint.has_value()) {
+                return std::unexpected(explain_failure(expr, predint.error()));
+            }
+            if (predint.value()->contains(tuple)) {
+                output[world] = input_state[world];
+            }
+        }
+        return output;
+    }
+};
+
+} // ANONYMOUS NAMESPACE
+
+/**
+ * @brief The family of every world set of the model of a diagram, as its own update.
+ *
+ * Element `w` is the diagram of the world sets containing `w`.
+ */
+SymbolicState everyState(DecisionDiagram& diagram)
+{
+    SymbolicState state(diagram.worlds());
+    for (int world = 0; world < diagram.worlds(); ++world) {
+        state[world] = diagram.world(world);
+    }
+    return state;
+}
+
+/**
+ * @brief Evaluates a variable-free expression on every state of a family at once, relative to a base model.
+ *
+ * This is the symbolic counterpart of `evaluate()` on world sets: for every world set `s`,
+ * the worlds of `evaluate(expr, s, model)` are the worlds whose diagrams in the result
+ * contain `s`, provided `s` is in the family of `input_state`. An interpretation is looked
+ * up at every world some state of the family reaches, in no particular order, so the
+ * evaluation fails as soon as one of them fails, even if no single state would fail on it:
+ * callers that must report errors as `evaluate()` does should then fall back to it.
+ *
+ * @param expr The expression to evaluate. Must satisfy `isVariableFree(expr)`.
+ * @param input_state The family of states in which the expression is evaluated.
+ * @param model The model providing the interpretation of terms and predicates.
+ * @param diagram The manager of the diagrams of `input_state`, which receives those of the result.
+ * @return std::expected<SymbolicState, std::string> The updated family if evaluation is
+ *         successful, or an error message if some interpretation fails.
+ */
+std::expected<SymbolicState, std::string> evaluate(const QMLExpression::Expression& expr, const SymbolicState& input_state, const IModel& model, DecisionDiagram& diagram)
+{
+    return SymbolicEvaluator{ model, diagram }.visit(expr, input_state);
+}
+
+/**
+ * @brief The diagram of the states whose update in a family is non-empty.
+ */
+DecisionDiagram::Node nonEmpty(const SymbolicState& state, DecisionDiagram& diagram)
+{
+    DecisionDiagram::Node output = DecisionDiagram::ZERO;
+    for (const DecisionDiagram::Node world : state) {
+        output = diagram.disjunction(output, world);
+    }
+    return output;
+}
+
+/**
+ * @brief The diagram of the states whose update in `s1` is a subset of their update in `s2`.
+ */
+DecisionDiagram::Node isSubsetOf(const SymbolicState& s1, const SymbolicState& s2, DecisionDiagram& diagram)
+{
+    DecisionDiagram::Node output = DecisionDiagram::ONE;
+    for (std::size_t world = 0; world < s1.size(); ++world) {
+        output = diagram.conjunction(output, diagram.ifThenElse(s1[world], s2[world], DecisionDiagram::ONE));
+    }
+    return output;
+}
+
+/**
+ * @brief The diagram of the states whose updates in `s1` and `s2` differ.
+ */
+DecisionDiagram::Node differ(const SymbolicState& s1, const SymbolicState& s2, DecisionDiagram& diagram)
+{
+    DecisionDiagram::Node output = DecisionDiagram::ZERO;
+    for (std::size_t world = 0; world < s1.size(); ++world) {
+        output = diagram.disjunction(output, diagram.ifThenElse(s1[world], diagram.negation(s2[world]), s2[world]));
+    }
+    return output;
+}
+
+}
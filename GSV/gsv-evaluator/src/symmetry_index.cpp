@@ -0,0 +1,165 @@
+#include "symmetry_index.hpp"
+
+#include <algorithm>
+#include <set>
+
+#include "iindexed_model.hpp"
+#include "symbol_table.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+namespace {
+
+/**
+ * @brief The predicates (with their arities) and the constants (with arity -1) of a program, sorted.
+ */
+std::vector<std::pair<SymbolId, int>> vocabulary(const Program& program)
+{
+    std::vector<std::pair<SymbolId, int>> symbols;
+    for (std::uint32_t i = 0; i < program.size(); ++i) {
+        const Program::Instruction& instruction = program[i];
+        if (instruction.opcode == Program::Opcode::PREDICATION) {
+            symbols.emplace_back(instruction.symbol, static_cast<int>(instruction.arity));
+        }
+        if (isAtomic(instruction)) {
+            for (const Program::Term& term : program.terms(instruction)) {
+                if (!term.variable) {
+                    symbols.emplace_back(term.symbol, -1);
+                }
+            }
+        }
+    }
+    std::ranges::sort(symbols);
+    symbols.erase(std::unique(symbols.begin(), symbols.end()), symbols.end());
+    return symbols;
+}
+
+/**
+ * @brief Whether swapping two individuals maps a set of tuples onto itself.
+ */
+bool preservedBySwap(const std::set<std::vector<int>>& extension, int a, int b)
+{
+    std::vector<int> image;
+    for (const std::vector<int>& tuple : extension) {
+        if (std::ranges::find(tuple, a) == tuple.end() && std::ranges::find(tuple, b) == tuple.end()) {
+            continue;
+        }
+        image = tuple;
+        for (int& element : image) {
+            element = element == a ? b : element == b ? a : element;
+        }
+        if (!extension.contains(image)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // ANONYMOUS NAMESPACE
+
+SymmetryIndex::SymmetryIndex(const IModel& model)
+    : m_Model(&model)
+{ }
+
+const IModel& SymmetryIndex::model() const
+{
+    return *m_Model;
+}
+
+/**
+ * @brief For every individual of the domain, the least individual interchangeable with it in the vocabulary of a program.
+ *
+ * Individuals denoted by a constant of the program at some world are their own
+ * representatives. The span stays valid for the lifetime of the index.
+ */
+std::span<const int> SymmetryIndex::representatives(const Program& program) const
+{
+    Vocabulary symbols = vocabulary(program);
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_Partitions.find(symbols);
+    if (it == m_Partitions.end()) {
+        std::vector<int> partitioned = partition(symbols);
+        it = m_Partitions.emplace(std::move(symbols), std::move(partitioned)).first;
+    }
+    return it->second;
+}
+
+/**
+ * @brief Everything the evaluator needs to reduce the quantifiers of a program (see `SymmetryPlan`).
+ */
+SymmetryPlan SymmetryIndex::plan(const Program& program) const
+{
+    return { .representatives = representatives(program) };
+}
+
+/**
+ * @brief Computes the representatives of the individuals of the domain in a vocabulary.
+ *
+ * Interchangeability is an equivalence relation (the swaps preserving the vocabulary
+ * generate a group), so every individual is only compared with the representatives found
+ * so far, and only with those occurring in the extensions as often, at the same worlds
+ * and positions. Uninterpreted symbols are left out: evaluating them fails the same way
+ * for every individual.
+ */
+std::vector<int> SymmetryIndex::partition(const Vocabulary& vocabulary) const
+{
+    const int domain_cardinality = m_Model->domainCardinality();
+    const int world_cardinality = m_Model->worldCardinality();
+    const IIndexedModel* indexed_model = dynamic_cast<const IIndexedModel*>(m_Model);
+    const SymbolTable& symbols = SymbolTable::global();
+
+    std::vector<std::uint8_t> named(domain_cardinality, 0);
+    std::vector<std::uint64_t> profiles(domain_cardinality, 0);
+    std::vector<const std::set<std::vector<int>>*> extensions;
+
+    for (const auto& [symbol, arity] : vocabulary) {
+        for (int world = 0; world < world_cardinality; ++world) {
+            if (arity < 0) {
+                const auto denotation = indexed_model != nullptr ? indexed_model->termInterpretationById(symbol, world) : m_Model->termInterpretation(symbols.name(symbol), world);
+                if (denotation.has_value() && denotation.value() >= 0 && denotation.value() < domain_cardinality) {
+                    named[denotation.value()] = 1;
+                }
+                continue;
+            }
+
+            const auto extension = indexed_model != nullptr ? indexed_model->predicateInterpretationById(symbol, world) : m_Model->predicateInterpretation(symbols.name(symbol), world);
+            if (!extension.has_value() || extension.value() == nullptr) {
+                continue;
+            }
+            const std::uint64_t extension_id = extensions.size();
+            extensions.push_back(extension.value());
+            for (const std::vector<int>& tuple : *extension.value()) {
+                for (std::size_t position = 0; position < tuple.size(); ++position) {
+                    if (tuple[position] >= 0 && tuple[position] < domain_cardinality) {
+                        const std::uint64_t occurrence = (extension_id << 16) ^ position;
+                        profiles[tuple[position]] += (occurrence + 1) * 0x9e3779b97f4a7c15ULL ^ (occurrence >> 7);
+                    }
+                }
+            }
+        }
+    }
+
+    const auto interchangeable = [&](int a, int b) {
+        return std::ranges::all_of(extensions, [&](const std::set<std::vector<int>>* extension) { return preservedBySwap(*extension, a, b); });
+    };
+
+    std::vector<int> representatives(domain_cardinality);
+    std::vector<int> classes;
+    for (int d = 0; d < domain_cardinality; ++d) {
+        representatives[d] = d;
+        if (named[d]) {
+            continue;
+        }
+        const auto representative = std::ranges::find_if(classes, [&](int r) { return profiles[r] == profiles[d] && interchangeable(r, d); });
+        if (representative != classes.end()) {
+            representatives[d] = *representative;
+        }
+        else {
+            classes.push_back(d);
+        }
+    }
+    return representatives;
+}
+
+}
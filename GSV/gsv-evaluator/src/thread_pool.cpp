@@ -0,0 +1,128 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief Starts the worker threads.
+ *
+ * @param thread_count Number of workers. The calling thread of `parallelFor()` also runs
+ *        loop bodies, so a pool with `n` workers runs up to `n + 1` bodies at a time.
+ */
+ThreadPool::ThreadPool(unsigned thread_count)
+{
+    m_Workers.reserve(thread_count);
+    for (unsigned i = 0; i < thread_count; ++i) {
+        m_Workers.emplace_back([this](std::stop_token stop_token) { work(stop_token); });
+    }
+}
+
+/**
+ * @brief Stops and joins the worker threads.
+ *
+ * Must not be called while a `parallelFor()` is running.
+ */
+ThreadPool::~ThreadPool()
+{
+    for (std::jthread& worker : m_Workers) {
+        worker.request_stop();
+    }
+    m_JobAvailable.notify_all();
+}
+
+std::size_t ThreadPool::threadCount() const
+{
+    return m_Workers.size();
+}
+
+/**
+ * @brief Calls `body(i)` for every `i` in `[0, count)`, distributing the calls over the pool.
+ *
+ * Returns once every call has finished. Calls run in no particular order. If any call
+ * throws, the remaining indices are still run, and the first exception caught is
+ * rethrown to the caller.
+ *
+ * @param count Number of iterations.
+ * @param body Loop body. It is called concurrently from several threads.
+ */
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& body)
+{
+    if (count == 0) {
+        return;
+    }
+
+    const auto job = std::make_shared<Job>();
+    job->body = &body;
+    job->count = count;
+
+    if (count > 1 && !m_Workers.empty()) {
+        {
+            std::scoped_lock lock(m_Mutex);
+            m_Jobs.push_back(job);
+        }
+        m_JobAvailable.notify_all();
+    }
+
+    run(*job);
+    retire(job);
+
+    for (std::size_t done = job->done.load(); done < count; done = job->done.load()) {
+        job->done.wait(done);
+    }
+
+    if (job->error) {
+        std::rethrow_exception(job->error);
+    }
+}
+
+void ThreadPool::work(std::stop_token stop_token)
+{
+    while (true) {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock lock(m_Mutex);
+            if (!m_JobAvailable.wait(lock, stop_token, [this] { return !m_Jobs.empty(); })) {
+                return;
+            }
+            job = m_Jobs.front();
+        }
+        run(*job);
+        retire(job);
+    }
+}
+
+/**
+ * @brief Runs loop bodies of a job until all its indices have been claimed.
+ */
+void ThreadPool::run(Job& job)
+{
+    for (std::size_t i = job.next.fetch_add(1); i < job.count; i = job.next.fetch_add(1)) {
+        try {
+            (*job.body)(i);
+        }
+        catch (...) {
+            std::scoped_lock lock(job.errorMutex);
+            if (!job.error) {
+                job.error = std::current_exception();
+            }
+        }
+        if (job.done.fetch_add(1) + 1 == job.count) {
+            job.done.notify_all();
+        }
+    }
+}
+
+/**
+ * @brief Removes a job with no unclaimed indices from the queue, if still there.
+ */
+void ThreadPool::retire(const std::shared_ptr<Job>& job)
+{
+    std::scoped_lock lock(m_Mutex);
+    const auto it = std::ranges::find(m_Jobs, job);
+    if (it != m_Jobs.end()) {
+        m_Jobs.erase(it);
+    }
+}
+
+}
@@ -0,0 +1,77 @@
+#include "trace.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief Maps a QML operator to the operator reported in trace events.
+ *
+ * @param op The operator of a unary or binary node.
+ * @return The corresponding TraceOperator, or INVALID if the operator is not part of the GSV grammar.
+ */
+TraceOperator traceOperator(QMLExpression::Operator op)
+{
+    switch (op) {
+    case QMLExpression::Operator::NEGATION:
+        return TraceOperator::NEGATION;
+    case QMLExpression::Operator::EPISTEMIC_POSSIBILITY:
+        return TraceOperator::EPISTEMIC_POSSIBILITY;
+    case QMLExpression::Operator::EPISTEMIC_NECESSITY:
+        return TraceOperator::EPISTEMIC_NECESSITY;
+    case QMLExpression::Operator::CONJUNCTION:
+        return TraceOperator::CONJUNCTION;
+    case QMLExpression::Operator::DISJUNCTION:
+        return TraceOperator::DISJUNCTION;
+    case QMLExpression::Operator::CONDITIONAL:
+        return TraceOperator::CONDITIONAL;
+    default:
+        return TraceOperator::INVALID;
+    }
+}
+
+/**
+ * @brief Maps a QML quantifier to the operator reported in trace events.
+ *
+ * @param quantifier The quantifier of a quantification node.
+ * @return The corresponding TraceOperator, or INVALID if the quantifier is not part of the GSV grammar.
+ */
+TraceOperator traceOperator(QMLExpression::Quantifier quantifier)
+{
+    switch (quantifier) {
+    case QMLExpression::Quantifier::EXISTENTIAL:
+        return TraceOperator::EXISTENTIAL;
+    case QMLExpression::Quantifier::UNIVERSAL:
+        return TraceOperator::UNIVERSAL;
+    default:
+        return TraceOperator::INVALID;
+    }
+}
+
+std::string_view str(TraceOperator op)
+{
+    switch (op) {
+    case TraceOperator::NEGATION:
+        return "negation";
+    case TraceOperator::EPISTEMIC_POSSIBILITY:
+        return "epistemic possibility";
+    case TraceOperator::EPISTEMIC_NECESSITY:
+        return "epistemic necessity";
+    case TraceOperator::CONJUNCTION:
+        return "conjunction";
+    case TraceOperator::DISJUNCTION:
+        return "disjunction";
+    case TraceOperator::CONDITIONAL:
+        return "conditional";
+    case TraceOperator::EXISTENTIAL:
+        return "existential";
+    case TraceOperator::UNIVERSAL:
+        return "universal";
+    case TraceOperator::IDENTITY:
+        return "identity";
+    case TraceOperator::PREDICATION:
+        return "predication";
+    default:
+        return "invalid";
+    }
+}
+
+}
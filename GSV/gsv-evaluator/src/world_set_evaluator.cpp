@@ -0,0 +1,227 @@
+#include "world_set_evaluator.hpp"
+
+#include <algorithm>
+#include <variant>
+#include <vector>
+
+#include "evaluation_failure.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+namespace {
+
+/*
+ * Evaluation kernels for variable-free formulas on world sets.
+ *
+ * Every kernel mirrors the corresponding `Evaluator` clause, specialized to states
+ * in which possibilities are identified by their world. Model lookups are performed
+ * in ascending world order, so that failures are reported exactly as the
+ * `Evaluator` would report them.
+ */
+struct WorldSetEvaluator {
+    const IModel& model;
+
+    std::expected<WorldSet, std::string> visit(const QMLExpression::Expression& expr, const WorldSet& input_state) const
+    {
+        return std::visit([&](const auto& node) { return (*this)(node, input_state); }, expr);
+    }
+
+    std::expected<WorldSet, std::string> operator()(const std::shared_ptr<QMLExpression::UnaryNode>& expr, const WorldSet& input_state) const
+    {
+        const auto prejacent_update = visit(expr->scope, input_state);
+
+        if (!prejacent_update.has_value()) {
+            return std::unexpected(explain_failure(expr, prejacent_update.error()));
+        }
+
+        if (expr->op == QMLExpression::Operator::EPISTEMIC_POSSIBILITY) {
+            return prejacent_update.value().empty() ? WorldSet(input_state.worlds()) : input_state;
+        }
+        if (expr->op == QMLExpression::Operator::EPISTEMIC_NECESSITY) {
+            return isSubsetOf(input_state, prejacent_update.value()) ? input_state : WorldSet(input_state.worlds());
+        }
+        if (expr->op == QMLExpression::Operator::NEGATION) {
+            return input_state - prejacent_update.value();
+        }
+
+        return std::unexpected(explain_failure(expr, "Invalid unary operator"));
+    }
+
+    std::expected<WorldSet, std::string> operator()(const std::shared_ptr<QMLExpression::BinaryNode>& expr, const WorldSet& input_state) const
+    {
+        const auto lhs_update = visit(expr->lhs, input_state);
+
+        if (!lhs_update.has_value()) {
+            return std::unexpected(explain_failure(expr, lhs_update.error()));
+        }
+
+        if (expr->op == QMLExpression::Operator::CONJUNCTION) {
+            const auto rhs_update = visit(expr->rhs, lhs_update.value());
+
+            if (!rhs_update.has_value()) {
+                return std::unexpected(explain_failure(expr, rhs_update.error()));
+            }
+            return rhs_update.value();
+        }
+
+        if (expr->op == QMLExpression::Operator::DISJUNCTION) {
+            // The update with the negated LHS is the input state minus the LHS update
+            const auto rhs_update = visit(expr->rhs, input_state - lhs_update.value());
+
+            if (!rhs_update.has_value()) {
+                return std::unexpected(explain_failure(expr, rhs_update.error()));
+            }
+            return input_state & (lhs_update.value() | rhs_update.value());
+        }
+
+        if (expr->op == QMLExpression::Operator::CONDITIONAL) {
+            const auto consequent_update = visit(expr->rhs, lhs_update.value());
+
+            if (!consequent_update.has_value()) {
+                return std::unexpected(explain_failure(expr, consequent_update.error()));
+            }
+            // Worlds outside the antecedent update survive, worlds inside it survive iff they survive the consequent
+            return (input_state - lhs_update.value()) | (input_state & consequent_update.value());
+        }
+
+        return std::unexpected(explain_failure(expr, "Invalid operator for binary formula"));
+    }
+
+    std::expected<WorldSet, std::string> operator()(const std::shared_ptr<QMLExpression::QuantificationNode>& expr, const WorldSet&) const
+    {
+        return std::unexpected(explain_failure(expr, "Quantified formulas cannot be evaluated on world sets"));
+    }
+
+    std::expected<WorldSet, std::string> operator()(const std::shared_ptr<QMLExpression::IdentityNode>& expr, const WorldSet& input_state) const
+    {
+        WorldSet output(input_state.worlds());
+        std::string failure;
+
+        input_state.forEach([&](int world) {
+            if (!failure.empty()) {
+                return;
+            }
+            const auto lhs_denotation = model.termInterpretation(expr->lhs.literal, world);
+            if (!lhs_denotation.has_value()) {
+                failure = lhs_denotation.error();
+                return;
+            }
+            const auto rhs_denotation = model.termInterpretation(expr->rhs.literal, world);
+            if (!rhs_denotation.has_value()) {
+                failure = rhs_denotation.error();
+                return;
+            }
+            if (lhs_denotation.value() == rhs_denotation.value()) {
+                output.insert(world);
+            }
+        });
+
+        if (!failure.empty()) {
+            return std::unexpected(explain_failure(expr, failure));
+        }
+        return output;
+    }
+
+    std::expected<WorldSet, std::string> operator()(const std::shared_ptr<QMLExpression::PredicationNode>& expr, const WorldSet& input_state) const
+    {
+        WorldSet output(input_state.worlds());
+        std::vector<int> tuple;
+        tuple.reserve(expr->arguments.size());
+        std::string failure;
+
+        input_state.forEach([&](int world) {
+            if (!failure.empty()) {
+                return;
+            }
+            tuple.clear();
+            for (const QMLExpression::Term& argument : expr->arguments) {
+                const auto denotation = model.termInterpretation(argument.literal, world);
+                if (!denotation.has_value()) {
+                    failure = denotation.error();
+                    return;
+                }
+                tuple.push_back(denotation.value());
+            }
+            const auto predint = model.predicateInterpretation(expr->predicate, world);
+            if (!predint.has_value()) {
+                failure = predint.error();
+                return;
+            }
+            if (predint.value()->contains(tuple)) {
+                output.insert(world);
+            }
+        });
+
+        if (!failure.empty()) {
+            return std::unexpected(explain_failure(expr, failure));
+        }
+        return output;
+    }
+};
+
+struct VariableFreeChecker {
+    bool operator()(const std::shared_ptr<QMLExpression::UnaryNode>& expr) const
+    {
+        return std::visit(*this, expr->scope);
+    }
+
+    bool operator()(const std::shared_ptr<QMLExpression::BinaryNode>& expr) const
+    {
+        return std::visit(*this, expr->lhs) && std::visit(*this, expr->rhs);
+    }
+
+    bool operator()(const std::shared_ptr<QMLExpression::QuantificationNode>&) const
+    {
+        return false;
+    }
+
+    bool operator()(const std::shared_ptr<QMLExpression::IdentityNode>& expr) const
+    {
+        return expr->lhs.type != QMLExpression::Term::Type::VARIABLE && expr->rhs.type != QMLExpression::Term::Type::VARIABLE;
+    }
+
+    bool operator()(const std::shared_ptr<QMLExpression::PredicationNode>& expr) const
+    {
+        return std::ranges::none_of(expr->arguments, [](const QMLExpression::Term& argument) -> bool {
+            return argument.type == QMLExpression::Term::Type::VARIABLE;
+        });
+    }
+};
+
+} // ANONYMOUS NAMESPACE
+
+/**
+ * @brief Determines whether an expression can be evaluated on world sets.
+ *
+ * An expression is variable-free if it contains no quantifiers and no variable
+ * occurrences. Updating a variable-free state with such an expression never introduces
+ * pegs, so the whole evaluation can be carried out on `WorldSet`s.
+ *
+ * @param expr The expression to inspect.
+ * @return True if the expression is quantifier-free and contains no variables, false otherwise.
+ */
+bool isVariableFree(const QMLExpression::Expression& expr)
+{
+    return std::visit(VariableFreeChecker(), expr);
+}
+
+/**
+ * @brief Evaluates a variable-free expression on a world set, relative to a base model.
+ *
+ * This is the dense counterpart of `evaluate()` for variable-free states: for any
+ * variable-free expression, the worlds of `evaluate(expr, toInformationState(s), model)`
+ * are exactly `evaluate(expr, s, model)`, and both calls fail with the same error message.
+ * The clauses of each operator reduce to bitwise filters, intersections and subset tests.
+ *
+ * @param expr The expression to evaluate. Must satisfy `isVariableFree(expr)`.
+ * @param input_state The world set in which the expression is evaluated.
+ * @param model The model providing the interpretation of terms and predicates.
+ * @return std::expected<WorldSet, std::string> The updated world set if evaluation is
+ *         successful, or an error message if evaluation fails.
+ */
+std::expected<WorldSet, std::string> evaluate(const QMLExpression::Expression& expr, const WorldSet& input_state, const IModel& model)
+{
+    return WorldSetEvaluator{ model }.visit(expr, input_state);
+}
+
+}
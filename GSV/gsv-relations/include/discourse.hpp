@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <QMLExpression/expression.hpp>
+
+#include "extension_index.hpp"
+#include "imodel.hpp"
+#include "information_state.hpp"
+#include "relation_options.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief An incremental discourse: an information state updated one sentence at a time.
+ *
+ * A discourse starts from the ignorant state of its model (or from a given state), and
+ * retains the state reached by the sentences accepted so far. Every call to `update()`
+ * evaluates the new sentence only, on the retained state, so its cost does not depend on
+ * the length of the discourse. `supports()` and `allows()` are checked against the
+ * current state without changing it.
+ *
+ * States and histories are persistent and shared, so `checkpoint()` and `rollback()`
+ * are constant-time, and a checkpoint may be restored any number of times, even after
+ * the discourse has moved on to other sentences. States are only kept alive by the
+ * discourse and its checkpoints: a state that is neither current nor checkpointed is
+ * released as soon as it is replaced.
+ *
+ * Updates and queries use the collaborators of the options given on construction,
+ * except `counterexample`, which is ignored. The logger only logs updates when
+ * `logDetails` is set. When the options carry no extension index of the model, the
+ * discourse builds one of its own, once. The model (and any collaborator) must outlive
+ * the discourse.
+ *
+ * A discourse must not be used by several threads at once, but different discourses may
+ * run concurrently against the same model, and copies of a discourse continue
+ * independently from the same state.
+ */
+class Discourse {
+    struct Turn;
+
+public:
+    /**
+     * @brief A state of a discourse, together with the sentences that led to it.
+     */
+    struct Checkpoint {
+        std::shared_ptr<const InformationState> state;
+        std::shared_ptr<const Turn> history;
+    };
+
+    explicit Discourse(const IModel& model, const RelationOptions& options = {});
+    Discourse(const IModel& model, InformationState state, const RelationOptions& options = {});
+
+    std::expected<void, std::string> update(const QMLExpression::Expression& sentence);
+    std::expected<bool, std::string> supports(const QMLExpression::Expression& expr) const;
+    std::expected<bool, std::string> allows(const QMLExpression::Expression& expr) const;
+
+    const InformationState& state() const;
+    bool absurd() const;
+    std::size_t length() const;
+    std::vector<QMLExpression::Expression> sentences() const;
+
+    Checkpoint checkpoint() const;
+    void rollback(const Checkpoint& checkpoint);
+
+private:
+    const IModel* m_Model;
+    std::shared_ptr<const ExtensionIndex> m_Extensions;
+    RelationOptions m_Options;
+    std::shared_ptr<const InformationState> m_State;
+    std::shared_ptr<const Turn> m_History;
+};
+
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <SimpleLogger/simple_logger.hpp>
+
+#include "evaluation_cache.hpp"
+#include "evaluation_context.hpp"
+#include "extension_index.hpp"
+#include "information_state.hpp"
+#include "profiler.hpp"
+#include "symmetry_index.hpp"
+#include "thread_pool.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief How the model-level relations decide whether the information states of a model satisfy them.
+ *
+ * - **ENUMERATIVE**: every information state is updated and checked in turn, one size at
+ *   a time, so the work grows with the number of states, exponentially in the number of
+ *   worlds.
+ * - **SYMBOLIC**: the updates of all the information states are computed at once, as
+ *   decision diagrams over the worlds (see `DecisionDiagram`), and the relation is decided
+ *   on the diagram of the states that falsify it, from which the counterexample the
+ *   enumeration would have found first is read off. The work grows with the size of the
+ *   diagrams, which stay small for the modal and boolean structure of typical formulas,
+ *   so models with far more worlds than can be enumerated are within reach.
+ */
+enum class RelationBackend {
+    ENUMERATIVE,
+    SYMBOLIC
+};
+
+/**
+ * @brief Optional collaborators of the model-level semantic relations.
+ *
+ * The relations are reentrant, like `evaluate()` (see `Evaluator`): concurrent calls may
+ * share the model and any of these collaborators, except `counterexample`, which every
+ * call writes to, and loggers that are not thread-safe.
+ *
+ * - **logger**, **logDetails**: as in the overloads taking a logger. `logDetails` also
+ *   logs every evaluation performed while checking the relation.
+ * - **executor**: if set, the information states of the model are checked in parallel on
+ *   this pool, and the search stops as soon as the outcome is known. Results, error
+ *   messages and counterexamples are the same as in a serial search. The search is
+ *   serial whenever a logger is attached, so that the log keeps its order.
+ * - **counterexample**: if set, and `entails_G`, `entails_C` or `equivalent` fail to
+ *   hold, it receives the input state that falsifies the relation.
+ * - **cache**: if set, every evaluation performed by the relation goes through this
+ *   cache (see `EvaluationCache`). The same cache can be passed to any number of calls,
+ *   so premises shared by several checks are evaluated once per state.
+ * - **extensions**: an index of the predicate extensions of the model (see
+ *   `ExtensionIndex`). The model-level relations build their own index when none is
+ *   given, so passing one only saves rebuilding it across calls on the same model.
+ * - **shortCircuit**: as in `EvaluationOptions`. Consistency checks then stop at the first
+ *   possibility that survives the update.
+ * - **useArena**: as in `EvaluationOptions`. Every evaluation performed by the relation
+ *   allocates its intermediate states from an arena of its own, so the memory used while
+ *   checking one information state is released as soon as that state is checked.
+ * - **profiler**: if set, it profiles every evaluation performed by the relation, and
+ *   counts the calls to the relation, the information states they check, and the
+ *   searches settled early by a state (see `Profiler`).
+ * - **context**: if set, every information state checked by the relation, and every
+ *   subformula evaluated while checking it, is first admitted by this context, and the
+ *   relation fails as soon as the context refuses (see `EvaluationContext`).
+ * - **symmetry**: as in `EvaluationOptions`. Every evaluation performed by the relation
+ *   derives the quantifier branches of interchangeable individuals from one another (see
+ *   `SymmetryIndex`). Passing one index to every call on the same model computes the
+ *   partition of each vocabulary only once.
+ * - **backend**: the way the relations are decided (see `RelationBackend`). The symbolic
+ *   backend decides `consistent`, `coherent`, `entails_G`, `entails_C`, `equivalent` and
+ *   the entailment batches when all their expressions are variable-free, no logger or
+ *   context is attached, and every interpretation the expressions need is defined; in every
+ *   other case, the relations are decided by enumeration. Results and counterexamples are
+ *   the same with either backend. The symbolic backend checks no individual state, so the
+ *   profiler records no states for it.
+ */
+struct RelationOptions {
+    simple_logger::SimpleLogger* logger = nullptr;
+    bool logDetails = false;
+    ThreadPool* executor = nullptr;
+    InformationState* counterexample = nullptr;
+    EvaluationCache* cache = nullptr;
+    const ExtensionIndex* extensions = nullptr;
+    bool shortCircuit = false;
+    bool useArena = false;
+    Profiler* profiler = nullptr;
+    EvaluationContext* context = nullptr;
+    const SymmetryIndex* symmetry = nullptr;
+    RelationBackend backend = RelationBackend::ENUMERATIVE;
+};
+
+}
@@ -9,6 +9,8 @@
 
 #include "imodel.hpp"
 #include "information_state.hpp"
+#include "program.hpp"
+#include "relation_options.hpp"
 
 namespace iif_sadaf::talk::GSV {
 
@@ -25,4 +27,47 @@ std::expected<bool, std::string> entails_G(const std::vector<QMLExpression::Expr
 std::expected<bool, std::string> entails_C(const std::vector<QMLExpression::Expression>& premises, const QMLExpression::Expression& conclusion, const IModel& model, simple_logger::SimpleLogger* logger = nullptr, bool log_details = false);
 std::expected<bool, std::string> equivalent(const QMLExpression::Expression& expr1, const QMLExpression::Expression& expr2, const IModel& model, simple_logger::SimpleLogger* logger = nullptr, bool log_details = false);
 
+std::expected<bool, std::string> consistent(const QMLExpression::Expression& expr, const InformationState& state, const IModel& model, const RelationOptions& options);
+std::expected<bool, std::string> allows(const InformationState& state, const QMLExpression::Expression& expr, const IModel& model, const RelationOptions& options);
+std::expected<bool, std::string> supports(const InformationState& state, const QMLExpression::Expression& expr, const IModel& model, const RelationOptions& options);
+std::expected<bool, std::string> isSupportedBy(const QMLExpression::Expression& expr, const InformationState& state, const IModel& model, const RelationOptions& options);
+
+std::expected<bool, std::string> consistent(const QMLExpression::Expression& expr, const IModel& model, const RelationOptions& options);
+std::expected<bool, std::string> coherent(const QMLExpression::Expression& expr, const IModel& model, const RelationOptions& options);
+std::expected<bool, std::string> entails(const std::vector<QMLExpression::Expression>& premises, const QMLExpression::Expression& conclusion, const IModel& model, const RelationOptions& options);
+std::expected<bool, std::string> entails_0(const std::vector<QMLExpression::Expression>& premises, const QMLExpression::Expression& conclusion, const IModel& model, const RelationOptions& options);
+std::expected<bool, std::string> entails_G(const std::vector<QMLExpression::Expression>& premises, const QMLExpression::Expression& conclusion, const IModel& model, const RelationOptions& options);
+std::expected<bool, std::string> entails_C(const std::vector<QMLExpression::Expression>& premises, const QMLExpression::Expression& conclusion, const IModel& model, const RelationOptions& options);
+std::expected<bool, std::string> equivalent(const QMLExpression::Expression& expr1, const QMLExpression::Expression& expr2, const IModel& model, const RelationOptions& options);
+
+/**
+ * @brief What the batch checks need to know of their formulas, whatever the model.
+ *
+ * Built once from the compiled premises and conclusions of a batch, an analysis can be
+ * passed, with the same programs, to the batch checks of any number of models, which then
+ * neither compile nor analyse the formulas again.
+ *
+ * - **premises**, **conclusions**: the source expressions of the programs.
+ * - **expressions**: the premises followed by the conclusions.
+ * - **variableFree**: whether every premise and conclusion is variable-free.
+ * - **distributive**: per conclusion, whether it and every premise are distributive.
+ */
+struct BatchAnalysis {
+    BatchAnalysis(const std::vector<Program>& premise_programs, const std::vector<Program>& conclusion_programs);
+
+    std::vector<QMLExpression::Expression> premises;
+    std::vector<QMLExpression::Expression> conclusions;
+    std::vector<QMLExpression::Expression> expressions;
+    bool variableFree = false;
+    std::vector<bool> distributive;
+};
+
+std::vector<std::expected<bool, std::string>> entails_batch(const std::vector<QMLExpression::Expression>& premises, const std::vector<QMLExpression::Expression>& conclusions, const IModel& model, const RelationOptions& options = {});
+std::vector<std::expected<bool, std::string>> entails_G_batch(const std::vector<QMLExpression::Expression>& premises, const std::vector<QMLExpression::Expression>& conclusions, const IModel& model, const RelationOptions& options = {});
+std::vector<std::expected<bool, std::string>> entails_C_batch(const std::vector<QMLExpression::Expression>& premises, const std::vector<QMLExpression::Expression>& conclusions, const IModel& model, const RelationOptions& options = {});
+
+std::vector<std::expected<bool, std::string>> entails_batch(const std::vector<Program>& premises, const std::vector<Program>& conclusions, const BatchAnalysis& analysis, const IModel& model, const RelationOptions& options = {});
+std::vector<std::expected<bool, std::string>> entails_G_batch(const std::vector<Program>& premises, const std::vector<Program>& conclusions, const BatchAnalysis& analysis, const IModel& model, const RelationOptions& options = {});
+std::vector<std::expected<bool, std::string>> entails_C_batch(const std::vector<Program>& premises, const std::vector<Program>& conclusions, const BatchAnalysis& analysis, const IModel& model, const RelationOptions& options = {});
+
 }
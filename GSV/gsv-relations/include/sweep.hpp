@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <QMLExpression/expression.hpp>
+
+#include "evaluation_cache.hpp"
+#include "evaluation_context.hpp"
+#include "imodel.hpp"
+#include "information_state.hpp"
+#include "profiler.hpp"
+#include "program.hpp"
+#include "relation_options.hpp"
+#include "thread_pool.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief The update of the ignorant state of one model of a sweep with one of its formulas.
+ */
+struct SweepEvaluation {
+    std::size_t formula;
+    std::size_t model;
+    std::expected<InformationState, std::string> update;
+};
+
+/**
+ * @brief Whether the premises of a sweep entail one of its formulas in one of its models.
+ */
+struct SweepEntailment {
+    std::size_t conclusion;
+    std::size_t model;
+    std::expected<bool, std::string> holds;
+};
+
+/**
+ * @brief Optional collaborators of a sweep, shared by all its (formula, model) pairs.
+ *
+ * - **executor**: if set, the models are spread over this pool, and so are the formulas
+ *   of every model, so pairs are claimed one at a time by whichever thread is free. The
+ *   evaluations and checks of the pairs also run their quantifier branches and states
+ *   on it.
+ * - **cache**, **shortCircuit**, **useArena**, **profiler**, **context**: as in
+ *   `EvaluationOptions` and `RelationOptions`, for every pair. A context is shared by
+ *   every pair, so its deadline and budget bound the whole sweep.
+ * - **symmetry**: if set, every model gets a `SymmetryIndex` of its own, shared by all
+ *   its pairs (see `EvaluationOptions`).
+ * - **backend**: as in `RelationOptions`, for the entailment sweeps.
+ */
+struct SweepOptions {
+    ThreadPool* executor = nullptr;
+    EvaluationCache* cache = nullptr;
+    bool shortCircuit = false;
+    bool useArena = false;
+    Profiler* profiler = nullptr;
+    EvaluationContext* context = nullptr;
+    bool symmetry = false;
+    RelationBackend backend = RelationBackend::ENUMERATIVE;
+};
+
+/**
+ * @brief A set of formulas, compiled once, to be evaluated or checked across a fleet of models.
+ *
+ * The formulas are compiled into `Program`s on construction. A sweep then runs every
+ * (formula, model) pair of a set of models, and streams each result to a sink as soon as
+ * it is known, so results need not be kept until the whole sweep is done. Everything
+ * that only depends on a model (its ignorant state, its `ExtensionIndex`, its
+ * `SymmetryIndex`) is built once per model, when its first pair starts, shared by all
+ * its pairs, and released after its last one. Everything that only depends on the
+ * formulas (their programs, the premises of an entailment sweep and the analysis of its
+ * batch, see `BatchAnalysis`) is built once per call, shared by all the models.
+ *
+ * Models are only read through `IModel`, so converting them beforehand to the dense
+ * representations of the adapters (`DenseModel`, `MappedModel`) lets every pair read
+ * their tables directly. The models must outlive the sweep call, and may appear several
+ * times in the same call.
+ *
+ * The sink is never called concurrently, so it need not be thread-safe. Results arrive
+ * in no particular order when an executor is set, and model by model, in the order of
+ * the formulas, otherwise. Each result is delivered exactly once. If the sink throws,
+ * the remaining pairs still run, and the first exception is rethrown by the sweep.
+ *
+ * A sweep is immutable: any number of threads may run it at once.
+ */
+class Sweep {
+public:
+    explicit Sweep(const std::vector<QMLExpression::Expression>& formulas);
+
+    std::size_t size() const;
+    const std::vector<QMLExpression::Expression>& formulas() const;
+
+    void evaluate(std::span<const IModel* const> models, const std::function<void(SweepEvaluation&&)>& sink, const SweepOptions& options = {}) const;
+    void entails(const std::vector<QMLExpression::Expression>& premises, std::span<const IModel* const> models, const std::function<void(SweepEntailment&&)>& sink, const SweepOptions& options = {}) const;
+
+private:
+    std::vector<QMLExpression::Expression> m_Formulas;
+    std::vector<Program> m_Programs;
+};
+
+}
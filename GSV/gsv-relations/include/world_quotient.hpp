@@ -0,0 +1,61 @@
+#pragma once
+
+#include <expected>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <QMLExpression/expression.hpp>
+
+#include "iindexed_model.hpp"
+#include "imodel.hpp"
+#include "information_state.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief A model sliced to the vocabulary of some expressions, with the worlds it cannot tell apart merged.
+ *
+ * Two worlds of the base model are indistinguishable for a set of expressions if every
+ * constant the expressions mention has the same interpretation at both (or fails with the
+ * same error), and so does every predicate they mention. The worlds of the quotient are
+ * the classes of indistinguishable worlds, numbered in the order of their least world,
+ * which represents the class: every interpretation of the quotient at a class is the one
+ * of the base model at its representative. The weight of a class is its number of worlds.
+ *
+ * The expressions update a state of the base model exactly as they update the state of
+ * the quotient that has the classes of its worlds, so relations quantifying over states
+ * can be checked on the quotient, where there are exponentially fewer of them. `lift()`
+ * maps states of the quotient back to the base model.
+ *
+ * The quotient refers to the base model, which must outlive it and must not be modified
+ * while the quotient is in use. Queries are thread-safe if those of the base model are.
+ */
+class WorldQuotient : public IIndexedModel {
+public:
+    WorldQuotient(const IModel& model, const std::vector<QMLExpression::Expression>& expressions);
+
+    int worldCardinality() const override;
+    int domainCardinality() const override;
+    std::expected<int, std::string> termInterpretation(std::string_view term, int world) const override;
+    std::expected<const std::set<std::vector<int>>*, std::string> predicateInterpretation(std::string_view predicate, int world) const override;
+    std::expected<int, std::string> termInterpretationById(SymbolId term, int world) const override;
+    std::expected<const std::set<std::vector<int>>*, std::string> predicateInterpretationById(SymbolId predicate, int world) const override;
+
+    const IModel& base() const;
+    bool mergesWorlds() const;
+    int representative(int world_class) const;
+    int weight(int world_class) const;
+    int classOf(int world) const;
+    InformationState lift(const InformationState& state) const;
+
+private:
+    const IModel* m_Base;
+    const IIndexedModel* m_IndexedBase;
+    std::vector<int> m_Representatives;
+    std::vector<int> m_Weights;
+    std::vector<int> m_Classes;
+};
+
+}
@@ -0,0 +1,150 @@
+#include "discourse.hpp"
+
+#include <utility>
+
+#include "evaluator.hpp"
+#include "program.hpp"
+#include "semantic_relations.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief A sentence accepted by a discourse, linked to the sentences accepted before it.
+ */
+struct Discourse::Turn {
+    std::shared_ptr<const Turn> previous;
+    QMLExpression::Expression sentence;
+    std::size_t length;
+};
+
+namespace {
+
+/**
+ * @brief The index the discourse uses: the one in the options if it indexes the model, a new one otherwise.
+ */
+std::shared_ptr<const ExtensionIndex> discourseIndex(const IModel& model, const RelationOptions& options)
+{
+    if (options.extensions != nullptr && &options.extensions->model() == &model) {
+        return nullptr;
+    }
+    return std::make_shared<const ExtensionIndex>(model);
+}
+
+/**
+ * @brief The options for the evaluation of the sentences of a discourse.
+ */
+EvaluationOptions updateOptions(const RelationOptions& options)
+{
+    return { .logger = options.logDetails ? options.logger : nullptr, .executor = options.executor, .cache = options.cache, .extensions = options.extensions, .shortCircuit = options.shortCircuit, .useArena = options.useArena, .profiler = options.profiler, .context = options.context, .symmetry = options.symmetry };
+}
+
+} // ANONYMOUS NAMESPACE
+
+/**
+ * @brief Starts a discourse on the ignorant state of a model.
+ */
+Discourse::Discourse(const IModel& model, const RelationOptions& options)
+    : Discourse(model, create(model), options)
+{ }
+
+/**
+ * @brief Starts a discourse on a given information state.
+ */
+Discourse::Discourse(const IModel& model, InformationState state, const RelationOptions& options)
+    : m_Model(&model)
+    , m_Extensions(discourseIndex(model, options))
+    , m_Options(options)
+    , m_State(std::make_shared<const InformationState>(std::move(state)))
+{
+    m_Options.counterexample = nullptr;
+    if (m_Extensions != nullptr) {
+        m_Options.extensions = m_Extensions.get();
+    }
+}
+
+/**
+ * @brief Updates the current state with a sentence.
+ *
+ * @param sentence The sentence to add to the discourse.
+ * @return Nothing, or the error of the evaluation of the sentence. The discourse is left
+ *         unchanged if the evaluation fails.
+ */
+std::expected<void, std::string> Discourse::update(const QMLExpression::Expression& sentence)
+{
+    auto updated_state = evaluate(Program(sentence), *m_State, *m_Model, updateOptions(m_Options));
+    if (!updated_state.has_value()) {
+        return std::unexpected(updated_state.error());
+    }
+    const std::size_t updated_length = length() + 1;
+    m_State = std::make_shared<const InformationState>(std::move(updated_state.value()));
+    m_History = std::make_shared<const Turn>(Turn{ .previous = std::move(m_History), .sentence = sentence, .length = updated_length });
+    return {};
+}
+
+/**
+ * @brief Determines whether the current state supports an expression (see `supports()`).
+ */
+std::expected<bool, std::string> Discourse::supports(const QMLExpression::Expression& expr) const
+{
+    return GSV::supports(*m_State, expr, *m_Model, m_Options);
+}
+
+/**
+ * @brief Determines whether the current state allows an expression (see `allows()`).
+ */
+std::expected<bool, std::string> Discourse::allows(const QMLExpression::Expression& expr) const
+{
+    return GSV::allows(*m_State, expr, *m_Model, m_Options);
+}
+
+const InformationState& Discourse::state() const
+{
+    return *m_State;
+}
+
+/**
+ * @brief Determines whether the discourse has reached the absurd (empty) state.
+ */
+bool Discourse::absurd() const
+{
+    return m_State->empty();
+}
+
+/**
+ * @brief The number of sentences accepted so far.
+ */
+std::size_t Discourse::length() const
+{
+    return m_History != nullptr ? m_History->length : 0;
+}
+
+/**
+ * @brief The sentences accepted so far, in order.
+ */
+std::vector<QMLExpression::Expression> Discourse::sentences() const
+{
+    std::vector<QMLExpression::Expression> sentences(length());
+    for (const Turn* turn = m_History.get(); turn != nullptr; turn = turn->previous.get()) {
+        sentences[turn->length - 1] = turn->sentence;
+    }
+    return sentences;
+}
+
+/**
+ * @brief Saves the current state and history. This is a constant-time operation.
+ */
+Discourse::Checkpoint Discourse::checkpoint() const
+{
+    return { .state = m_State, .history = m_History };
+}
+
+/**
+ * @brief Restores a state and history saved by this discourse or one of its copies. This is a constant-time operation.
+ */
+void Discourse::rollback(const Checkpoint& checkpoint)
+{
+    m_State = checkpoint.state;
+    m_History = checkpoint.history;
+}
+
+}
@@ -1,22 +1,405 @@
 #include "semantic_relations.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <format>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <optional>
 #include <ranges>
 #include <stdexcept>
+#include <type_traits>
 #include <variant>
 #include <vector>
 
 #include <QMLExpression/formatter.hpp>
 
+#include "decision_diagram.hpp"
+#include "distributivity.hpp"
 #include "evaluator.hpp"
+#include "extension_index.hpp"
 #include "imodel.hpp"
 #include "information_state.hpp"
 #include "possibility.hpp"
+#include "profiler.hpp"
+#include "program.hpp"
+#include "substate_enumerator.hpp"
+#include "symbolic_evaluator.hpp"
+#include "thread_pool.hpp"
+#include "world_set.hpp"
+#include "world_quotient.hpp"
+#include "world_set_evaluator.hpp"
 
 namespace iif_sadaf::talk::GSV {
 
+namespace {
+
+std::string formulaError(const QMLExpression::Expression& expr, const std::string& error)
+{
+    return std::format("In evaluating formula {}:\n{}", std::visit(QMLExpression::Formatter(), QMLExpression::Expression(expr)), error);
+}
+
+std::expected<bool, std::string> fail(simple_logger::SimpleLogger* logger, const std::string& error_message)
+{
+    logger->info(std::format("Evaluation failed with the following error:\n{}", error_message));
+    return std::unexpected(error_message);
+}
+
+/*
+ * SEARCH DRIVER
+ *
+ * Every model-level relation scans the information states of one size at a time, and
+ * stops at the first state that settles the outcome: a counterexample (entailment,
+ * equivalence), a witness (consistency, coherence), or a failed evaluation.
+ */
+
+/**
+ * @brief Checks one state of a search: true if it settles the outcome, false to keep going.
+ */
+using SearchProbe = std::function<std::expected<bool, std::string>(SubstateEnumerator&)>;
+
+/**
+ * @brief Counts the states probed by the searches of one call to a model-level relation.
+ *
+ * The counters are sent to the profiler of the relation, if any, when the call returns.
+ */
+class SearchProfile {
+public:
+    SearchProfile(Profiler* profiler, std::string_view relation)
+        : m_Profiler(profiler)
+        , m_Relation(relation)
+        , m_Start(std::chrono::steady_clock::now())
+    { }
+
+    SearchProfile(const SearchProfile&) = delete;
+    SearchProfile& operator=(const SearchProfile&) = delete;
+
+    ~SearchProfile()
+    {
+        if (m_Profiler != nullptr) {
+            const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_Start);
+            m_Profiler->recordRelation(m_Relation, m_States.load(), m_EarlyExit.load(), time);
+        }
+    }
+
+    void countState()
+    {
+        if (m_Profiler != nullptr) {
+            m_States.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Notes that a state settled the search.
+     */
+    void stopEarly()
+    {
+        m_EarlyExit.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Records nothing, since the relation is to be checked by another search.
+     */
+    void discard()
+    {
+        m_Profiler = nullptr;
+    }
+
+private:
+    Profiler* m_Profiler;
+    std::string_view m_Relation;
+    std::chrono::steady_clock::time_point m_Start;
+    std::atomic<std::uint64_t> m_States = 0;
+    std::atomic<bool> m_EarlyExit = false;
+};
+
+/**
+ * @brief Finds the first state, in enumeration order, at which a probe hits or fails.
+ *
+ * The states searched are those with `size` worlds out of `worlds`, streamed by a
+ * `SubstateEnumerator`. Without an executor this is a plain serial scan. With one, the
+ * ranks are split in contiguous chunks that are enumerated and probed in parallel. Once
+ * a hit is found at rank `r`, every rank above `r` is skipped, but ranks below `r` are
+ * still probed, so the result is always the one a serial scan would produce.
+ *
+ * @param worlds Number of worlds of the model.
+ * @param size Number of worlds in each searched state.
+ * @param probe Checks the current state of an enumerator. It may be called concurrently,
+ *        with different enumerators.
+ * @param executor Pool to search on, or nullptr for a serial search.
+ * @param context Admits every state before it is probed, or nullptr. A refused state
+ *        fails with the message of the context.
+ * @param profile Counts the states probed.
+ * @return The rank of the first hit, nullopt if there is none, or the error of the
+ *         probe if the first state that settles the search failed.
+ */
+std::expected<std::optional<std::uint64_t>, std::string> findFirst(int worlds, int size, const SearchProbe& probe, ThreadPool* executor, EvaluationContext* context, SearchProfile* profile)
+{
+    const std::uint64_t count = binomial(worlds, size);
+    const auto admitted_probe = [&](SubstateEnumerator& substate) -> std::expected<bool, std::string> {
+        profile->countState();
+        if (context != nullptr && !context->admitState()) {
+            return std::unexpected(context->message());
+        }
+        return probe(substate);
+    };
+
+    if (executor == nullptr || count < 2 || count == std::numeric_limits<std::uint64_t>::max()) {
+        for (SubstateEnumerator substate(worlds, size); !substate.done(); substate.next()) {
+            const auto result = admitted_probe(substate);
+            if (!result.has_value()) {
+                profile->stopEarly();
+                return std::unexpected(result.error());
+            }
+            if (result.value()) {
+                profile->stopEarly();
+                return substate.rank();
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::atomic<std::uint64_t> first = count;
+    std::mutex first_mutex;
+    std::string first_error;
+    bool first_failed = false;
+
+    const std::uint64_t chunk_size = std::max<std::uint64_t>(1, count / (8 * (executor->threadCount() + 1)));
+    const std::uint64_t chunk_count = (count + chunk_size - 1) / chunk_size;
+
+    executor->parallelFor(chunk_count, [&](std::size_t chunk) {
+        const std::uint64_t end = std::min(count, (chunk + 1) * chunk_size);
+        for (SubstateEnumerator substate(worlds, size, chunk * chunk_size); !substate.done() && substate.rank() < end && substate.rank() < first.load(std::memory_order_relaxed); substate.next()) {
+            const auto result = admitted_probe(substate);
+            if (result.has_value() && !result.value()) {
+                continue;
+            }
+            profile->stopEarly();
+            std::scoped_lock lock(first_mutex);
+            if (substate.rank() < first.load(std::memory_order_relaxed)) {
+                first.store(substate.rank(), std::memory_order_relaxed);
+                first_failed = !result.has_value();
+                first_error = first_failed ? result.error() : std::string();
+            }
+            return;
+        }
+    });
+
+    if (first_failed) {
+        return std::unexpected(first_error);
+    }
+    if (first.load() == count) {
+        return std::nullopt;
+    }
+    return first.load();
+}
+
+/**
+ * @brief The options for the evaluations performed by a relation.
+ */
+EvaluationOptions evaluationOptions(simple_logger::SimpleLogger* logger, const RelationOptions& options)
+{
+    return { .logger = logger, .cache = options.cache, .extensions = options.extensions, .shortCircuit = options.shortCircuit, .useArena = options.useArena, .profiler = options.profiler, .context = options.context, .symmetry = options.symmetry };
+}
+
+/**
+ * @brief The options for the state-level relations checked by a model-level relation.
+ */
+RelationOptions detailOptions(simple_logger::SimpleLogger* detail_logger, const RelationOptions& options)
+{
+    return { .logger = detail_logger, .logDetails = options.logDetails, .cache = options.cache, .extensions = options.extensions, .shortCircuit = options.shortCircuit, .useArena = options.useArena, .profiler = options.profiler, .context = options.context, .symmetry = options.symmetry };
+}
+
+/**
+ * @brief The options of a model-level relation, with an extension index of the model.
+ *
+ * Unless `options` already carry an index of the model, a fresh one is emplaced in
+ * `local_extensions`, and the returned options refer to it.
+ */
+RelationOptions indexedOptions(const RelationOptions& options, const IModel& model, std::optional<ExtensionIndex>& local_extensions)
+{
+    if (options.extensions != nullptr && &options.extensions->model() == &model) {
+        return options;
+    }
+    RelationOptions indexed_options = options;
+    indexed_options.extensions = &local_extensions.emplace(model);
+    return indexed_options;
+}
+
+/**
+ * @brief The pool to search on: searches are serial while a logger is attached.
+ */
+ThreadPool* searchExecutor(const RelationOptions& options)
+{
+    return options.logger == nullptr ? options.executor : nullptr;
+}
+
+/**
+ * @brief The number of state sizes a search over the states of a model visits, from the empty state up.
+ *
+ * Searches visit every size below the world cardinality. On a `WorldQuotient` that merges
+ * some worlds, the state of all classes stands for the states of the base model below its
+ * world cardinality that meet every class, so it is visited as well.
+ */
+int stateSizes(const IModel& model)
+{
+    const WorldQuotient* quotient = dynamic_cast<const WorldQuotient*>(&model);
+    if (quotient != nullptr && quotient->mergesWorlds()) {
+        return model.worldCardinality() + 1;
+    }
+    return model.worldCardinality();
+}
+
+bool areDistributive(const std::vector<QMLExpression::Expression>& expressions)
+{
+    return std::ranges::all_of(expressions, [](const QMLExpression::Expression& expr) -> bool { return isDistributive(expr); });
+}
+
+/**
+ * @brief The number of state sizes a counterexample search visits, from the empty state up.
+ *
+ * Every size below the world cardinality is searched, unless the formulas are distributive
+ * and no details are logged. A state then is a counterexample (or fails) iff one of its
+ * singletons is (or does), so the search that finds nothing among the empty state and the
+ * singletons would find nothing among the larger states either, and can stop there.
+ */
+int searchedSizes(const IModel& model, const RelationOptions& options, bool distributive)
+{
+    if (distributive && !options.logDetails) {
+        return std::min(stateSizes(model), 2);
+    }
+    return stateSizes(model);
+}
+
+/**
+ * @brief The premises of an argument followed by its conclusions.
+ */
+std::vector<QMLExpression::Expression> withConclusions(std::vector<QMLExpression::Expression> premises, const std::vector<QMLExpression::Expression>& conclusions)
+{
+    premises.insert(premises.end(), conclusions.begin(), conclusions.end());
+    return premises;
+}
+
+std::vector<QMLExpression::Expression> withConclusion(const std::vector<QMLExpression::Expression>& premises, const QMLExpression::Expression& conclusion)
+{
+    return withConclusions(premises, { conclusion });
+}
+
+/**
+ * @brief Checks a counterexample search on the quotient of the model by the worlds its expressions cannot tell apart.
+ *
+ * A state of size `i` of the model settles a search iff the state of the quotient with the
+ * classes of its worlds does, and the first state settling the search on the model is the
+ * state of the representatives of the first state settling it on the quotient. The search
+ * thus has the same outcome on the quotient, errors included, and a counterexample found on
+ * it is lifted back to the one the search on the model would have found.
+ *
+ * The quotient is only used if it merges some worlds, and no logger is attached, since logs
+ * show the states searched. The cache is bypassed on the quotient, which only lives for the
+ * call, and the quotient gets extension and symmetry indexes of its own.
+ *
+ * @return The outcome on the quotient, or nullopt if the relation is to be checked on the model itself.
+ */
+template<typename Relation>
+auto onQuotient(const std::vector<QMLExpression::Expression>& expressions, const IModel& model, const RelationOptions& options, const Relation& relation) -> std::optional<std::invoke_result_t<const Relation&, const IModel&, const RelationOptions&>>
+{
+    if (options.logger != nullptr || dynamic_cast<const WorldQuotient*>(&model) != nullptr) {
+        return std::nullopt;
+    }
+    const WorldQuotient quotient(model, expressions);
+    if (!quotient.mergesWorlds()) {
+        return std::nullopt;
+    }
+
+    std::optional<SymmetryIndex> symmetry;
+    InformationState counterexample;
+    RelationOptions quotient_options = options;
+    quotient_options.cache = nullptr;
+    quotient_options.extensions = nullptr;
+    quotient_options.symmetry = options.symmetry != nullptr ? &symmetry.emplace(quotient) : nullptr;
+    quotient_options.counterexample = options.counterexample != nullptr ? &counterexample : nullptr;
+
+    auto result = relation(quotient, quotient_options);
+    if constexpr (std::is_same_v<decltype(result), std::expected<bool, std::string>>) {
+        if (options.counterexample != nullptr && result.has_value() && !result.value()) {
+            *options.counterexample = quotient.lift(counterexample);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief `consistent()` on a compiled expression, so that searches compile their formulas once.
+ */
+std::expected<bool, std::string> consistentWith(const Program& program, const InformationState& state, const IModel& model, const RelationOptions& options)
+{
+	const bool logging = options.logger != nullptr;
+	simple_logger::SimpleLogger* logger = simple_logger::normalize(options.logger);
+	simple_logger::SimpleLogger* detail_logger = options.logDetails ? logger : nullptr;
+	if (logging) {
+		logger->info(std::format("Current state is:\n{}", str(state, false)));
+	}
+
+	const auto is_consistent = hasNonEmptyUpdate(program, state, model, evaluationOptions(detail_logger, options));
+
+    if (!is_consistent.has_value()) {
+        const std::string error_message = formulaError(program.source(), is_consistent.error());
+        logger->info(std::format("Evaluation failed with the following error:\n{}", error_message));
+        return std::unexpected(error_message);
+    }
+    
+    const std::string result_string = is_consistent.value() ? "True" : "False";
+    logger->info(std::format("Evaluation result: {}", result_string));
+    return is_consistent.value();
+}
+
+/**
+ * @brief `supports()` on a compiled expression, so that searches compile their formulas once.
+ */
+std::expected<bool, std::string> supportedBy(const InformationState& state, const Program& program, const IModel& model, const RelationOptions& options)
+{
+	const bool logging = options.logger != nullptr;
+	simple_logger::SimpleLogger* logger = simple_logger::normalize(options.logger);
+	simple_logger::SimpleLogger* detail_logger = options.logDetails ? logger : nullptr;
+	if (logging) {
+		logger->info(std::format("Current state is:\n{}", str(state, false)));
+	}
+
+	const auto hypothetical_update = evaluate(program, state, model, evaluationOptions(detail_logger, options));
+	
+	if (!hypothetical_update.has_value()) {
+		const std::string error_message = formulaError(program.source(), hypothetical_update.error());
+		logger->info(std::format("Evaluation failed with the following error:\n{}", error_message));
+		return std::unexpected(error_message);
+	}
+	
+	const bool evaluation_result = subsistsIn(state, hypothetical_update.value());
+	const std::string result_string = evaluation_result ? "True" : "False";
+	logger->info(std::format("Evaluation result: {}", result_string));
+	return evaluation_result;
+}
+
+/**
+ * @brief Compiles every expression of a list.
+ */
+std::vector<Program> compile(const std::vector<QMLExpression::Expression>& expressions)
+{
+    std::vector<Program> programs;
+    programs.reserve(expressions.size());
+    for (const QMLExpression::Expression& expr : expressions) {
+        programs.emplace_back(expr);
+    }
+    return programs;
+}
+
+} // ANONYMOUS NAMESPACE
+
 /**
  * @brief Determines whether an expression is consistent with a given information state, relative to a base model.
  * 
@@ -37,23 +420,17 @@ namespace iif_sadaf::talk::GSV {
  */
 std::expected<bool, std::string> consistent(const QMLExpression::Expression& expr, const InformationState& state, const IModel& model, simple_logger::SimpleLogger* logger, bool log_details)
 {
-    const std::string formula = std::visit(QMLExpression::Formatter(), QMLExpression::Expression(expr));
-
-	logger = simple_logger::normalize(logger);
-	simple_logger::SimpleLogger* detail_logger = log_details ? logger : nullptr;
-	logger->info(std::format("Current state is:\n{}", str(state, false)));
-
-	const auto hypothetical_update = evaluate(expr, state, model, detail_logger);
+	return consistent(expr, state, model, RelationOptions{ .logger = logger, .logDetails = log_details });
+}
 
-    if (!hypothetical_update.has_value()) {
-        const std::string error_message = std::format("In evaluating formula {}:\n{}", formula, hypothetical_update.error());
-        logger->info(std::format("Evaluation failed with the following error:\n{}", error_message));
-        return std::unexpected(error_message);
-    }
-    
-    const std::string result_string = hypothetical_update.value().empty() ? "False" : "True";
-    logger->info(std::format("Evaluation result: {}", result_string));
-    return !hypothetical_update.value().empty();
+/**
+ * @brief Determines whether an expression is consistent with a given information state, with the given relation options.
+ *
+ * See the overload taking a logger. The evaluation goes through `options.cache`, if set.
+ */
+std::expected<bool, std::string> consistent(const QMLExpression::Expression& expr, const InformationState& state, const IModel& model, const RelationOptions& options)
+{
+	return consistentWith(Program(expr), state, model, options);
 }
 
 /**
@@ -74,6 +451,14 @@ std::expected<bool, std::string> allows(const InformationState& state, const QML
 	return consistent(expr, state, model, logger, log_details);
 }
 
+/**
+ * @brief Checks whether an information state allows a given expression, with the given relation options.
+ */
+std::expected<bool, std::string> allows(const InformationState& state, const QMLExpression::Expression& expr, const IModel& model, const RelationOptions& options)
+{
+	return consistent(expr, state, model, options);
+}
+
 /**
  * @brief Determines whether an information state supports a given expression.
  *
@@ -89,24 +474,17 @@ std::expected<bool, std::string> allows(const InformationState& state, const QML
  */
 std::expected<bool, std::string> supports(const InformationState& state, const QMLExpression::Expression& expr, const IModel& model, simple_logger::SimpleLogger* logger, bool log_details)
 {
-    const std::string formula = std::visit(QMLExpression::Formatter(), QMLExpression::Expression(expr));
-
-	logger = simple_logger::normalize(logger);
-	simple_logger::SimpleLogger* detail_logger = log_details ? logger : nullptr;
-	logger->info(std::format("Current state is:\n{}", str(state, false)));
+	return supports(state, expr, model, RelationOptions{ .logger = logger, .logDetails = log_details });
+}
 
-	const auto hypothetical_update = evaluate(expr, state, model, detail_logger);
-	
-	if (!hypothetical_update.has_value()) {
-		const std::string error_message = std::format("In evaluating formula {}:\n{}", formula, hypothetical_update.error());
-		logger->info(std::format("Evaluation failed with the following error:\n{}", error_message));
-		return std::unexpected(error_message);
-	}
-	
-	const bool evaluation_result = subsistsIn(state, hypothetical_update.value());
-	const std::string result_string = evaluation_result ? "True" : "False";
-	logger->info(std::format("Evaluation result: {}", result_string));
-	return evaluation_result;
+/**
+ * @brief Determines whether an information state supports a given expression, with the given relation options.
+ *
+ * See the overload taking a logger. The evaluation goes through `options.cache`, if set.
+ */
+std::expected<bool, std::string> supports(const InformationState& state, const QMLExpression::Expression& expr, const IModel& model, const RelationOptions& options)
+{
+	return supportedBy(state, Program(expr), model, options);
 }
 
 /**
@@ -127,49 +505,438 @@ std::expected<bool, std::string> isSupportedBy(const QMLExpression::Expression&
     return supports(state, expr, model, logger, log_details);
 }
 
+/**
+ * @brief Checks if an expression is supported by a given information state, with the given relation options.
+ */
+std::expected<bool, std::string> isSupportedBy(const QMLExpression::Expression& expr, const InformationState& state, const IModel& model, const RelationOptions& options)
+{
+    return supports(state, expr, model, options);
+}
+
 namespace {
 
-std::vector<InformationState> generateSubStates(int n, int k) {
-    std::vector<InformationState> result;
+/*
+ * WORLD SET FAST PATH
+ *
+ * Every state produced by a SubstateEnumerator is variable-free, so when all the
+ * expressions involved are variable-free too, the model-level relations can be
+ * decided on world sets. The functions below mirror the information-state based
+ * implementations (including their log messages and error messages), but never
+ * build an InformationState unless a message has to display it.
+ */
+
+bool areVariableFree(const std::vector<QMLExpression::Expression>& expressions)
+{
+    return std::ranges::all_of(expressions, [](const QMLExpression::Expression& expr) -> bool { return isVariableFree(expr); });
+}
 
-    if (k == 0) {
-        result.push_back(InformationState());
-        return result;
+std::expected<WorldSet, std::string> sequentiallyUpdate(const WorldSet& state, const std::vector<QMLExpression::Expression>& expressions, const IModel& model)
+{
+    WorldSet output = state;
+    for (const QMLExpression::Expression& expr : expressions) {
+        const auto update = evaluate(expr, output, model);
+        if (!update.has_value()) {
+            return std::unexpected(formulaError(expr, update.error()));
+        }
+        output = update.value();
     }
+    return output;
+}
 
-    if (k > n + 1) {
-        return result;
+std::expected<bool, std::string> supports(const WorldSet& state, const QMLExpression::Expression& expr, const IModel& model)
+{
+    const auto update = evaluate(expr, state, model);
+    if (!update.has_value()) {
+        return std::unexpected(formulaError(expr, update.error()));
     }
+    return isSubsetOf(state, update.value());
+}
+
+std::expected<bool, std::string> consistentOnWorldSets(const QMLExpression::Expression& expr, const IModel& model, const RelationOptions& options)
+{
+    SearchProfile profile(options.profiler, "consistent");
+    const bool logging = options.logger != nullptr;
+    simple_logger::SimpleLogger* logger = simple_logger::normalize(options.logger);
 
-    int estimate = 1;
-    for (int i = 1; i <= k; i++) {
-        estimate = estimate * (n + 2 - i) / i;
+    for (const int i : std::views::iota(0, model.worldCardinality())) {
+        const auto is_consistent = [&](SubstateEnumerator& substate) -> std::expected<bool, std::string> {
+            const auto update = evaluate(expr, substate.worldSet(), model);
+            if (!update.has_value()) {
+                return std::unexpected(formulaError(expr, update.error()));
+            }
+            if (update.value().empty() && logging) {
+                logger->info(std::format("Formula is inconsistent with the following information state:\n{}", str(toInformationState(substate.worldSet()), false)));
+            }
+            return !update.value().empty();
+        };
+        const auto consistent_state = findFirst(model.worldCardinality(), i, is_consistent, searchExecutor(options), options.context, &profile);
+        if (!consistent_state.has_value()) {
+            return fail(logger, consistent_state.error());
+        }
+        if (!consistent_state.value().has_value()) {
+            logger->info("Evaluation result: False");
+            return false;
+        }
     }
-    result.reserve(estimate);
+    logger->info("Evaluation result: True");
+    return true;
+}
+
+std::expected<bool, std::string> coherentOnWorldSets(const QMLExpression::Expression& expr, const IModel& model, const RelationOptions& options)
+{
+    SearchProfile profile(options.profiler, "coherent");
+    const bool logging = options.logger != nullptr;
+    simple_logger::SimpleLogger* logger = simple_logger::normalize(options.logger);
 
-    std::function<void(int, InformationState&)> backtrack =
-        [&](int start, InformationState& current) {
-            if (current.size() == k) {
-                result.push_back(current);
-                return;
+    for (const int i : std::views::iota(0, model.worldCardinality())) {
+        const auto is_coherent = [&](SubstateEnumerator& substate) -> std::expected<bool, std::string> {
+            const auto does_support = supports(substate.worldSet(), expr, model);
+            if (!does_support.has_value()) {
+                return std::unexpected(does_support.error());
             }
+            const bool coherent_state = !substate.worldSet().empty() && does_support.value();
+            if (!coherent_state && logging) {
+                logger->info(std::format("Formula is incoherent due to the following information state:\n{}", str(toInformationState(substate.worldSet()), false)));
+            }
+            return coherent_state;
+        };
+        const auto coherent_state = findFirst(model.worldCardinality(), i, is_coherent, searchExecutor(options), options.context, &profile);
+        if (!coherent_state.has_value()) {
+            return fail(logger, coherent_state.error());
+        }
+        if (!coherent_state.value().has_value()) {
+            logger->info("Evaluation result: False");
+            return false;
+        }
+    }
+    logger->info("Evaluation result: True");
+    return true;
+}
 
-            ReferentSystem r;
+std::expected<bool, std::string> entailsGOnWorldSets(const std::vector<QMLExpression::Expression>& premises, const QMLExpression::Expression& conclusion, const IModel& model, const RelationOptions& options)
+{
+    SearchProfile profile(options.profiler, "entails_G");
+    const bool logging = options.logger != nullptr;
+    simple_logger::SimpleLogger* logger = simple_logger::normalize(options.logger);
 
-            for (int i = start; i <= n; ++i) {
-                Possibility p(std::make_shared<ReferentSystem>(r), i);
-                current.insert(p);
+    const int sizes = searchedSizes(model, options, areDistributive(premises) && isDistributive(conclusion));
+    for (const int i : std::views::iota(0, sizes)) {
+        std::mutex counterexamples_mutex;
+        std::map<std::uint64_t, WorldSet> premises_updates;
 
-                backtrack(i + 1, current);
+        const auto is_counterexample = [&](SubstateEnumerator& substate) -> std::expected<bool, std::string> {
+            auto premises_update = sequentiallyUpdate(substate.worldSet(), premises, model);
+            if (!premises_update.has_value()) {
+                return std::unexpected(premises_update.error());
+            }
+            const auto conclusion_update = evaluate(conclusion, premises_update.value(), model);
+            if (!conclusion_update.has_value()) {
+                return std::unexpected(conclusion_update.error());
+            }
+            if (isSubsetOf(premises_update.value(), conclusion_update.value())) {
+                return false;
+            }
+            std::scoped_lock lock(counterexamples_mutex);
+            premises_updates.emplace(substate.rank(), std::move(premises_update.value()));
+            return true;
+        };
+        const auto counterexample = findFirst(model.worldCardinality(), i, is_counterexample, searchExecutor(options), options.context, &profile);
+        if (!counterexample.has_value()) {
+            return fail(logger, counterexample.error());
+        }
+        if (counterexample.value().has_value()) {
+            const std::uint64_t rank = counterexample.value().value();
+            if (logging) {
+                logger->info(std::format("The following information state provides a counterexample to the argument:\n\n{}\n", str(toInformationState(premises_updates.at(rank)), false)));
+            }
+            if (options.counterexample != nullptr) {
+                *options.counterexample = toInformationState(SubstateEnumerator(model.worldCardinality(), i, rank).worldSet());
+            }
+            logger->info("Evaluation result: False");
+            return false;
+        }
+    }
+    logger->info("Evaluation result: True");
+    return true;
+}
 
-                current.erase(p);
+std::expected<bool, std::string> entailsCOnWorldSets(const std::vector<QMLExpression::Expression>& premises, const QMLExpression::Expression& conclusion, const IModel& model, const RelationOptions& options)
+{
+    SearchProfile profile(options.profiler, "entails_C");
+    const bool logging = options.logger != nullptr;
+    simple_logger::SimpleLogger* logger = simple_logger::normalize(options.logger);
+
+    const int sizes = searchedSizes(model, options, areDistributive(premises) && isDistributive(conclusion));
+    for (const int i : std::views::iota(0, sizes)) {
+        const auto is_counterexample = [&](SubstateEnumerator& substate) -> std::expected<bool, std::string> {
+            for (const auto& premise : premises) {
+                const auto supports_premise = supports(substate.worldSet(), premise, model);
+                if (!supports_premise.has_value()) {
+                    return std::unexpected(supports_premise.error());
+                }
+                if (!supports_premise.value()) {
+                    return false;
+                }
+            }
+
+            const auto supports_conclusion = supports(substate.worldSet(), conclusion, model);
+            if (!supports_conclusion.has_value()) {
+                return std::unexpected(supports_conclusion.error());
             }
+            return !supports_conclusion.value();
         };
+        const auto counterexample = findFirst(model.worldCardinality(), i, is_counterexample, searchExecutor(options), options.context, &profile);
+        if (!counterexample.has_value()) {
+            return fail(logger, counterexample.error());
+        }
+        if (counterexample.value().has_value()) {
+            const InformationState state = toInformationState(SubstateEnumerator(model.worldCardinality(), i, counterexample.value().value()).worldSet());
+            if (logging) {
+                logger->info(std::format("The following information state provides a counterexample to the argument:\n\n{}\n", str(state, false)));
+            }
+            if (options.counterexample != nullptr) {
+                *options.counterexample = state;
+            }
+            logger->info("Evaluation result: False");
+            return false;
+        }
+    }
+    logger->info("Evaluation result: True");
+    return true;
+}
 
-    InformationState current;
-    backtrack(0, current);
+std::expected<bool, std::string> equivalentOnWorldSets(const QMLExpression::Expression& expr1, const QMLExpression::Expression& expr2, const IModel& model, const RelationOptions& options)
+{
+    SearchProfile profile(options.profiler, "equivalent");
+    const bool logging = options.logger != nullptr;
+    simple_logger::SimpleLogger* logger = simple_logger::normalize(options.logger);
 
-    return result;
+    const int sizes = searchedSizes(model, options, isDistributive(expr1) && isDistributive(expr2));
+    for (const int i : std::views::iota(0, sizes)) {
+        const auto is_counterexample = [&](SubstateEnumerator& substate) -> std::expected<bool, std::string> {
+            const auto expr1_update = evaluate(expr1, substate.worldSet(), model);
+            if (!expr1_update.has_value()) {
+                return std::unexpected(expr1_update.error());
+            }
+            const auto expr2_update = evaluate(expr2, substate.worldSet(), model);
+            if (!expr2_update.has_value()) {
+                return std::unexpected(expr2_update.error());
+            }
+            // Variable-free possibilities are similar iff they share their world
+            return expr1_update.value() != expr2_update.value();
+        };
+        const auto counterexample = findFirst(model.worldCardinality(), i, is_counterexample, searchExecutor(options), options.context, &profile);
+        if (!counterexample.has_value()) {
+            return fail(logger, counterexample.error());
+        }
+        if (counterexample.value().has_value()) {
+            const InformationState state = toInformationState(SubstateEnumerator(model.worldCardinality(), i, counterexample.value().value()).worldSet());
+            if (logging) {
+                logger->info(std::format("The following information state provides a counterexample to the equivalence:\n{}", str(state, false)));
+            }
+            if (options.counterexample != nullptr) {
+                *options.counterexample = state;
+            }
+            logger->info("Evaluation result: False");
+            return false;
+        }
+    }
+    logger->info("Evaluation result: True");
+    return true;
+}
+
+/*
+ * SYMBOLIC BACKEND
+ *
+ * The updates of all the variable-free states of the model are computed at once, as
+ * decision diagrams, so a relation is decided by the diagram of the states that falsify
+ * it: the searches below read off its sizes, and its first state of the least size
+ * falsifying the relation, which is the state the enumeration would have settled on.
+ *
+ * The enumeration reports the error of the first state that fails, which a diagram cannot
+ * tell, so every function returns nullopt, and the relation is decided by enumeration,
+ * as soon as an interpretation fails at some world.
+ */
+
+bool isSymbolic(const RelationOptions& options)
+{
+    return options.backend == RelationBackend::SYMBOLIC && options.logger == nullptr && options.context == nullptr;
+}
+
+std::expected<SymbolicState, std::string> sequentiallyUpdate(const SymbolicState& state, const std::vector<QMLExpression::Expression>& expressions, const IModel& model, DecisionDiagram& diagram)
+{
+    SymbolicState output = state;
+    for (const QMLExpression::Expression& expr : expressions) {
+        auto update = evaluate(expr, output, model, diagram);
+        if (!update.has_value()) {
+            return std::unexpected(update.error());
+        }
+        output = std::move(update.value());
+    }
+    return output;
+}
+
+/**
+ * @brief The states of a family in which every world is restricted to the states passing a test.
+ */
+SymbolicState restricted(const SymbolicState& state, DecisionDiagram::Node test, DecisionDiagram& diagram)
+{
+    SymbolicState output(state.size());
+    for (std::size_t world = 0; world < state.size(); ++world) {
+        output[world] = diagram.conjunction(state[world], test);
+    }
+    return output;
+}
+
+/**
+ * @brief The first state falsifying a relation among the first `sizes` sizes, in the order of the enumeration.
+ */
+std::optional<WorldSet> firstCounterexample(DecisionDiagram& diagram, DecisionDiagram::Node counterexamples, int sizes)
+{
+    const std::vector<bool> cardinalities = diagram.cardinalities(counterexamples);
+    for (const int i : std::views::iota(0, sizes)) {
+        if (cardinalities[i]) {
+            return diagram.first(counterexamples, i);
+        }
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Decides a counterexample search on the diagram of its counterexamples, reporting the first one.
+ */
+bool settle(DecisionDiagram& diagram, DecisionDiagram::Node counterexamples, int sizes, const RelationOptions& options, SearchProfile& profile)
+{
+    const std::optional<WorldSet> counterexample = firstCounterexample(diagram, counterexamples, sizes);
+    if (!counterexample.has_value()) {
+        return true;
+    }
+    profile.stopEarly();
+    if (options.counterexample != nullptr) {
+        *options.counterexample = toInformationState(counterexample.value());
+    }
+    return false;
+}
+
+/**
+ * @brief Decides whether some state of every size below the world cardinality is in a family.
+ */
+bool everySizeIn(DecisionDiagram& diagram, DecisionDiagram::Node states, SearchProfile& profile)
+{
+    const std::vector<bool> cardinalities = diagram.cardinalities(states);
+    if (std::all_of(cardinalities.begin(), cardinalities.end() - 1, [](bool reached) { return reached; })) {
+        return true;
+    }
+    profile.stopEarly();
+    return false;
+}
+
+std::optional<std::expected<bool, std::string>> consistentSymbolically(const QMLExpression::Expression& expr, const IModel& model, const RelationOptions& options)
+{
+    SearchProfile profile(options.profiler, "consistent");
+    DecisionDiagram diagram(model.worldCardinality());
+
+    const auto update = evaluate(expr, everyState(diagram), model, diagram);
+    if (!update.has_value()) {
+        profile.discard();
+        return std::nullopt;
+    }
+    return everySizeIn(diagram, nonEmpty(update.value(), diagram), profile);
+}
+
+std::optional<std::expected<bool, std::string>> coherentSymbolically(const QMLExpression::Expression& expr, const IModel& model, const RelationOptions& options)
+{
+    SearchProfile profile(options.profiler, "coherent");
+    DecisionDiagram diagram(model.worldCardinality());
+    const SymbolicState states = everyState(diagram);
+
+    const auto update = evaluate(expr, states, model, diagram);
+    if (!update.has_value()) {
+        profile.discard();
+        return std::nullopt;
+    }
+    return everySizeIn(diagram, diagram.conjunction(nonEmpty(states, diagram), isSubsetOf(states, update.value(), diagram)), profile);
+}
+
+std::optional<std::expected<bool, std::string>> entailsGSymbolically(const std::vector<QMLExpression::Expression>& premises, const QMLExpression::Expression& conclusion, const IModel& model, const RelationOptions& options)
+{
+    SearchProfile profile(options.profiler, "entails_G");
+    DecisionDiagram diagram(model.worldCardinality());
+
+    const auto premises_update = sequentiallyUpdate(everyState(diagram), premises, model, diagram);
+    if (!premises_update.has_value()) {
+        profile.discard();
+        return std::nullopt;
+    }
+    const auto conclusion_update = evaluate(conclusion, premises_update.value(), model, diagram);
+    if (!conclusion_update.has_value()) {
+        profile.discard();
+        return std::nullopt;
+    }
+
+    const DecisionDiagram::Node counterexamples = diagram.negation(isSubsetOf(premises_update.value(), conclusion_update.value(), diagram));
+    return settle(diagram, counterexamples, searchedSizes(model, options, areDistributive(premises) && isDistributive(conclusion)), options, profile);
+}
+
+/**
+ * @brief The diagram of the states supporting every premise, or nullopt if an interpretation fails.
+ */
+std::optional<DecisionDiagram::Node> supportingStates(const SymbolicState& states, const std::vector<QMLExpression::Expression>& premises, const IModel& model, DecisionDiagram& diagram)
+{
+    DecisionDiagram::Node supporting = DecisionDiagram::ONE;
+    for (const QMLExpression::Expression& premise : premises) {
+        // States that already fail to support a premise are never evaluated on the next ones
+        const SymbolicState candidates = restricted(states, supporting, diagram);
+        const auto update = evaluate(premise, candidates, model, diagram);
+        if (!update.has_value()) {
+            return std::nullopt;
+        }
+        supporting = diagram.conjunction(supporting, isSubsetOf(candidates, update.value(), diagram));
+    }
+    return supporting;
+}
+
+std::optional<std::expected<bool, std::string>> entailsCSymbolically(const std::vector<QMLExpression::Expression>& premises, const QMLExpression::Expression& conclusion, const IModel& model, const RelationOptions& options)
+{
+    SearchProfile profile(options.profiler, "entails_C");
+    DecisionDiagram diagram(model.worldCardinality());
+    const SymbolicState states = everyState(diagram);
+
+    const std::optional<DecisionDiagram::Node> supporting = supportingStates(states, premises, model, diagram);
+    if (!supporting.has_value()) {
+        profile.discard();
+        return std::nullopt;
+    }
+    const SymbolicState candidates = restricted(states, supporting.value(), diagram);
+    const auto conclusion_update = evaluate(conclusion, candidates, model, diagram);
+    if (!conclusion_update.has_value()) {
+        profile.discard();
+        return std::nullopt;
+    }
+
+    const DecisionDiagram::Node counterexamples = diagram.conjunction(supporting.value(), diagram.negation(isSubsetOf(candidates, conclusion_update.value(), diagram)));
+    return settle(diagram, counterexamples, searchedSizes(model, options, areDistributive(premises) && isDistributive(conclusion)), options, profile);
+}
+
+std::optional<std::expected<bool, std::string>> equivalentSymbolically(const QMLExpression::Expression& expr1, const QMLExpression::Expression& expr2, const IModel& model, const RelationOptions& options)
+{
+    SearchProfile profile(options.profiler, "equivalent");
+    DecisionDiagram diagram(model.worldCardinality());
+    const SymbolicState states = everyState(diagram);
+
+    const auto expr1_update = evaluate(expr1, states, model, diagram);
+    if (!expr1_update.has_value()) {
+        profile.discard();
+        return std::nullopt;
+    }
+    const auto expr2_update = evaluate(expr2, states, model, diagram);
+    if (!expr2_update.has_value()) {
+        profile.discard();
+        return std::nullopt;
+    }
+
+    // Variable-free possibilities are similar iff they share their world
+    return settle(diagram, differ(expr1_update.value(), expr2_update.value(), diagram), searchedSizes(model, options, isDistributive(expr1) && isDistributive(expr2)), options, profile);
 }
 
 } // ANONYMOUS NAMESPACE
@@ -188,34 +955,59 @@ std::vector<InformationState> generateSubStates(int n, int k) {
  *         consistent in at least one information state, `false` otherwise.
  *         Returns an error message if evaluation fails.
  */
-std::expected<bool, std::string> consistent(const QMLExpression::Expression& expr, const IModel& model, simple_logger::SimpleLogger* logger, bool log_details)
+std::expected<bool, std::string> consistent(const QMLExpression::Expression& expr, const IModel& model, simple_logger::SimpleLogger* logger, bool log_details)
+{
+	return consistent(expr, model, RelationOptions{ .logger = logger, .logDetails = log_details });
+}
+
+/**
+ * @brief Determines whether an expression is consistent within a given model, with the given relation options.
+ *
+ * See the overload taking a logger. With an executor in `options`, the information states
+ * of each size are checked in parallel.
+ */
+std::expected<bool, std::string> consistent(const QMLExpression::Expression& expr, const IModel& model, const RelationOptions& options)
 {
-	logger = simple_logger::normalize(logger);
-	simple_logger::SimpleLogger* detail_logger = log_details ? logger : nullptr;
+	if (isSymbolic(options) && isVariableFree(expr)) {
+		if (auto decided = consistentSymbolically(expr, model, options)) {
+			return std::move(decided.value());
+		}
+	}
+
+	if (!options.logDetails && isVariableFree(expr)) {
+		return consistentOnWorldSets(expr, model, options);
+	}
+
+	SearchProfile profile(options.profiler, "consistent");
+	const bool logging = options.logger != nullptr;
+	simple_logger::SimpleLogger* logger = simple_logger::normalize(options.logger);
+	simple_logger::SimpleLogger* detail_logger = options.logDetails ? logger : nullptr;
+	std::optional<ExtensionIndex> local_extensions;
+	const RelationOptions indexed_options = indexedOptions(options, model, local_extensions);
+	const Program program(expr);
 
 	for (const int i : std::views::iota(0, model.worldCardinality())) {
-		std::vector<InformationState> states = generateSubStates(model.worldCardinality() - 1, i);
-		const auto is_consistent = [&](const InformationState& state) -> bool {
-			const auto result = consistent(expr, state, model, detail_logger, log_details); 
+		const auto is_consistent = [&](SubstateEnumerator& substate) -> std::expected<bool, std::string> {
+			const InformationState& state = substate.state();
+			const auto result = consistentWith(program, state, model, detailOptions(detail_logger, indexed_options));
 			if (!result.has_value()) {
-				throw std::runtime_error(result.error());
+				return std::unexpected(result.error());
 			}
 			const bool result_value = result.value();
 			if (!result_value) {
-				logger->info(std::format("Formula is inconsistent with the following information state:\n{}", str(state, false)));
+				if (logging) {
+					logger->info(std::format("Formula is inconsistent with the following information state:\n{}", str(state, false)));
+				}
 			}
 			return result_value;
 		};
-		try {
-			if (!std::ranges::any_of(states, is_consistent)) {
-				logger->info("Evaluation result: False");
-				return false;
-			}
+		const auto consistent_state = findFirst(model.worldCardinality(), i, is_consistent, searchExecutor(options), options.context, &profile);
+		if (!consistent_state.has_value()) {
+			return fail(logger, consistent_state.error());
 		}
-		catch (const std::runtime_error& e) {
-			const std::string error_message = e.what();
-			logger->info(std::format("Evaluation failed with the following error:\n{}", error_message));
-			return std::unexpected(error_message);
+		if (!consistent_state.value().has_value()) {
+			logger->info("Evaluation result: False");
+			return false;
 		}
 	}
 	logger->info("Evaluation result: True");
@@ -238,32 +1030,57 @@ std::expected<bool, std::string> consistent(const QMLExpression::Expression& exp
  */
 std::expected<bool, std::string> coherent(const QMLExpression::Expression& expr, const IModel& model, simple_logger::SimpleLogger* logger, bool log_details)
 {
-	logger = simple_logger::normalize(logger);
-	simple_logger::SimpleLogger* detail_logger = log_details ? logger : nullptr;
+	return coherent(expr, model, RelationOptions{ .logger = logger, .logDetails = log_details });
+}
+
+/**
+ * @brief Determines whether an expression is coherent within a given model, with the given relation options.
+ *
+ * See the overload taking a logger. With an executor in `options`, the information states
+ * of each size are checked in parallel.
+ */
+std::expected<bool, std::string> coherent(const QMLExpression::Expression& expr, const IModel& model, const RelationOptions& options)
+{
+	if (isSymbolic(options) && isVariableFree(expr)) {
+		if (auto decided = coherentSymbolically(expr, model, options)) {
+			return std::move(decided.value());
+		}
+	}
+
+	if (!options.logDetails && isVariableFree(expr)) {
+		return coherentOnWorldSets(expr, model, options);
+	}
+
+	SearchProfile profile(options.profiler, "coherent");
+	const bool logging = options.logger != nullptr;
+	simple_logger::SimpleLogger* logger = simple_logger::normalize(options.logger);
+	simple_logger::SimpleLogger* detail_logger = options.logDetails ? logger : nullptr;
+	std::optional<ExtensionIndex> local_extensions;
+	const RelationOptions indexed_options = indexedOptions(options, model, local_extensions);
+	const Program program(expr);
 	
 	for (const int i : std::views::iota(0, model.worldCardinality())) {
-		std::vector<InformationState> states = generateSubStates(model.worldCardinality() - 1, i);
-		const auto is_not_empty_or_supports_expression = [&](const InformationState& state) -> bool {
-			const auto result = supports(state, expr, model, detail_logger, log_details);
+		const auto is_not_empty_and_supports_expression = [&](SubstateEnumerator& substate) -> std::expected<bool, std::string> {
+			const InformationState& state = substate.state();
+			const auto result = supportedBy(state, program, model, detailOptions(detail_logger, indexed_options));
 			if (!result.has_value()) {
-				throw std::runtime_error(result.error());
+				return std::unexpected(result.error());
 			}
-			const bool is_coherent= !state.empty() && result.value();
+			const bool is_coherent = !state.empty() && result.value();
 			if (!is_coherent) {
-				logger->info(std::format("Formula is incoherent due to the following information state:\n{}", str(state, false)));
+				if (logging) {
+					logger->info(std::format("Formula is incoherent due to the following information state:\n{}", str(state, false)));
+				}
 			}
 			return is_coherent; 
 		};
-		try {
-			if (!std::ranges::any_of(states, is_not_empty_or_supports_expression)) {
-				logger->info("Evaluation result: False");
-				return false;
-			}
+		const auto coherent_state = findFirst(model.worldCardinality(), i, is_not_empty_and_supports_expression, searchExecutor(options), options.context, &profile);
+		if (!coherent_state.has_value()) {
+			return fail(logger, coherent_state.error());
 		}
-		catch (const std::runtime_error& e) {
-			const std::string error_message = e.what();
-			logger->info(std::format("Evaluation failed with the following error:\n{}", error_message));
-			return std::unexpected(error_message);
+		if (!coherent_state.value().has_value()) {
+			logger->info("Evaluation result: False");
+			return false;
 		}
 	}
 	logger->info("Evaluation result: True");
@@ -287,17 +1104,25 @@ std::expected<bool, std::string> entails(const std::vector<QMLExpression::Expres
     return entails_G(premises, conclusion, model, logger, log_details);
 }
 
+/**
+ * @brief An implementation of GSV's logical consequence relation, with the given relation options.
+ *
+ * This function is an alias for `entails_G()`.
+ */
+std::expected<bool, std::string> entails(const std::vector<QMLExpression::Expression>& premises, const QMLExpression::Expression& conclusion, const IModel& model, const RelationOptions& options)
+{
+    return entails_G(premises, conclusion, model, options);
+}
+
 namespace {
-	std::expected<void, std::string> sequentiallyUpdate(InformationState& state, const std::vector<QMLExpression::Expression>& expressions, const IModel& model, simple_logger::SimpleLogger* logger = nullptr)
+	std::expected<void, std::string> sequentiallyUpdate(InformationState& state, const std::vector<Program>& programs, const IModel& model, const EvaluationOptions& options)
 	{
-		logger = simple_logger::normalize(logger);
-
-		for (const QMLExpression::Expression& expr : expressions) {
-			const auto update = evaluate(expr, state, model, logger);
+		for (const Program& program : programs) {
+			auto update = evaluate(program, std::move(state), model, options);
 			if (!update.has_value()) {
-				return std::unexpected(std::format("In evaluating formula {}:\n{}", std::visit(QMLExpression::Formatter(), QMLExpression::Expression(expr)), update.error()));
+				return std::unexpected(formulaError(program.source(), update.error()));
 			}
-			state = update.value();
+			state = std::move(update.value());
 		}
 		return {};
 	}
@@ -322,13 +1147,27 @@ namespace {
  */
 std::expected<bool, std::string> entails_0(const std::vector<QMLExpression::Expression>& premises, const QMLExpression::Expression& conclusion, const IModel& model, simple_logger::SimpleLogger* logger, bool log_details)
 {
-	logger = simple_logger::normalize(logger);
-	simple_logger::SimpleLogger* detail_logger = log_details ? logger : nullptr;
+	return entails_0(premises, conclusion, model, RelationOptions{ .logger = logger, .logDetails = log_details });
+}
+
+/**
+ * @brief An implementation of Veltmann's Update Semantics' logical consequence relation at the ignorant state, with the given relation options.
+ *
+ * See the overload taking a logger. The evaluations go through `options.cache`, if set.
+ */
+std::expected<bool, std::string> entails_0(const std::vector<QMLExpression::Expression>& premises, const QMLExpression::Expression& conclusion, const IModel& model, const RelationOptions& options)
+{
+	simple_logger::SimpleLogger* logger = simple_logger::normalize(options.logger);
+	simple_logger::SimpleLogger* detail_logger = options.logDetails ? logger : nullptr;
+	std::optional<ExtensionIndex> local_extensions;
+	const RelationOptions indexed_options = indexedOptions(options, model, local_extensions);
+	const std::vector<Program> premise_programs = compile(premises);
+	const Program conclusion_program(conclusion);
 
     InformationState ignorant_state = create(model);
 
 	// update input state with premises
-	const auto sequential_update = sequentiallyUpdate(ignorant_state, premises, model, detail_logger);
+	const auto sequential_update = sequentiallyUpdate(ignorant_state, premise_programs, model, evaluationOptions(detail_logger, indexed_options));
 	if (!sequential_update.has_value()) {
 		const std::string error_message = sequential_update.error();
 		logger->info(std::format("Evaluation failed with the following error:\n{}", error_message));
@@ -336,7 +1175,7 @@ std::expected<bool, std::string> entails_0(const std::vector<QMLExpression::Expr
 	}
 
 	// check if update with conclusion exists
-	const auto conclusion_update = evaluate(conclusion, ignorant_state, model, detail_logger);
+	const auto conclusion_update = evaluate(conclusion_program, ignorant_state, model, evaluationOptions(detail_logger, indexed_options));
 	if (!conclusion_update.has_value()) {
 		const std::string error_message = conclusion_update.error();
 		logger->info(std::format("Evaluation failed with the following error:\n{}", error_message));
@@ -344,7 +1183,7 @@ std::expected<bool, std::string> entails_0(const std::vector<QMLExpression::Expr
 	}
 
 	// update exists, check for support
-	const auto does_support = supports(ignorant_state, conclusion, model, detail_logger, log_details);
+	const auto does_support = supportedBy(ignorant_state, conclusion_program, model, detailOptions(detail_logger, indexed_options));
 	if (!does_support.has_value()) {
 		const std::string error_message = does_support.error();
 		logger->info(std::format("Evaluation failed with the following error:\n{}", error_message));
@@ -378,40 +1217,86 @@ std::expected<bool, std::string> entails_0(const std::vector<QMLExpression::Expr
  */
 std::expected<bool, std::string> entails_G(const std::vector<QMLExpression::Expression>& premises, const QMLExpression::Expression& conclusion, const IModel& model, simple_logger::SimpleLogger* logger, bool log_details)
 {
-	logger = simple_logger::normalize(logger);
-	simple_logger::SimpleLogger* detail_logger = log_details ? logger : nullptr;
+	return entails_G(premises, conclusion, model, RelationOptions{ .logger = logger, .logDetails = log_details });
+}
+
+/**
+ * @brief An implementation of Veltmann's Update Semantics' logical consequence relation at every state, with the given relation options.
+ *
+ * See the overload taking a logger. With an executor in `options`, the information states
+ * of each size are checked in parallel. If the entailment fails and `options.counterexample`
+ * is set, it receives the input state (before the update with the premises) that falsifies it.
+ */
+std::expected<bool, std::string> entails_G(const std::vector<QMLExpression::Expression>& premises, const QMLExpression::Expression& conclusion, const IModel& model, const RelationOptions& options)
+{
+	if (auto reduced = onQuotient(withConclusion(premises, conclusion), model, options, [&](const IModel& quotient, const RelationOptions& quotient_options) { return entails_G(premises, conclusion, quotient, quotient_options); })) {
+		return std::move(reduced.value());
+	}
+
+	if (isSymbolic(options) && areVariableFree(premises) && isVariableFree(conclusion)) {
+		if (auto decided = entailsGSymbolically(premises, conclusion, model, options)) {
+			return std::move(decided.value());
+		}
+	}
+
+	if (!options.logDetails && areVariableFree(premises) && isVariableFree(conclusion)) {
+		return entailsGOnWorldSets(premises, conclusion, model, options);
+	}
+
+	SearchProfile profile(options.profiler, "entails_G");
+	const bool logging = options.logger != nullptr;
+	simple_logger::SimpleLogger* logger = simple_logger::normalize(options.logger);
+	simple_logger::SimpleLogger* detail_logger = options.logDetails ? logger : nullptr;
+	std::optional<ExtensionIndex> local_extensions;
+	const RelationOptions indexed_options = indexedOptions(options, model, local_extensions);
+	const std::vector<Program> premise_programs = compile(premises);
+	const Program conclusion_program(conclusion);
 	
-	for (const int i : std::views::iota(0, model.worldCardinality())) {
-		std::vector<InformationState> states = generateSubStates(model.worldCardinality() - 1, i);
-		for (InformationState& input_state : states) {
+	const int sizes = searchedSizes(model, options, areDistributive(premises) && isDistributive(conclusion));
+	for (const int i : std::views::iota(0, sizes)) {
+		std::mutex counterexamples_mutex;
+		std::map<std::uint64_t, InformationState> premises_updates;
+
+		const auto is_counterexample = [&](SubstateEnumerator& substate) -> std::expected<bool, std::string> {
 			// update input state with premises
-			const auto sequential_update = sequentiallyUpdate(input_state, premises, model, detail_logger);
+			InformationState input_state = substate.state();
+			const auto sequential_update = sequentiallyUpdate(input_state, premise_programs, model, evaluationOptions(detail_logger, indexed_options));
 			if (!sequential_update.has_value()) {
-				const std::string error_message = sequential_update.error();
-				logger->info(std::format("Evaluation failed with the following error:\n{}", error_message));
-				return std::unexpected(error_message);
+				return std::unexpected(sequential_update.error());
 			}
 
 			// check if update with conclusion exists
-			const auto conclusion_update = evaluate(conclusion, input_state, model, detail_logger);
+			const auto conclusion_update = evaluate(conclusion_program, input_state, model, evaluationOptions(detail_logger, indexed_options));
 			if (!conclusion_update.has_value()) {
-				const std::string error_message = conclusion_update.error();
-				logger->info(std::format("Evaluation failed with the following error:\n{}", error_message));
-				return std::unexpected(error_message);
+				return std::unexpected(conclusion_update.error());
 			}
 
 			// update exists, check for support
-			const auto does_support = supports(input_state, conclusion, model, detail_logger, log_details);
+			const auto does_support = supportedBy(input_state, conclusion_program, model, detailOptions(detail_logger, indexed_options));
 			if (!does_support.has_value()) {
-				const std::string error_message = does_support.error();
-				logger->info(std::format("Evaluation failed with the following error:\n{}", error_message));
-				return std::unexpected(error_message);
+				return std::unexpected(does_support.error());
 			}
-			if (!does_support.value()) {
-				logger->info(std::format("The following information state provides a counterexample to the argument:\n\n{}\n", str(input_state, false)));
-				logger->info("Evaluation result: False");
+			if (does_support.value()) {
 				return false;
 			}
+			std::scoped_lock lock(counterexamples_mutex);
+			premises_updates.emplace(substate.rank(), std::move(input_state));
+			return true;
+		};
+		const auto counterexample = findFirst(model.worldCardinality(), i, is_counterexample, searchExecutor(options), options.context, &profile);
+		if (!counterexample.has_value()) {
+			return fail(logger, counterexample.error());
+		}
+		if (counterexample.value().has_value()) {
+			const std::uint64_t rank = counterexample.value().value();
+			if (logging) {
+				logger->info(std::format("The following information state provides a counterexample to the argument:\n\n{}\n", str(premises_updates.at(rank), false)));
+			}
+			if (options.counterexample != nullptr) {
+				*options.counterexample = SubstateEnumerator(model.worldCardinality(), i, rank).state();
+			}
+			logger->info("Evaluation result: False");
+			return false;
 		}
 	}
 	logger->info("Evaluation result: True");
@@ -439,48 +1324,78 @@ std::expected<bool, std::string> entails_G(const std::vector<QMLExpression::Expr
  */
 std::expected<bool, std::string> entails_C(const std::vector<QMLExpression::Expression>& premises, const QMLExpression::Expression& conclusion, const IModel& model, simple_logger::SimpleLogger* logger, bool log_details)
 {
-	logger = simple_logger::normalize(logger);
-	simple_logger::SimpleLogger* detail_logger = log_details ? logger : nullptr;
+	return entails_C(premises, conclusion, model, RelationOptions{ .logger = logger, .logDetails = log_details });
+}
+
+/**
+ * @brief An implementation of Veltmann's Update Semantics' entailment-as-support logical consequence relation, with the given relation options.
+ *
+ * See the overload taking a logger. With an executor in `options`, the information states
+ * of each size are checked in parallel. If the entailment fails and `options.counterexample`
+ * is set, it receives the state that supports the premises but not the conclusion.
+ */
+std::expected<bool, std::string> entails_C(const std::vector<QMLExpression::Expression>& premises, const QMLExpression::Expression& conclusion, const IModel& model, const RelationOptions& options)
+{
+	if (auto reduced = onQuotient(withConclusion(premises, conclusion), model, options, [&](const IModel& quotient, const RelationOptions& quotient_options) { return entails_C(premises, conclusion, quotient, quotient_options); })) {
+		return std::move(reduced.value());
+	}
+
+	if (isSymbolic(options) && areVariableFree(premises) && isVariableFree(conclusion)) {
+		if (auto decided = entailsCSymbolically(premises, conclusion, model, options)) {
+			return std::move(decided.value());
+		}
+	}
+
+	if (!options.logDetails && areVariableFree(premises) && isVariableFree(conclusion)) {
+		return entailsCOnWorldSets(premises, conclusion, model, options);
+	}
+
+	SearchProfile profile(options.profiler, "entails_C");
+	const bool logging = options.logger != nullptr;
+	simple_logger::SimpleLogger* logger = simple_logger::normalize(options.logger);
+	simple_logger::SimpleLogger* detail_logger = options.logDetails ? logger : nullptr;
+	std::optional<ExtensionIndex> local_extensions;
+	const RelationOptions indexed_options = indexedOptions(options, model, local_extensions);
+	const std::vector<Program> premise_programs = compile(premises);
+	const Program conclusion_program(conclusion);
 	
-	for (const int i : std::views::iota(0, model.worldCardinality())) {
-		std::vector<InformationState> states = generateSubStates(model.worldCardinality() - 1, i);
-		for (InformationState& input_state : states) {
-			//go through every premise and check for support
-			bool supports_every_premise = true;
+	const int sizes = searchedSizes(model, options, areDistributive(premises) && isDistributive(conclusion));
+	for (const int i : std::views::iota(0, sizes)) {
+		const auto is_counterexample = [&](SubstateEnumerator& substate) -> std::expected<bool, std::string> {
+			const InformationState& input_state = substate.state();
 
-			for (const auto& premise : premises) {
-				const auto supports_premise = supports(input_state, premise, model, detail_logger, log_details);
+			//go through every premise and check for support
+			for (const Program& premise : premise_programs) {
+				const auto supports_premise = supportedBy(input_state, premise, model, detailOptions(detail_logger, indexed_options));
 				if (!supports_premise.has_value()) {
-					const std::string error_message = supports_premise.error();
-					logger->info(std::format("Evaluation failed with the following error:\n{}", error_message));
-					return std::unexpected(error_message);
+					return std::unexpected(supports_premise.error());
 				}
+				// if state does not support every permise, not a counterexample
 				if (!supports_premise.value()) {
-					supports_every_premise = false;
-					break;
+					return false;
 				}
 			}
 
-            // if state does not support every permise, not a counterexample (continue to next iteration)
-            if (!supports_every_premise) {
-                continue;
-            }
-
-			// check whether state supports conclusion
-			const auto result = supports(input_state, conclusion, model, detail_logger, log_details);
+			// check whether state supports conclusion; if it does not, it is a counterexample
+			const auto result = supportedBy(input_state, conclusion_program, model, detailOptions(detail_logger, indexed_options));
 			if (!result.has_value()) {
-				const std::string error_message = result.error();
-				logger->info(std::format("Evaluation failed with the following error:\n{}", error_message));
-				return std::unexpected(error_message);
+				return std::unexpected(result.error());
+			}
+			return !result.value();
+		};
+		const auto counterexample = findFirst(model.worldCardinality(), i, is_counterexample, searchExecutor(options), options.context, &profile);
+		if (!counterexample.has_value()) {
+			return fail(logger, counterexample.error());
+		}
+		if (counterexample.value().has_value()) {
+			SubstateEnumerator counterexample_state(model.worldCardinality(), i, counterexample.value().value());
+			const InformationState& input_state = counterexample_state.state();
+			if (logging) {
+				logger->info(std::format("The following information state provides a counterexample to the argument:\n\n{}\n", str(input_state, false)));
+			}
+			if (options.counterexample != nullptr) {
+				*options.counterexample = input_state;
 			}
-
-            // if it does, go to next iteration (not a counterexample)
-            if (result.value()) {
-                continue;
-            }
-
-			// if it does not, return false
-			logger->info(std::format("The following information state provides a counterexample to the argument:\n\n{}\n", str(input_state, false)));
 			logger->info("Evaluation result: False");
 			return false;
 		}
@@ -492,9 +1407,379 @@ std::expected<bool, std::string> entails_C(const std::vector<QMLExpression::Expr
 
 namespace {
 
+/*
+ * BATCH SEARCH
+ *
+ * A batch of entailment checks shares its premises, so it scans the states of the model
+ * once for all of its conclusions: the work that depends on the premises alone is done
+ * once per state, and only the conclusions still undecided are checked against it.
+ */
+
+using BatchOutcome = std::expected<bool, std::string>;
+
+/**
+ * @brief Prepares a state for a batch: the state to check the conclusions against, nullopt if
+ *        the state is no counterexample to any conclusion, or an error shared by all of them.
+ */
+using BatchPreparation = std::function<std::expected<std::optional<InformationState>, std::string>(SubstateEnumerator&)>;
+
+/**
+ * @brief Checks a prepared state against one conclusion: true if it is a counterexample.
+ */
+using BatchProbe = std::function<std::expected<bool, std::string>(const InformationState&, std::size_t)>;
+
+/**
+ * @brief Runs one counterexample search per conclusion, over a single scan of the states of a model.
+ *
+ * States are visited in the order of the single-conclusion searches, and conclusion `j` is
+ * decided by the first state (among the first `sizes[j]` sizes) that is a counterexample to it
+ * or fails, so every outcome is the one its own search would have produced. With an executor,
+ * the undecided conclusions are checked against each state in parallel.
+ *
+ * @param worlds Number of worlds of the model.
+ * @param sizes Number of state sizes to search, per conclusion.
+ * @param prepare Prepares each state for the conclusions.
+ * @param probe Checks a prepared state against a conclusion. It may be called concurrently.
+ * @param executor Pool to check conclusions on, or nullptr for a serial search.
+ * @param context Admits every state before it is prepared, or nullptr. A refused state
+ *        fails every conclusion still undecided with the message of the context.
+ * @param profile Counts the states scanned. The scan exits early if every conclusion is
+ *        decided by a state.
+ * @return Per conclusion, false if a counterexample was found, true if none was, or the
+ *         error of the state that settled its search.
+ */
+std::vector<BatchOutcome> searchEach(int worlds, const std::vector<int>& sizes, const BatchPreparation& prepare, const BatchProbe& probe, ThreadPool* executor, EvaluationContext* context, SearchProfile& profile)
+{
+    std::vector<BatchOutcome> outcomes(sizes.size(), true);
+    std::vector<std::size_t> undecided(sizes.size());
+    std::iota(undecided.begin(), undecided.end(), std::size_t{ 0 });
+    std::vector<BatchOutcome> checks;
+
+    const int searched_sizes = sizes.empty() ? 0 : std::ranges::max(sizes);
+    for (const int i : std::views::iota(0, searched_sizes)) {
+        std::erase_if(undecided, [&](std::size_t j) -> bool { return sizes[j] <= i; });
+
+        for (SubstateEnumerator substate(worlds, i); !substate.done() && !undecided.empty(); substate.next()) {
+            profile.countState();
+            const auto prepared = context == nullptr || context->admitState() ? prepare(substate) : std::unexpected(context->message());
+            if (!prepared.has_value()) {
+                for (const std::size_t j : undecided) {
+                    outcomes[j] = std::unexpected(prepared.error());
+                }
+                profile.stopEarly();
+                return outcomes;
+            }
+            if (!prepared.value().has_value()) {
+                continue;
+            }
+
+            const InformationState& state = prepared.value().value();
+            checks.assign(undecided.size(), false);
+            const auto check = [&](std::size_t k) { checks[k] = probe(state, undecided[k]); };
+            if (executor != nullptr && undecided.size() > 1) {
+                executor->parallelFor(undecided.size(), check);
+            }
+            else {
+                for (const std::size_t k : std::views::iota(std::size_t{ 0 }, undecided.size())) {
+                    check(k);
+                }
+            }
+
+            std::size_t kept = 0;
+            for (const std::size_t k : std::views::iota(std::size_t{ 0 }, undecided.size())) {
+                if (checks[k].has_value() && !checks[k].value()) {
+                    undecided[kept++] = undecided[k];
+                }
+                else if (checks[k].has_value()) {
+                    outcomes[undecided[k]] = false;
+                }
+                else {
+                    outcomes[undecided[k]] = std::unexpected(checks[k].error());
+                }
+            }
+            undecided.resize(kept);
+            if (undecided.empty()) {
+                profile.stopEarly();
+            }
+        }
+    }
+    return outcomes;
+}
+
+/**
+ * @brief The options of a batch, whose searches never log: those of the caller, without the logger.
+ */
+RelationOptions batchOptions(const RelationOptions& options)
+{
+    RelationOptions quiet_options = options;
+    quiet_options.logger = nullptr;
+    quiet_options.logDetails = false;
+    return quiet_options;
+}
+
+std::vector<int> batchSizes(const BatchAnalysis& analysis, const IModel& model, const RelationOptions& options)
+{
+    std::vector<int> sizes;
+    sizes.reserve(analysis.distributive.size());
+    for (const bool distributive : analysis.distributive) {
+        sizes.push_back(searchedSizes(model, options, distributive));
+    }
+    return sizes;
+}
+
+/**
+ * @brief `entails_G_batch()` on the symbolic backend: the premises update every state once
+ *        for the whole batch, or nullopt if an interpretation fails.
+ */
+std::optional<std::vector<BatchOutcome>> entailsGBatchSymbolically(const BatchAnalysis& analysis, const IModel& model, const RelationOptions& options)
+{
+    const std::vector<QMLExpression::Expression>& premises = analysis.premises;
+    const std::vector<QMLExpression::Expression>& conclusions = analysis.conclusions;
+    SearchProfile profile(options.profiler, "entails_G_batch");
+    DecisionDiagram diagram(model.worldCardinality());
+    // Batches never log details, so their searches are those of quiet options
+    const std::vector<int> sizes = batchSizes(analysis, model, RelationOptions{});
+
+    const auto premises_update = sequentiallyUpdate(everyState(diagram), premises, model, diagram);
+    if (!premises_update.has_value()) {
+        profile.discard();
+        return std::nullopt;
+    }
+
+    std::vector<BatchOutcome> outcomes;
+    outcomes.reserve(conclusions.size());
+    for (std::size_t j = 0; j < conclusions.size(); ++j) {
+        const auto conclusion_update = evaluate(conclusions[j], premises_update.value(), model, diagram);
+        if (!conclusion_update.has_value()) {
+            profile.discard();
+            return std::nullopt;
+        }
+        const DecisionDiagram::Node counterexamples = diagram.negation(isSubsetOf(premises_update.value(), conclusion_update.value(), diagram));
+        outcomes.emplace_back(!firstCounterexample(diagram, counterexamples, sizes[j]).has_value());
+    }
+    return outcomes;
+}
+
+/**
+ * @brief `entails_C_batch()` on the symbolic backend: support for the premises is decided
+ *        once for the whole batch, or nullopt if an interpretation fails.
+ */
+std::optional<std::vector<BatchOutcome>> entailsCBatchSymbolically(const BatchAnalysis& analysis, const IModel& model, const RelationOptions& options)
+{
+    const std::vector<QMLExpression::Expression>& premises = analysis.premises;
+    const std::vector<QMLExpression::Expression>& conclusions = analysis.conclusions;
+    SearchProfile profile(options.profiler, "entails_C_batch");
+    DecisionDiagram diagram(model.worldCardinality());
+    // Batches never log details, so their searches are those of quiet options
+    const std::vector<int> sizes = batchSizes(analysis, model, RelationOptions{});
+    const SymbolicState states = everyState(diagram);
+
+    const std::optional<DecisionDiagram::Node> supporting = supportingStates(states, premises, model, diagram);
+    if (!supporting.has_value()) {
+        profile.discard();
+        return std::nullopt;
+    }
+    const SymbolicState candidates = restricted(states, supporting.value(), diagram);
+
+    std::vector<BatchOutcome> outcomes;
+    outcomes.reserve(conclusions.size());
+    for (std::size_t j = 0; j < conclusions.size(); ++j) {
+        const auto conclusion_update = evaluate(conclusions[j], candidates, model, diagram);
+        if (!conclusion_update.has_value()) {
+            profile.discard();
+            return std::nullopt;
+        }
+        const DecisionDiagram::Node counterexamples = diagram.conjunction(supporting.value(), diagram.negation(isSubsetOf(candidates, conclusion_update.value(), diagram)));
+        outcomes.emplace_back(!firstCounterexample(diagram, counterexamples, sizes[j]).has_value());
+    }
+    return outcomes;
+}
+
+} // ANONYMOUS NAMESPACE
+
+/**
+ * @brief Analyses the compiled premises and conclusions of a batch.
+ */
+BatchAnalysis::BatchAnalysis(const std::vector<Program>& premise_programs, const std::vector<Program>& conclusion_programs)
+{
+	premises.reserve(premise_programs.size());
+	for (const Program& premise : premise_programs) {
+		premises.push_back(premise.source());
+	}
+	conclusions.reserve(conclusion_programs.size());
+	for (const Program& conclusion : conclusion_programs) {
+		conclusions.push_back(conclusion.source());
+	}
+	expressions = withConclusions(premises, conclusions);
+	variableFree = areVariableFree(expressions);
+
+	const bool distributive_premises = areDistributive(premises);
+	distributive.reserve(conclusions.size());
+	for (const QMLExpression::Expression& conclusion : conclusions) {
+		distributive.push_back(distributive_premises && isDistributive(conclusion));
+	}
+}
+
+/**
+ * @brief Checks `entails_G()` for the same premises against each of several conclusions.
+ *
+ * Element `j` of the result is the outcome of `entails_G(premises, conclusions[j], model, options)`.
+ * Each state is updated with the premises once for the whole batch, and the update with each
+ * conclusion is computed once and tested for support directly. The batch is dropped from the
+ * search as soon as each of its conclusions is decided.
+ *
+ * The batch does not log, and does not report counterexamples: `options.logger`,
+ * `options.logDetails` and `options.counterexample` are ignored. With an executor in
+ * `options`, the conclusions still undecided are checked against each state in parallel.
+ *
+ * @param premises A vector of expressions representing the premises.
+ * @param conclusions The expressions representing the conclusions.
+ * @param model The model against which entailment is evaluated.
+ * @param options The relation options.
+ * @return std::vector<std::expected<bool, std::string>> Per conclusion, `true` if it is
+ *         supported in all states updated by the premises, `false` otherwise, or an error
+ *         message if evaluation fails.
+ */
+std::vector<std::expected<bool, std::string>> entails_G_batch(const std::vector<QMLExpression::Expression>& premises, const std::vector<QMLExpression::Expression>& conclusions, const IModel& model, const RelationOptions& options)
+{
+	const std::vector<Program> premise_programs = compile(premises);
+	const std::vector<Program> conclusion_programs = compile(conclusions);
+	return entails_G_batch(premise_programs, conclusion_programs, BatchAnalysis(premise_programs, conclusion_programs), model, options);
+}
+
+/**
+ * @brief `entails_G_batch()` on premises and conclusions compiled and analysed beforehand.
+ *
+ * The analysis must be the one of `premises` and `conclusions`. Checking a batch on several
+ * models with the same programs and analysis compiles and analyses its formulas only once.
+ */
+std::vector<std::expected<bool, std::string>> entails_G_batch(const std::vector<Program>& premises, const std::vector<Program>& conclusions, const BatchAnalysis& analysis, const IModel& model, const RelationOptions& options)
+{
+	// The logger is dropped before the quotient is tried, which a logger would rule out
+	const RelationOptions batch_options = batchOptions(options);
+	if (auto reduced = onQuotient(analysis.expressions, model, batch_options, [&](const IModel& quotient, const RelationOptions& quotient_options) { return entails_G_batch(premises, conclusions, analysis, quotient, quotient_options); })) {
+		return std::move(reduced.value());
+	}
+
+	if (options.backend == RelationBackend::SYMBOLIC && options.context == nullptr && analysis.variableFree) {
+		if (auto decided = entailsGBatchSymbolically(analysis, model, batch_options)) {
+			return std::move(decided.value());
+		}
+	}
+
+	std::optional<ExtensionIndex> local_extensions;
+	const RelationOptions quiet_options = indexedOptions(batch_options, model, local_extensions);
+
+	const auto update_with_premises = [&](SubstateEnumerator& substate) -> std::expected<std::optional<InformationState>, std::string> {
+		InformationState input_state = substate.state();
+		const auto sequential_update = sequentiallyUpdate(input_state, premises, model, evaluationOptions(nullptr, quiet_options));
+		if (!sequential_update.has_value()) {
+			return std::unexpected(sequential_update.error());
+		}
+		return input_state;
+	};
+	const auto is_counterexample = [&](const InformationState& premises_update, std::size_t j) -> std::expected<bool, std::string> {
+		const auto conclusion_update = evaluate(conclusions[j], premises_update, model, evaluationOptions(nullptr, quiet_options));
+		if (!conclusion_update.has_value()) {
+			return std::unexpected(conclusion_update.error());
+		}
+		return !subsistsIn(premises_update, conclusion_update.value());
+	};
+
+	SearchProfile profile(options.profiler, "entails_G_batch");
+	return searchEach(model.worldCardinality(), batchSizes(analysis, model, quiet_options), update_with_premises, is_counterexample, options.executor, options.context, profile);
+}
+
+/**
+ * @brief Checks `entails_C()` for the same premises against each of several conclusions.
+ *
+ * Element `j` of the result is the outcome of `entails_C(premises, conclusions[j], model, options)`.
+ * Support for the premises is checked once per state for the whole batch. As with
+ * `entails_G_batch()`, the batch does not log and does not report counterexamples.
+ *
+ * @param premises A vector of expressions representing the premises.
+ * @param conclusions The expressions representing the conclusions.
+ * @param model The model against which entailment is evaluated.
+ * @param options The relation options.
+ * @return std::vector<std::expected<bool, std::string>> Per conclusion, `true` if it is
+ *         supported in all states that support the premises, `false` otherwise, or an error
+ *         message if evaluation fails.
+ */
+std::vector<std::expected<bool, std::string>> entails_C_batch(const std::vector<QMLExpression::Expression>& premises, const std::vector<QMLExpression::Expression>& conclusions, const IModel& model, const RelationOptions& options)
+{
+	const std::vector<Program> premise_programs = compile(premises);
+	const std::vector<Program> conclusion_programs = compile(conclusions);
+	return entails_C_batch(premise_programs, conclusion_programs, BatchAnalysis(premise_programs, conclusion_programs), model, options);
+}
+
+/**
+ * @brief `entails_C_batch()` on premises and conclusions compiled and analysed beforehand.
+ *
+ * The analysis must be the one of `premises` and `conclusions`. Checking a batch on several
+ * models with the same programs and analysis compiles and analyses its formulas only once.
+ */
+std::vector<std::expected<bool, std::string>> entails_C_batch(const std::vector<Program>& premises, const std::vector<Program>& conclusions, const BatchAnalysis& analysis, const IModel& model, const RelationOptions& options)
+{
+	// The logger is dropped before the quotient is tried, which a logger would rule out
+	const RelationOptions batch_options = batchOptions(options);
+	if (auto reduced = onQuotient(analysis.expressions, model, batch_options, [&](const IModel& quotient, const RelationOptions& quotient_options) { return entails_C_batch(premises, conclusions, analysis, quotient, quotient_options); })) {
+		return std::move(reduced.value());
+	}
+
+	if (options.backend == RelationBackend::SYMBOLIC && options.context == nullptr && analysis.variableFree) {
+		if (auto decided = entailsCBatchSymbolically(analysis, model, batch_options)) {
+			return std::move(decided.value());
+		}
+	}
+
+	std::optional<ExtensionIndex> local_extensions;
+	const RelationOptions quiet_options = indexedOptions(batch_options, model, local_extensions);
+
+	const auto supports_premises = [&](SubstateEnumerator& substate) -> std::expected<std::optional<InformationState>, std::string> {
+		const InformationState& input_state = substate.state();
+		for (const Program& premise : premises) {
+			const auto supports_premise = supportedBy(input_state, premise, model, quiet_options);
+			if (!supports_premise.has_value()) {
+				return std::unexpected(supports_premise.error());
+			}
+			if (!supports_premise.value()) {
+				return std::nullopt;
+			}
+		}
+		return input_state;
+	};
+	const auto is_counterexample = [&](const InformationState& input_state, std::size_t j) -> std::expected<bool, std::string> {
+		const auto result = supportedBy(input_state, conclusions[j], model, quiet_options);
+		if (!result.has_value()) {
+			return std::unexpected(result.error());
+		}
+		return !result.value();
+	};
+
+	SearchProfile profile(options.profiler, "entails_C_batch");
+	return searchEach(model.worldCardinality(), batchSizes(analysis, model, quiet_options), supports_premises, is_counterexample, options.executor, options.context, profile);
+}
+
+/**
+ * @brief Checks `entails()` for the same premises against each of several conclusions.
+ *
+ * This function is an alias for `entails_G_batch()`.
+ */
+std::vector<std::expected<bool, std::string>> entails_batch(const std::vector<QMLExpression::Expression>& premises, const std::vector<QMLExpression::Expression>& conclusions, const IModel& model, const RelationOptions& options)
+{
+	return entails_G_batch(premises, conclusions, model, options);
+}
+
+std::vector<std::expected<bool, std::string>> entails_batch(const std::vector<Program>& premises, const std::vector<Program>& conclusions, const BatchAnalysis& analysis, const IModel& model, const RelationOptions& options)
+{
+	return entails_G_batch(premises, conclusions, analysis, model, options);
+}
+
+namespace {
+
 std::expected<bool, std::string> similar(const Possibility& p1, const Possibility& p2)
 {
-    const auto have_same_denotation = [&](std::string_view variable) -> bool {
+    const auto have_same_denotation = [&](SymbolId variable) -> bool {
         const auto denotation_at_p1 = variableDenotation(variable, p1);
         const auto denotation_at_p2 = variableDenotation(variable, p2);
         if (!denotation_at_p1.has_value()) {
@@ -508,8 +1793,8 @@ std::expected<bool, std::string> similar(const Possibility& p1, const Possibilit
 
     try {
         return p1.world == p2.world
-            && domain(*p1.referentSystem) == domain(*p2.referentSystem)
-            && std::ranges::all_of(domain(*p1.referentSystem), have_same_denotation);
+            && variables(*p1.referentSystem) == variables(*p2.referentSystem)
+            && std::ranges::all_of(variables(*p1.referentSystem), have_same_denotation);
     }
     catch (const std::out_of_range& e) {
         return std::unexpected(e.what());
@@ -567,43 +1852,80 @@ std::expected<bool, std::string> similar(const InformationState& s1, const Infor
  */
 std::expected<bool, std::string> equivalent(const QMLExpression::Expression& expr1, const QMLExpression::Expression& expr2, const IModel& model, simple_logger::SimpleLogger* logger, bool log_details)
 {
-	logger = simple_logger::normalize(logger);
-	simple_logger::SimpleLogger* detail_logger = log_details ? logger : nullptr;
+	return equivalent(expr1, expr2, model, RelationOptions{ .logger = logger, .logDetails = log_details });
+}
+
+/**
+ * @brief Determines whether two expressions are logically equivalent, relative to a given model, with the given relation options.
+ *
+ * See the overload taking a logger. With an executor in `options`, the information states
+ * of each size are checked in parallel. If the expressions are not equivalent and
+ * `options.counterexample` is set, it receives a state on which their updates differ.
+ */
+std::expected<bool, std::string> equivalent(const QMLExpression::Expression& expr1, const QMLExpression::Expression& expr2, const IModel& model, const RelationOptions& options)
+{
+	if (auto reduced = onQuotient({ expr1, expr2 }, model, options, [&](const IModel& quotient, const RelationOptions& quotient_options) { return equivalent(expr1, expr2, quotient, quotient_options); })) {
+		return std::move(reduced.value());
+	}
+
+	if (isSymbolic(options) && isVariableFree(expr1) && isVariableFree(expr2)) {
+		if (auto decided = equivalentSymbolically(expr1, expr2, model, options)) {
+			return std::move(decided.value());
+		}
+	}
+
+	if (!options.logDetails && isVariableFree(expr1) && isVariableFree(expr2)) {
+		return equivalentOnWorldSets(expr1, expr2, model, options);
+	}
+
+	SearchProfile profile(options.profiler, "equivalent");
+	const bool logging = options.logger != nullptr;
+	simple_logger::SimpleLogger* logger = simple_logger::normalize(options.logger);
+	simple_logger::SimpleLogger* detail_logger = options.logDetails ? logger : nullptr;
+	std::optional<ExtensionIndex> local_extensions;
+	const RelationOptions indexed_options = indexedOptions(options, model, local_extensions);
+	const Program program1(expr1);
+	const Program program2(expr2);
 	
-	for (const int i : std::views::iota(0, model.worldCardinality())) {
-		std::vector<InformationState> states = generateSubStates(model.worldCardinality() - 1, i);
+	const int sizes = searchedSizes(model, options, isDistributive(expr1) && isDistributive(expr2));
+	for (const int i : std::views::iota(0, sizes)) {
 
-		const auto dissimilar_updates = [&](const InformationState& state) ->bool { 
-			const auto expr1_update = evaluate(expr1, state, model, detail_logger);
+		const auto dissimilar_updates = [&](SubstateEnumerator& substate) -> std::expected<bool, std::string> {
+			const auto expr1_update = evaluate(program1, substate.state(), model, evaluationOptions(detail_logger, indexed_options));
 			if (!expr1_update.has_value()) {
-				throw std::out_of_range(expr1_update.error());
+				return std::unexpected(expr1_update.error());
 			}
-			const auto expr2_update = evaluate(expr2, state, model, detail_logger);
+			const auto expr2_update = evaluate(program2, substate.state(), model, evaluationOptions(detail_logger, indexed_options));
 			if (!expr2_update.has_value()) {
-				throw std::out_of_range(expr2_update.error());
+				return std::unexpected(expr2_update.error());
 			}
-			const bool comparison_result = !similar(expr1_update.value(), expr2_update.value());
-			if (comparison_result) {
-				logger->info(std::format("The following information state provides a counterexample to the equivalence:\n{}", str(state, false)));
+			const auto similarity = similar(expr1_update.value(), expr2_update.value());
+			if (!similarity.has_value()) {
+				return std::unexpected(similarity.error());
 			}
-			return comparison_result;
+			return !similarity.value();
 		};
 
-        try {
-            if (std::ranges::any_of(states, dissimilar_updates)) {
-                logger->info("Evaluation result: False");
-                return false;
-            }
-        }
-        catch (const std::out_of_range& e) {
-            const std::string error_message = e.what();
-            logger->info(std::format("Evaluation failed with the following error:\n{}", error_message));
-            return std::unexpected(error_message);
-        }
-    }
+		const auto counterexample = findFirst(model.worldCardinality(), i, dissimilar_updates, searchExecutor(options), options.context, &profile);
+		if (!counterexample.has_value()) {
+			return fail(logger, counterexample.error());
+		}
+		if (counterexample.value().has_value()) {
+			SubstateEnumerator counterexample_state(model.worldCardinality(), i, counterexample.value().value());
+			const InformationState& state = counterexample_state.state();
+			if (logging) {
+				logger->info(std::format("The following information state provides a counterexample to the equivalence:\n{}", str(state, false)));
+			}
+			if (options.counterexample != nullptr) {
+				*options.counterexample = state;
+			}
+			logger->info("Evaluation result: False");
+			return false;
+		}
+	}
 
-    logger->info("Evaluation result: True");
-    return true;
+	logger->info("Evaluation result: True");
+	return true;
 }
 
 }
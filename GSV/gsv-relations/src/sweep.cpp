@@ -0,0 +1,174 @@
+#include "sweep.hpp"
+
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "evaluator.hpp"
+#include "extension_index.hpp"
+#include "semantic_relations.hpp"
+#include "symmetry_index.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+namespace {
+
+/**
+ * @brief What a sweep builds once per model, for all its pairs.
+ */
+struct ModelSetup {
+    ModelSetup(const IModel& model, bool symmetric)
+        : extensions(model)
+        , symmetry(symmetric ? std::make_unique<const SymmetryIndex>(model) : nullptr)
+    { }
+
+    ExtensionIndex extensions;
+    std::unique_ptr<const SymmetryIndex> symmetry;
+};
+
+/**
+ * @brief Hands the results of a sweep to its sink, one at a time.
+ *
+ * The first exception thrown by the sink is kept for the end of the sweep, and later
+ * results are still delivered.
+ */
+template<typename Result>
+class Delivery {
+public:
+    explicit Delivery(const std::function<void(Result&&)>& sink)
+        : m_Sink(sink)
+    { }
+
+    void operator()(Result&& result)
+    {
+        std::scoped_lock lock(m_Mutex);
+        try {
+            m_Sink(std::move(result));
+        }
+        catch (...) {
+            if (!m_Error) {
+                m_Error = std::current_exception();
+            }
+        }
+    }
+
+    void rethrow() const
+    {
+        if (m_Error) {
+            std::rethrow_exception(m_Error);
+        }
+    }
+
+private:
+    const std::function<void(Result&&)>& m_Sink;
+    std::mutex m_Mutex;
+    std::exception_ptr m_Error;
+};
+
+/**
+ * @brief Calls `body(i)` for every `i` in `[0, count)`, on the executor if there is one, in order otherwise.
+ */
+void forEach(std::size_t count, ThreadPool* executor, const std::function<void(std::size_t)>& body)
+{
+    if (executor != nullptr) {
+        executor->parallelFor(count, body);
+        return;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        body(i);
+    }
+}
+
+} // ANONYMOUS NAMESPACE
+
+/**
+ * @brief Compiles the formulas of a sweep.
+ *
+ * @param formulas The formulas, referred to in the results by their position.
+ */
+Sweep::Sweep(const std::vector<QMLExpression::Expression>& formulas)
+    : m_Formulas(formulas)
+{
+    m_Programs.reserve(formulas.size());
+    for (const QMLExpression::Expression& formula : formulas) {
+        m_Programs.emplace_back(formula);
+    }
+}
+
+std::size_t Sweep::size() const
+{
+    return m_Formulas.size();
+}
+
+const std::vector<QMLExpression::Expression>& Sweep::formulas() const
+{
+    return m_Formulas;
+}
+
+/**
+ * @brief Updates the ignorant state of every model with every formula.
+ *
+ * The result for every pair is what `evaluate(formula, create(model), model)` returns.
+ *
+ * @param models The models, referred to in the results by their position.
+ * @param sink Receives the update of every (formula, model) pair.
+ * @param options The collaborators shared by every pair.
+ */
+void Sweep::evaluate(std::span<const IModel* const> models, const std::function<void(SweepEvaluation&&)>& sink, const SweepOptions& options) const
+{
+    Delivery<SweepEvaluation> deliver(sink);
+
+    forEach(models.size(), options.executor, [&](std::size_t m) {
+        const IModel& model = *models[m];
+        const ModelSetup setup(model, options.symmetry);
+        const InformationState ignorant_state = create(model);
+        const EvaluationOptions evaluation_options{ .executor = options.executor, .cache = options.cache, .extensions = &setup.extensions, .shortCircuit = options.shortCircuit, .useArena = options.useArena, .profiler = options.profiler, .context = options.context, .symmetry = setup.symmetry.get() };
+
+        forEach(m_Programs.size(), options.executor, [&](std::size_t f) {
+            deliver({ .formula = f, .model = m, .update = GSV::evaluate(m_Programs[f], ignorant_state, model, evaluation_options) });
+        });
+    });
+
+    deliver.rethrow();
+}
+
+/**
+ * @brief Checks in every model whether a set of premises entails every formula.
+ *
+ * The result for every pair is what `entails(premises, formula, model)` returns. The
+ * formulas of a model are checked together, as the conclusions of one `entails_batch()`
+ * call, so the premise updates are shared by all of them, and the results of a model are
+ * delivered once its batch is done. The premises are compiled, and the batch analysed,
+ * once for all the models.
+ *
+ * @param premises The premises, the same for every model.
+ * @param models The models, referred to in the results by their position.
+ * @param sink Receives the outcome of every (conclusion, model) pair.
+ * @param options The collaborators shared by every pair.
+ */
+void Sweep::entails(const std::vector<QMLExpression::Expression>& premises, std::span<const IModel* const> models, const std::function<void(SweepEntailment&&)>& sink, const SweepOptions& options) const
+{
+    std::vector<Program> premise_programs;
+    premise_programs.reserve(premises.size());
+    for (const QMLExpression::Expression& premise : premises) {
+        premise_programs.emplace_back(premise);
+    }
+    const BatchAnalysis analysis(premise_programs, m_Programs);
+    Delivery<SweepEntailment> deliver(sink);
+
+    forEach(models.size(), options.executor, [&](std::size_t m) {
+        const IModel& model = *models[m];
+        const ModelSetup setup(model, options.symmetry);
+        const RelationOptions relation_options{ .executor = options.executor, .cache = options.cache, .extensions = &setup.extensions, .shortCircuit = options.shortCircuit, .useArena = options.useArena, .profiler = options.profiler, .context = options.context, .symmetry = setup.symmetry.get(), .backend = options.backend };
+
+        std::vector<std::expected<bool, std::string>> outcomes = entails_batch(premise_programs, m_Programs, analysis, model, relation_options);
+        for (std::size_t c = 0; c < outcomes.size(); ++c) {
+            deliver({ .conclusion = c, .model = m, .holds = std::move(outcomes[c]) });
+        }
+    });
+
+    deliver.rethrow();
+}
+
+}
@@ -0,0 +1,241 @@
+#include "world_quotient.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+#include "program.hpp"
+#include "symbol_table.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+namespace {
+
+/**
+ * @brief The constants and the predicates the expressions mention, each once.
+ */
+struct Signature {
+    std::vector<SymbolId> constants;
+    std::vector<SymbolId> predicates;
+};
+
+Signature signature(const std::vector<QMLExpression::Expression>& expressions)
+{
+    Signature symbols;
+    for (const QMLExpression::Expression& expr : expressions) {
+        const Program program(expr);
+        for (std::uint32_t i = 0; i < program.size(); ++i) {
+            const Program::Instruction& instruction = program[i];
+            if (!isAtomic(instruction)) {
+                continue;
+            }
+            if (instruction.opcode == Program::Opcode::PREDICATION) {
+                symbols.predicates.push_back(instruction.symbol);
+            }
+            for (const Program::Term& term : program.terms(instruction)) {
+                if (!term.variable) {
+                    symbols.constants.push_back(term.symbol);
+                }
+            }
+        }
+    }
+    for (std::vector<SymbolId>* ids : { &symbols.constants, &symbols.predicates }) {
+        std::ranges::sort(*ids);
+        ids->erase(std::unique(ids->begin(), ids->end()), ids->end());
+    }
+    return symbols;
+}
+
+/**
+ * @brief The interpretations of a signature at one world, as the evaluator would read them.
+ */
+struct WorldView {
+    std::vector<std::expected<int, std::string>> constants;
+    std::vector<std::expected<const std::set<std::vector<int>>*, std::string>> predicates;
+};
+
+bool operator==(const WorldView& v1, const WorldView& v2)
+{
+    const auto same_constant = [](const std::expected<int, std::string>& c1, const std::expected<int, std::string>& c2) -> bool {
+        if (c1.has_value() != c2.has_value()) {
+            return false;
+        }
+        return c1.has_value() ? c1.value() == c2.value() : c1.error() == c2.error();
+    };
+    const auto same_extension = [](const std::expected<const std::set<std::vector<int>>*, std::string>& e1, const std::expected<const std::set<std::vector<int>>*, std::string>& e2) -> bool {
+        if (e1.has_value() != e2.has_value()) {
+            return false;
+        }
+        if (!e1.has_value()) {
+            return e1.error() == e2.error();
+        }
+        return e1.value() == e2.value() || (e1.value() != nullptr && e2.value() != nullptr && *e1.value() == *e2.value());
+    };
+    return std::ranges::equal(v1.constants, v2.constants, same_constant) && std::ranges::equal(v1.predicates, v2.predicates, same_extension);
+}
+
+std::size_t hashValue(const WorldView& view)
+{
+    std::size_t hash = view.constants.size();
+    const auto combine = [&](std::size_t value) { hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2); };
+    for (const auto& constant : view.constants) {
+        combine(constant.has_value() ? std::hash<int>{}(constant.value()) : std::hash<std::string>{}(constant.error()));
+    }
+    for (const auto& predicate : view.predicates) {
+        if (!predicate.has_value()) {
+            combine(std::hash<std::string>{}(predicate.error()));
+            continue;
+        }
+        combine(predicate.value() != nullptr ? predicate.value()->size() : 0);
+        if (predicate.value() != nullptr) {
+            for (const std::vector<int>& tuple : *predicate.value()) {
+                for (const int element : tuple) {
+                    combine(std::hash<int>{}(element));
+                }
+            }
+        }
+    }
+    return hash;
+}
+
+} // ANONYMOUS NAMESPACE
+
+/**
+ * @brief Computes the quotient of a model by the worlds that some expressions cannot tell apart.
+ *
+ * @param model The base model.
+ * @param expressions The expressions whose constants and predicates tell worlds apart.
+ */
+WorldQuotient::WorldQuotient(const IModel& model, const std::vector<QMLExpression::Expression>& expressions)
+    : m_Base(&model)
+    , m_IndexedBase(dynamic_cast<const IIndexedModel*>(&model))
+{
+    const Signature symbols = signature(expressions);
+    const SymbolTable& table = SymbolTable::global();
+
+    std::vector<WorldView> views;
+    std::unordered_multimap<std::size_t, int> classes_by_hash;
+    for (int world = 0; world < model.worldCardinality(); ++world) {
+        WorldView view;
+        for (const SymbolId constant : symbols.constants) {
+            view.constants.push_back(m_IndexedBase != nullptr ? m_IndexedBase->termInterpretationById(constant, world) : model.termInterpretation(table.name(constant), world));
+        }
+        for (const SymbolId predicate : symbols.predicates) {
+            view.predicates.push_back(m_IndexedBase != nullptr ? m_IndexedBase->predicateInterpretationById(predicate, world) : model.predicateInterpretation(table.name(predicate), world));
+        }
+
+        const std::size_t hash = hashValue(view);
+        const auto [first, last] = classes_by_hash.equal_range(hash);
+        const auto same_class = std::find_if(first, last, [&](const auto& entry) { return views[entry.second] == view; });
+        if (same_class != last) {
+            m_Classes.push_back(same_class->second);
+            ++m_Weights[same_class->second];
+            continue;
+        }
+        const int world_class = static_cast<int>(m_Representatives.size());
+        classes_by_hash.emplace(hash, world_class);
+        views.push_back(std::move(view));
+        m_Classes.push_back(world_class);
+        m_Representatives.push_back(world);
+        m_Weights.push_back(1);
+    }
+}
+
+int WorldQuotient::worldCardinality() const
+{
+    return static_cast<int>(m_Representatives.size());
+}
+
+int WorldQuotient::domainCardinality() const
+{
+    return m_Base->domainCardinality();
+}
+
+/**
+ * @brief The interpretation of a term at the representative of a class. Worlds out of range are passed on to the base model.
+ */
+std::expected<int, std::string> WorldQuotient::termInterpretation(std::string_view term, int world) const
+{
+    return m_Base->termInterpretation(term, world >= 0 && world < worldCardinality() ? m_Representatives[world] : world);
+}
+
+/**
+ * @brief The interpretation of a predicate at the representative of a class. Worlds out of range are passed on to the base model.
+ */
+std::expected<const std::set<std::vector<int>>*, std::string> WorldQuotient::predicateInterpretation(std::string_view predicate, int world) const
+{
+    return m_Base->predicateInterpretation(predicate, world >= 0 && world < worldCardinality() ? m_Representatives[world] : world);
+}
+
+std::expected<int, std::string> WorldQuotient::termInterpretationById(SymbolId term, int world) const
+{
+    if (m_IndexedBase == nullptr) {
+        return termInterpretation(SymbolTable::global().name(term), world);
+    }
+    return m_IndexedBase->termInterpretationById(term, world >= 0 && world < worldCardinality() ? m_Representatives[world] : world);
+}
+
+std::expected<const std::set<std::vector<int>>*, std::string> WorldQuotient::predicateInterpretationById(SymbolId predicate, int world) const
+{
+    if (m_IndexedBase == nullptr) {
+        return predicateInterpretation(SymbolTable::global().name(predicate), world);
+    }
+    return m_IndexedBase->predicateInterpretationById(predicate, world >= 0 && world < worldCardinality() ? m_Representatives[world] : world);
+}
+
+const IModel& WorldQuotient::base() const
+{
+    return *m_Base;
+}
+
+/**
+ * @brief Determines whether some class has more than one world.
+ */
+bool WorldQuotient::mergesWorlds() const
+{
+    return worldCardinality() < m_Base->worldCardinality();
+}
+
+/**
+ * @brief The least world of the base model in a class.
+ */
+int WorldQuotient::representative(int world_class) const
+{
+    return m_Representatives[world_class];
+}
+
+/**
+ * @brief The number of worlds of the base model in a class.
+ */
+int WorldQuotient::weight(int world_class) const
+{
+    return m_Weights[world_class];
+}
+
+/**
+ * @brief The class of a world of the base model.
+ */
+int WorldQuotient::classOf(int world) const
+{
+    return m_Classes[world];
+}
+
+/**
+ * @brief Maps a state of the quotient to the base model, replacing every class by its representative.
+ *
+ * Representatives are ordered as their classes, so the order of the possibilities is kept.
+ */
+InformationState WorldQuotient::lift(const InformationState& state) const
+{
+    InformationState lifted;
+    for (const Possibility& p : state) {
+        Possibility q = p;
+        q.world = p.world >= 0 && p.world < worldCardinality() ? m_Representatives[p.world] : p.world;
+        lifted.insert(lifted.end(), std::move(q));
+    }
+    return lifted;
+}
+
+}
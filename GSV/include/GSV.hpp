@@ -1,8 +1,27 @@
 #pragma once
 
 #include "adapters.hpp"
+#include "columnar_state.hpp"
 #include "core.hpp"
+#include "discourse.hpp"
+#include "distributivity.hpp"
+#include "evaluation_arena.hpp"
+#include "evaluation_cache.hpp"
+#include "evaluation_context.hpp"
 #include "evaluator.hpp"
+#include "extension_index.hpp"
+#include "profiler.hpp"
+#include "program.hpp"
 #include "semantic_relations.hpp"
+#include "sweep.hpp"
+#include "symbolic_evaluator.hpp"
+#include "symmetry_index.hpp"
+#include "thread_pool.hpp"
+#include "trace.hpp"
+#include "world_quotient.hpp"
+#include "world_set_evaluator.hpp"
 
-#include "imodel.hpp"
\ No newline at end of file
+#include "idense_model.hpp"
+#include "iindexed_model.hpp"
+#include "imodel.hpp"
+#include "symbol_id.hpp"
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "iindexed_model.hpp"
+#include "symbol_id.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief The extension of a predicate at every world, as a packed world-major bitset.
+ *
+ * The predicate has a single `arity`, and all its tuples are over the domain
+ * `0, ..., domain - 1`. Bit `world * worldStride + index(tuple)` of `bits` is set iff the
+ * tuple belongs to the extension at the world, where `index` reads the tuple as a number
+ * in base `domain`, most significant element first.
+ *
+ * The bits are owned by the model that hands out the extension.
+ */
+struct DenseExtension {
+    std::size_t arity = 0;
+    int domain = 0;
+    int worlds = 0;
+    std::size_t worldStride = 0;
+    const std::uint64_t* bits = nullptr;
+
+    /**
+     * @brief Checks whether a tuple belongs to the extension at a world, which must be in `[0, worlds)`.
+     */
+    bool contains(int world, std::span<const int> tuple) const
+    {
+        if (tuple.size() != arity) {
+            return false;
+        }
+        std::size_t index = 0;
+        for (const int element : tuple) {
+            if (element < 0 || element >= domain) {
+                return false;
+            }
+            index = index * static_cast<std::size_t>(domain) + static_cast<std::size_t>(element);
+        }
+        const std::size_t bit = static_cast<std::size_t>(world) * worldStride + index;
+        return (bits[bit / 64] >> (bit % 64)) & 1;
+    }
+};
+
+/**
+ * @brief Interface for models that expose their interpretations as flat tables.
+ *
+ * An IDenseModel is an IIndexedModel that also hands out, for a symbol id, the table of
+ * its interpretations at every world. The evaluator fetches these tables once per
+ * instruction and reads them directly for every possibility, without a virtual call.
+ *
+ * Both functions may return nullptr for symbols they have no table for (for instance, a
+ * term that is not interpreted at some world); the evaluator then falls back to the
+ * IIndexedModel lookups, which must agree with the tables wherever both are defined.
+ */
+struct IDenseModel : public IIndexedModel {
+public:
+    /**
+     * @brief The denotations of a term, indexed by world, or nullptr.
+     */
+    virtual const int* termTable(SymbolId term) const = 0;
+
+    /**
+     * @brief The extension of a predicate at every world, or nullptr.
+     */
+    virtual const DenseExtension* denseExtension(SymbolId predicate) const = 0;
+
+    virtual ~IDenseModel() {}
+};
+
+}
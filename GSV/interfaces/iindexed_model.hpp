@@ -0,0 +1,31 @@
+#pragma once
+
+#include <expected>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "imodel.hpp"
+#include "symbol_id.hpp"
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief Interface for models that can be queried by symbol id.
+ *
+ * An IIndexedModel is an IModel that also answers the two interpretation queries for
+ * terms and predicates identified by their id in the global `SymbolTable`, rather than by
+ * name. The evaluator uses these functions whenever the model implements them, which spares
+ * it a lookup by name for every possibility.
+ *
+ * For every id, the id-based functions must return the same results as the name-based
+ * functions for `SymbolTable::global().name(id)`.
+ */
+struct IIndexedModel : public IModel {
+public:
+    virtual std::expected<int, std::string> termInterpretationById(SymbolId term, int world) const = 0;
+    virtual std::expected<const std::set<std::vector<int>>*, std::string> predicateInterpretationById(SymbolId predicate, int world) const = 0;
+    virtual ~IIndexedModel() {}
+};
+
+}
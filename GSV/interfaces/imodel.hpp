@@ -19,6 +19,14 @@ namespace iif_sadaf::talk::GSV {
  * - a function retrieving the cardinality of the domain of individuals
  * - a function that retrieves, for any possible world in the model, the interpretation of a singular term at that world (represented by an `int`), and returns an error message if the term is not interpreted in the model
  * - a function that retrieves, for any possible world in the model, the interpretation of a predicate at that world (represented by a `std::set<std::vector<int>>`), and returns an error message if the predicate is not interpreted in the model
+ *
+ * The evaluator and the semantic relations only ever use a model through const references,
+ * and may query it from several threads at once: from the workers of a `ThreadPool`, and
+ * from every concurrent call that shares the model. Implementations must therefore make
+ * their const member functions safe to call concurrently, and must not change their
+ * interpretations while they are in use. Any lazily computed data must be synchronized,
+ * and the sets returned by `predicateInterpretation()` must stay valid and unchanged for
+ * the lifetime of the model.
  */
 struct IModel {
 public:
@@ -0,0 +1,12 @@
+#pragma once
+
+namespace iif_sadaf::talk::GSV {
+
+/**
+ * @brief Dense integer id of an interned name (variable, constant or predicate).
+ *
+ * Ids are handed out by the global `SymbolTable` of gsv-core.
+ */
+using SymbolId = int;
+
+}